@@ -0,0 +1,147 @@
+# -*- coding: utf-8 -*-
+# -----------------------------------------------------------------------------
+# MIT License
+#
+# Copyright (c) 2020-2024 Ivo Steinbrecher
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+# -----------------------------------------------------------------------------
+
+"""
+Deterministic stand-in for pdflatex and Ghostscript, used by the LaTeX2AI
+benchmarks. The script is embedded in the plugin (see create_headers.py) and
+written to the temporary directory when the benchmarks are run.
+
+Usage:
+    stub_engine.py pdflatex LATENCY_MS [latex options] file.tex
+    stub_engine.py gs LATENCY_MS -sDEVICE=pdfwrite [gs options] -o name_%d.pdf name.pdf [...]
+
+The pdflatex stub creates one page per LaTeX2AI item in the tex file, the gs
+stub writes each page of the input pdf files into a single page pdf file.
+"""
+
+# Import python modules.
+import os
+import re
+import sys
+import time
+
+
+def write_pdf(path, boxes):
+    """Write a valid pdf file with one page for each of the given boxes."""
+
+    n_pages = len(boxes)
+    objects = [
+        b"<< /Type /Catalog /Pages 2 0 R >>",
+        "<< /Type /Pages /Kids [{}] /Count {} >>".format(
+            " ".join("{} 0 R".format(3 + 2 * i) for i in range(n_pages)), n_pages
+        ).encode(),
+    ]
+    for i, (width, height) in enumerate(boxes):
+        content = "0 0 0 rg 1 1 {} {} re f".format(width - 2, height - 2).encode()
+        objects.append(
+            "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 {} {}] /Contents {} 0 R >>".format(
+                width, height, 4 + 2 * i
+            ).encode()
+        )
+        objects.append(
+            b"<< /Length "
+            + str(len(content)).encode()
+            + b" >>\nstream\n"
+            + content
+            + b"\nendstream"
+        )
+
+    data = bytearray(b"%PDF-1.5\n")
+    offsets = []
+    for i, obj in enumerate(objects):
+        offsets.append(len(data))
+        data += "{} 0 obj\n".format(i + 1).encode() + obj + b"\nendobj\n"
+    xref_offset = len(data)
+    data += "xref\n0 {}\n0000000000 65535 f \n".format(len(objects) + 1).encode()
+    for offset in offsets:
+        data += "{:010d} 00000 n \n".format(offset).encode()
+    data += "trailer\n<< /Size {} /Root 1 0 R >>\nstartxref\n{}\n%%EOF\n".format(
+        len(objects) + 1, xref_offset
+    ).encode()
+
+    with open(path, "wb") as pdf_file:
+        pdf_file.write(data)
+
+
+def item_box(index):
+    """Return a deterministic page size for the item with the given index."""
+    return (20 + (7 * index) % 50, 10 + (3 * index) % 20)
+
+
+def stub_pdflatex(args):
+    """Create a pdf with one page per \\LaTeXtoAI item in the tex file."""
+
+    if "-version" in args:
+        print("pdfTeX 3.141592653 (LaTeX2AI benchmark stub)")
+        return 0
+
+    tex_path = args[-1]
+    with open(tex_path, encoding="utf-8") as tex_file:
+        tex_code = tex_file.read()
+    n_items = len(re.findall(r"^\\LaTeXtoAI(base)?\{", tex_code, re.MULTILINE))
+
+    base_path = os.path.splitext(tex_path)[0]
+    with open(base_path + ".log", "w") as log_file:
+        log_file.write("LaTeX2AI benchmark stub: {} pages\n".format(n_items))
+    if n_items > 0:
+        write_pdf(base_path + ".pdf", [item_box(i) for i in range(n_items)])
+    return 0
+
+
+def stub_gs(args):
+    """Write the pages of the pdf files into one file per page."""
+
+    if "-v" in args:
+        print("GPL Ghostscript 10.00.0 (LaTeX2AI benchmark stub)")
+        return 0
+
+    output_index = args.index("-o") + 1
+    output_pattern = args[output_index]
+    boxes = []
+    for input_path in args[output_index + 1 :]:
+        with open(input_path, "rb") as pdf_file:
+            pdf_data = pdf_file.read().decode("latin-1")
+        boxes.extend(
+            re.findall(r"/Type /Page /Parent .*?/MediaBox \[0 0 (\d+) (\d+)\]", pdf_data)
+        )
+    for i, (width, height) in enumerate(boxes):
+        write_pdf(output_pattern.replace("%d", str(i + 1)), [(int(width), int(height))])
+    return 0
+
+
+if __name__ == "__main__":
+    """Execution part of script"""
+
+    if len(sys.argv) < 3:
+        raise ValueError("Wrong number of system arguments.")
+
+    engine = sys.argv[1]
+    time.sleep(float(sys.argv[2]) / 1000.0)
+    if engine == "pdflatex":
+        sys.exit(stub_pdflatex(sys.argv[3:]))
+    elif engine == "gs":
+        sys.exit(stub_gs(sys.argv[3:]))
+    else:
+        raise ValueError("Unknown engine {}".format(engine))
@@ -103,6 +103,32 @@ def create_cpp_tex_headers(dir_path, license_c):
         tex_header.write(license_c + "\n".join(tex_lines))
 
 
+def create_cpp_benchmark_headers(dir_path, license_c):
+    """
+    Create the header containing the stub engines for the benchmarks.
+    """
+
+    stub_path = os.path.join("benchmark", "stub_engine.py")
+    with open(stub_path) as stub_file:
+        stub_code = stub_file.read().strip().replace("\\", "\\\\").replace('"', '\\"')
+
+    benchmark_lines = [
+        "\n",
+        "// Automatic generated header with the benchmark stub engines.",
+        "#ifndef BENCHMARK_H_",
+        "#define BENCHMARK_H_",
+        "",
+        "#define L2A_BENCHMARK_STUB_ENGINE_ \\",
+        '  "' + '\\n"\\\n  "'.join(stub_code.split("\n")) + '"',
+        "#endif",
+        "",
+    ]
+
+    # The script is called form the base repository directory.
+    with open(os.path.join(dir_path, "benchmark.h"), "w") as benchmark_header:
+        benchmark_header.write(license_c + "\n".join(benchmark_lines))
+
+
 def create_cpp_headers():
     """
     Create the C++ headers.
@@ -120,6 +146,7 @@ def create_cpp_headers():
 
     create_cpp_version_headers(dir_path, license_c)
     create_cpp_tex_headers(dir_path, license_c)
+    create_cpp_benchmark_headers(dir_path, license_c)
 
 
 def create_js_headers():
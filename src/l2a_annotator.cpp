@@ -32,8 +32,10 @@
 #include "l2a_annotator.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_constants.h"
 #include "l2a_error.h"
 #include "l2a_item.h"
+#include "l2a_trace.h"
 
 
 /**
@@ -57,44 +59,61 @@ L2A::Annotator::Annotator(SPInterfaceMessage* message) : cursor_item_(nullptr)
  */
 void L2A::Annotator::ArtSelectionChanged()
 {
-    // Reset the item vector.
-    item_vector_.clear();
+    l2a_trace_scope("Annotator::ArtSelectionChanged");
 
     // Only do something if the annotator is active.
     if (!IsActive())
+    {
+        item_map_.clear();
+        item_index_.Clear();
         return;
-    else
+    }
+
+    // Get all l2a items in the document.
+    std::vector<AIArtHandle> all_items;
+    L2A::AI::GetDocumentItems(all_items, L2A::AI::SelectionState::all);
+
+    // Region that contains the old and new bounds of all changed items.
+    AIRealRect dirty_bounds = {0, 0, 0, 0};
+    bool is_dirty = false;
+    const auto add_dirty_bounds = [&](const AIRealRect& bounds)
+    {
+        if (is_dirty)
+            L2A::UTIL::RectUnion(dirty_bounds, bounds);
+        else
+            dirty_bounds = bounds;
+        is_dirty = true;
+    };
+
+    // Reuse the cached items that did not change.
+    std::map<AIArtHandle, AnnotatorItem> new_item_map;
+    for (const auto& item : all_items)
+    {
+        auto cached_item = item_map_.find(item);
+        if (cached_item != item_map_.end() && cached_item->second.state_ == GetItemState(item))
+            new_item_map.emplace(item, std::move(cached_item->second));
+        else
+        {
+            if (cached_item != item_map_.end()) add_dirty_bounds(cached_item->second.state_.bounds_);
+            AnnotatorItem new_item = CreateAnnotatorItem(item);
+            add_dirty_bounds(new_item.state_.bounds_);
+            item_index_.Insert(item, new_item.state_.bounds_);
+            new_item_map.emplace(item, std::move(new_item));
+        }
+    }
+
+    // Drop the items that are no longer in the document.
+    for (const auto& [placed_item, old_item] : item_map_)
     {
-        // Get all l2a items in the document.
-        std::vector<AIArtHandle> all_items;
-        L2A::AI::GetDocumentItems(all_items, L2A::AI::SelectionState::all);
-        for (auto& item : all_items)
+        if (new_item_map.find(placed_item) == new_item_map.end())
         {
-            // Create item object.
-            L2A::Item new_item(item);
-
-            // Get all coordinates of the item.
-            std::vector<PlaceAlignment> placements;
-            placements.push_back(PlaceAlignment::kTopLeft);
-            placements.push_back(PlaceAlignment::kTopMid);
-            placements.push_back(PlaceAlignment::kTopRight);
-            placements.push_back(PlaceAlignment::kMidLeft);
-            placements.push_back(PlaceAlignment::kMidMid);
-            placements.push_back(PlaceAlignment::kMidRight);
-            placements.push_back(PlaceAlignment::kBotLeft);
-            placements.push_back(PlaceAlignment::kBotMid);
-            placements.push_back(PlaceAlignment::kBotRight);
-            std::vector<AIRealPoint> item_points = new_item.GetPosition(placements);
-
-            // Fill up the map.
-            std::map<PlaceAlignment, AIRealPoint> item_boundaries;
-            for (unsigned int i_placement = 0; i_placement < placements.size(); i_placement++)
-                item_boundaries[placements[i_placement]] = item_points[i_placement];
-
-            // Add to the item vetor.
-            item_vector_.push_back(std::make_pair(new_item, item_boundaries));
+            add_dirty_bounds(old_item.state_.bounds_);
+            item_index_.Remove(placed_item);
         }
     }
+    item_map_.swap(new_item_map);
+
+    if (is_dirty) InvalAnnotation(dirty_bounds);
 }
 
 /**
@@ -183,8 +202,17 @@ void L2A::Annotator::Draw(AIAnnotatorMessage* message) const
     // This can only be called when the annotator is active.
     if (!IsActive()) l2a_error("The annotator has to be active.");
 
-    // Loop over items and draw boundary.
-    for (const auto& item : item_vector_) std::get<0>(item).Draw(message, std::get<1>(item));
+    // Get the bounds of the current document view.
+    AIRealRect view_bounds = {0, 0, 0, 0};
+    AIErr result = sAIDocumentView->GetDocumentViewBounds(message->view, &view_bounds);
+    l2a_check_ai_error(result);
+
+    // Loop over the visible items and draw boundary.
+    for (const auto& placed_item : item_index_.Query(view_bounds))
+    {
+        const auto& item = item_map_.at(placed_item);
+        item.item_.Draw(message, item.boundaries_);
+    }
 }
 
 /**
@@ -192,8 +220,14 @@ void L2A::Annotator::Draw(AIAnnotatorMessage* message) const
  */
 void L2A::Annotator::InvalAnnotation(const AIRealRect& artwork_bounds) const
 {
-    // Get the rectangle to invalidate.
+    // Get the rectangle to invalidate. It is extended by the line width and the radius of the placement point, since
+    // they are drawn in view coordinates.
     AIRect inval_rect = L2A::AI::ArtworkBoundsToViewBounds(artwork_bounds);
+    const int margin = L2A::CONSTANTS::radius_ + L2A::CONSTANTS::line_width_;
+    inval_rect.left -= margin;
+    inval_rect.top -= margin;
+    inval_rect.right += margin;
+    inval_rect.bottom += margin;
 
     // Invalidate the rect bounds so it is redrawn.
     AIErr result = sAIAnnotator->InvalAnnotationRect(nullptr, &inval_rect);
@@ -213,3 +247,53 @@ void L2A::Annotator::InvalAnnotation() const
     // Invalidate the rect bounds so it is redrawn.
     InvalAnnotation(view_bounds);
 }
+
+/**
+ *
+ */
+L2A::AnnotatorItemState L2A::Annotator::GetItemState(const AIArtHandle& placed_item)
+{
+    AnnotatorItemState state;
+    state.matrix_ = L2A::AI::GetPlacedMatrix(placed_item);
+    state.bounds_ = L2A::AI::GetArtBounds(placed_item);
+    state.alignment_ = std::get<1>(L2A::AI::GetPlacement(placed_item));
+    state.pdf_path_ = L2A::AI::GetPlacedItemPath(placed_item).GetFullPath();
+    L2A::AI::GetIsHiddenLocked(placed_item, state.is_hidden_, state.is_locked_);
+    return state;
+}
+
+/**
+ *
+ */
+L2A::AnnotatorItem L2A::Annotator::CreateAnnotatorItem(const AIArtHandle& placed_item)
+{
+    // Create item object. This can change the placement of the placed item, therefore the state is evaluated after
+    // this.
+    L2A::Item new_item(placed_item);
+
+    // Get all coordinates of the item.
+    const std::vector<PlaceAlignment> placements = {PlaceAlignment::kTopLeft, PlaceAlignment::kTopMid,
+        PlaceAlignment::kTopRight, PlaceAlignment::kMidLeft, PlaceAlignment::kMidMid, PlaceAlignment::kMidRight,
+        PlaceAlignment::kBotLeft, PlaceAlignment::kBotMid, PlaceAlignment::kBotRight};
+    std::vector<AIRealPoint> item_points = new_item.GetPosition(placements);
+
+    // Fill up the map.
+    std::map<PlaceAlignment, AIRealPoint> item_boundaries;
+    for (unsigned int i_placement = 0; i_placement < placements.size(); i_placement++)
+        item_boundaries[placements[i_placement]] = item_points[i_placement];
+
+    return {std::move(new_item), std::move(item_boundaries), GetItemState(placed_item)};
+}
+
+/**
+ *
+ */
+bool L2A::AnnotatorItemState::operator==(const AnnotatorItemState& other) const
+{
+    return matrix_.a == other.matrix_.a && matrix_.b == other.matrix_.b && matrix_.c == other.matrix_.c &&
+           matrix_.d == other.matrix_.d && matrix_.tx == other.matrix_.tx && matrix_.ty == other.matrix_.ty &&
+           bounds_.left == other.bounds_.left && bounds_.top == other.bounds_.top &&
+           bounds_.right == other.bounds_.right && bounds_.bottom == other.bounds_.bottom &&
+           alignment_ == other.alignment_ && pdf_path_ == other.pdf_path_ && is_hidden_ == other.is_hidden_ &&
+           is_locked_ == other.is_locked_;
+}
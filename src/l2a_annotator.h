@@ -31,19 +31,58 @@
 #define L2A_ANNOTATOR_H_
 
 
+#include "l2a_item.h"
+#include "l2a_spatial_index.h"
 #include "l2a_suites.h"
 
 #include <map>
 
-// Forward declaration.
 namespace L2A
 {
-    class Item;
-}
+    /**
+     * \brief State of a placed item in Illustrator that determines the annotator boundary of the item.
+     */
+    struct AnnotatorItemState
+    {
+        //! Placement matrix of the placed item.
+        AIRealMatrix matrix_;
 
+        //! Bounds of the placed item.
+        AIRealRect bounds_;
+
+        //! Placement alignment of the placed item.
+        PlaceAlignment alignment_;
+
+        //! Path of the linked pdf file, this changes if the LaTeX code of the item changes.
+        ai::UnicodeString pdf_path_;
+
+        //! Flag if the item or one of its parents is hidden, hidden items are not drawn.
+        bool is_hidden_;
+
+        //! Flag if the item or one of its parents is locked, locked items are drawn dimmed.
+        bool is_locked_;
+
+        /**
+         * \brief Check if two states are equal.
+         */
+        bool operator==(const AnnotatorItemState& other) const;
+    };
+
+    /**
+     * \brief Cached data of a single item drawn by the annotator.
+     */
+    struct AnnotatorItem
+    {
+        //! Item object.
+        L2A::Item item_;
+
+        //! All positions of the bounding box of the item.
+        std::map<PlaceAlignment, AIRealPoint> boundaries_;
+
+        //! State of the placed item the boundaries were calculated for.
+        AnnotatorItemState state_;
+    };
 
-namespace L2A
-{
     class Annotator
     {
        public:
@@ -57,7 +96,8 @@ namespace L2A
 
         /**
          * \brief This method is called when the art selection changed. If the annotator is active, the items are
-         * reloaded.
+         * reloaded. Only items that changed since the last call are recalculated and only the region of the changed
+         * items is invalidated.
          */
         void ArtSelectionChanged();
 
@@ -97,7 +137,7 @@ namespace L2A
         AIArtHandle GetArtHit() const { return cursor_item_; }
 
         /**
-         * \brief Draw the boundaries of the items.
+         * \brief Draw the boundaries of the items that are in the document view.
          */
         void Draw(AIAnnotatorMessage* message) const;
 
@@ -117,6 +157,16 @@ namespace L2A
          */
         void SetAnnotator(bool active);
 
+        /**
+         * \brief Get the current state of a placed item.
+         */
+        static AnnotatorItemState GetItemState(const AIArtHandle& placed_item);
+
+        /**
+         * \brief Create the cached annotator data for a placed item.
+         */
+        static AnnotatorItem CreateAnnotatorItem(const AIArtHandle& placed_item);
+
        private:
         //! Handle for the annotator added by this plug-in.
         AIAnnotatorHandle annotator_handle_;
@@ -124,9 +174,12 @@ namespace L2A
         //! Item the cursor is over.
         AIArtHandle cursor_item_;
 
-        //! Vector of items. The items are stored in pairs, where the second pair entry are all positions of the
-        //! bounding box.
-        std::vector<std::pair<L2A::Item, std::map<PlaceAlignment, AIRealPoint>>> item_vector_;
+        //! Registry of all items in the document. The entries are kept between selection changes and only updated if
+        //! the state of the placed item changed.
+        std::map<AIArtHandle, AnnotatorItem> item_map_;
+
+        //! Spatial index with the bounds of all items in item_map_.
+        L2A::UTIL::SpatialIndex<AIArtHandle> item_index_;
     };
 }  // namespace L2A
 
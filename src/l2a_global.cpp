@@ -37,9 +37,11 @@
 #include "l2a_execute.h"
 #include "l2a_file_system.h"
 #include "l2a_latex.h"
+#include "l2a_names.h"
 #include "l2a_parameter_list.h"
 #include "l2a_plugin.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 #include "l2a_version.h"
 
 /**
@@ -75,6 +77,10 @@ L2A::GLOBAL::Global::Global() : is_testing_(false)
         l2a_item_last_input_ = application_data_directory;
         l2a_item_last_input_.AddComponent(ai::UnicodeString("LaTeX2AI_last_input.xml"));
 
+        //! Directory of the compile cache.
+        compile_cache_directory_ = application_data_directory;
+        compile_cache_directory_.AddComponent(ai::UnicodeString(L2A::NAMES::compile_cache_directory_));
+
         if (L2A::UTIL::IsFile(application_data_path_))
         {
             // Try to load the data from the xml file.
@@ -145,6 +151,9 @@ void L2A::GLOBAL::Global::ToParameterList(std::shared_ptr<L2A::UTIL::ParameterLi
     parameter_list->SetOption(ai::UnicodeString("item_ui_finish_on_enter"), item_ui_finish_on_enter_);
     parameter_list->SetOption(ai::UnicodeString("warning_boundary_boxes"), warning_boundary_boxes_);
     parameter_list->SetOption(ai::UnicodeString("warning_ai_not_saved"), warning_ai_not_saved_);
+    parameter_list->SetOption(ai::UnicodeString("trace_enabled"), trace_enabled_);
+    parameter_list->SetOption(ai::UnicodeString("compile_cache_size_mb"), compile_cache_size_mb_);
+    parameter_list->SetOption(ai::UnicodeString("optimize_pdf_files"), optimize_pdf_files_);
 }
 
 /**
@@ -160,6 +169,9 @@ void L2A::GLOBAL::Global::GetDefaultParameterList(std::shared_ptr<L2A::UTIL::Par
     parameter_list->SetOption(ai::UnicodeString("item_ui_finish_on_enter"), false);
     parameter_list->SetOption(ai::UnicodeString("warning_boundary_boxes"), true);
     parameter_list->SetOption(ai::UnicodeString("warning_ai_not_saved"), true);
+    parameter_list->SetOption(ai::UnicodeString("trace_enabled"), false);
+    parameter_list->SetOption(ai::UnicodeString("compile_cache_size_mb"), 256);
+    parameter_list->SetOption(ai::UnicodeString("optimize_pdf_files"), false);
 }
 
 /**
@@ -185,6 +197,10 @@ bool L2A::GLOBAL::Global::SetFromParameterList(const L2A::UTIL::ParameterList& p
     auto conversion_bool = [](const L2A::UTIL::ParameterList& parameter_list, const ai::UnicodeString& key)
     { return bool(parameter_list.GetIntOption(key)); };
 
+    // Function to convert the key from the parameter list to an int
+    auto conversion_int = [](const L2A::UTIL::ParameterList& parameter_list, const ai::UnicodeString& key)
+    { return parameter_list.GetIntOption(key); };
+
     // Function to set the variable from one of the possibly multiple given keys. If the key is in the parameter list
     // multiple times, an error will be thrown.
     auto set_variable_from_keys =
@@ -227,6 +243,14 @@ bool L2A::GLOBAL::Global::SetFromParameterList(const L2A::UTIL::ParameterList& p
         warning_boundary_boxes_, {ai::UnicodeString("warning_boundary_boxes")}, set_all, conversion_bool);
     set_all = set_variable_from_keys(
         warning_ai_not_saved_, {ai::UnicodeString("warning_ai_not_saved")}, set_all, conversion_bool);
+    set_all = set_variable_from_keys(trace_enabled_, {ai::UnicodeString("trace_enabled")}, set_all, conversion_bool);
+    set_all = set_variable_from_keys(
+        compile_cache_size_mb_, {ai::UnicodeString("compile_cache_size_mb")}, set_all, conversion_int);
+    set_all = set_variable_from_keys(
+        optimize_pdf_files_, {ai::UnicodeString("optimize_pdf_files")}, set_all, conversion_bool);
+
+    // The trace module keeps its own flag, so the disabled check does not have to access the global object.
+    L2A::UTIL::TRACE::SetTraceEnabled(trace_enabled_);
 
     return set_all;
 }
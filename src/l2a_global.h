@@ -95,6 +95,9 @@ namespace L2A
             //! File that stores last item input.
             ai::FilePath l2a_item_last_input_;
 
+            //! Directory of the compile cache, which is shared between all documents.
+            ai::FilePath compile_cache_directory_;
+
             //! Flag if testing is currently active.
             bool is_testing_;
 
@@ -121,6 +124,15 @@ namespace L2A
 
             //! Flag for warning if boundary boxes are not OK.
             bool warning_boundary_boxes_;
+
+            //! Flag if performance trace spans are recorded and written to the application data directory.
+            bool trace_enabled_;
+
+            //! Maximum size of the compile cache in MB, 0 deactivates the cache.
+            int compile_cache_size_mb_;
+
+            //! Flag if the pdf files of the items are optimized with Ghostscript after they are created.
+            bool optimize_pdf_files_;
         };
 
         /**
@@ -37,12 +37,14 @@
 #include "l2a_file_system.h"
 #include "l2a_global.h"
 #include "l2a_latex.h"
+#include "l2a_links.h"
 #include "l2a_math.h"
 #include "l2a_names.h"
 #include "l2a_parameter_list.h"
 #include "l2a_plugin.h"
 #include "l2a_string_functions.h"
 #include "l2a_suites.h"
+#include "l2a_trace.h"
 #include "l2a_ui_manager.h"
 #include "l2a_utils.h"
 
@@ -150,7 +152,6 @@ L2A::ItemChangeResult L2A::Item::Change(const ai::UnicodeString& form_return_val
         // We have to set the property here since the redo latex button will redo the existing item, not the text that
         // might be changed in the UI. We raise a warning for that case in the UI.
         // TODO: maybe return the correct data directly?
-        // TODO: copy here without copying the pdf contents
         new_property = GetProperty();
     }
     else
@@ -163,8 +164,8 @@ L2A::ItemChangeResult L2A::Item::Change(const ai::UnicodeString& form_return_val
         auto [latex_creation_result, pdf_file] = L2A::LATEX::CreateLatexItem(new_property);
         if (latex_creation_result.result_ == L2A::LATEX::LatexCreationResult::Result::ok)
         {
-            // TODO: this works, but it is very strange what we copy around here, this should be improved
-            // PDF could be created, now store the pdf file in the placed item
+            // PDF could be created, now store the pdf file in the placed item. The pdf contents are shared between
+            // the copies of the property, so this does not copy them.
             new_property.SetPDFFile(pdf_file);
             GetPropertyMutable() = new_property;
             pdf_file = GetPDFPath();
@@ -192,7 +193,7 @@ L2A::ItemChangeResult L2A::Item::Change(const ai::UnicodeString& form_return_val
     // If something changed add the information to the placed item note
     if (diff.Changed())
     {
-        GetPropertyMutable() = new_property;
+        GetPropertyMutable() = std::move(new_property);
         SetNoteAndName();
 
         if (diff.changed_align)
@@ -257,11 +258,12 @@ void L2A::Item::SetNoteAndName() const
  */
 ai::FilePath L2A::Item::GetPDFPath() const
 {
-    ai::UnicodeString pdf_file_hash = property_.GetPDFFileHash();
+    // The pdf files are content addressed, items with the same pdf file share one file in the links directory, also
+    // across the documents in the folder.
+    const std::string& pdf_file_hash = property_.GetPDFFileHash();
     if (pdf_file_hash.empty()) l2a_error("File hash should not be empty.");
     ai::FilePath pdf_path = L2A::UTIL::GetPdfFileDirectory();
-    ai::UnicodeString document_name = L2A::UTIL::GetDocumentName();
-    pdf_path.AddComponent(document_name + L2A::NAMES::pdf_item_post_fix_ + pdf_file_hash + ".pdf");
+    pdf_path.AddComponent(L2A::NAMES::GetPdfLinkName(pdf_file_hash));
     return pdf_path;
 }
 
@@ -270,14 +272,33 @@ ai::FilePath L2A::Item::GetPDFPath() const
  */
 void L2A::Item::SaveEncodedPDFFile(const ai::FilePath& pdf_path) const
 {
+    l2a_trace_scope("Item::SaveEncodedPDFFile");
+
     // Make sure the directory exists.
     if (!L2A::UTIL::IsDirectory(pdf_path.GetParent())) L2A::UTIL::CreateDirectoryL2A(pdf_path.GetParent());
 
-    const ai::UnicodeString& pdf_contents = property_.GetPDFFileContents();
-    if (!pdf_contents.empty())
-        L2A::UTIL::decode_file_base64(pdf_path, pdf_contents);
-    else
-        l2a_error("Could not save the encoded pdf file, got empty encoded data.");
+    // The file can already be used by other items, it is only written if it does not have the expected contents. The
+    // reference of this document to the file is stored right away, so the file is kept if another document in the
+    // folder is saved before this one.
+    L2A::UTIL::LinksLock links_lock(pdf_path.GetParent());
+    L2A::UTIL::LinksManifest manifest = L2A::UTIL::ReadLinksManifest(pdf_path.GetParent());
+    if (!L2A::UTIL::IsLinkFileValid(pdf_path, property_.GetPDFFileHash(), manifest))
+    {
+        L2A::UTIL::decode_files({GetEncodedPDFFile(pdf_path)});
+        L2A::UTIL::SetLinkFileState(pdf_path, property_.GetPDFFileHash(), manifest);
+    }
+    L2A::UTIL::AddLinkReferences(L2A::UTIL::GetDocumentPath(), {pdf_path}, manifest);
+    if (manifest.modified_) L2A::UTIL::WriteLinksManifest(pdf_path.GetParent(), manifest);
+}
+
+/**
+ *
+ */
+L2A::UTIL::EncodedFile L2A::Item::GetEncodedPDFFile(const ai::FilePath& pdf_path) const
+{
+    const L2A::UTIL::SharedString& pdf_contents = property_.GetPDFFileContents();
+    if (pdf_contents.empty()) l2a_error("Could not save the encoded pdf file, got empty encoded data.");
+    return {L2A::UTIL::FilePathAiToStd(pdf_path), pdf_contents, property_.GetPDFFileEncoding()};
 }
 
 /**
@@ -541,6 +562,8 @@ bool L2A::Item::IsStretched() const
  */
 void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption& redo_option)
 {
+    l2a_trace_scope("RedoItems");
+
     L2A::AI::SetUndoText(ai::UnicodeString("Undo Redo LaTeX2AI Items"), ai::UnicodeString("Redo LaTeX2AI Items"));
 
     // Check if something needs to be done
@@ -549,6 +572,7 @@ void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption&
     // Create an Item for all placed items that need to be redone
     unsigned int locked_counter = 0;
     std::vector<L2A::Item> l2a_items;
+    l2a_items.reserve(redo_items.size());
     for (const auto& placed_item : redo_items)
     {
         bool is_hidden;
@@ -557,7 +581,7 @@ void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption&
         if (is_hidden || is_locked)
             locked_counter++;
         else
-            l2a_items.push_back(L2A::Item(placed_item));
+            l2a_items.emplace_back(placed_item);
     }
 
     // Aller the user that locked and or hidden items were selected.
@@ -571,7 +595,7 @@ void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption&
 
     if (redo_option == RedoItemsOption::latex)
     {
-        if (!RedoLaTeXItems(l2a_items)) return;
+        if (!RedoLaTeXItems(l2a_items, false)) return;
     }
 
     // Redo the boundaries of all items (this has to be done for both cases of redo_option
@@ -581,18 +605,15 @@ void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption&
 /**
  *
  */
-bool L2A::RedoLaTeXItems(std::vector<L2A::Item>& l2a_items)
+bool L2A::RedoLaTeXItems(std::vector<L2A::Item>& l2a_items, const bool lookup_compile_cache)
 {
-    // Loop over every element and get the property
+    // Loop over every element and get the property. The pdf contents are shared with the properties of the items.
     std::vector<L2A::Property> properties;
-    for (const auto& item : l2a_items)
-    {
-        // TODO: dont copy the pdf contents here
-        properties.push_back(item.GetProperty());
-    }
+    properties.reserve(l2a_items.size());
+    for (const auto& item : l2a_items) properties.push_back(item.GetProperty());
 
     // Create the pdf file for each item
-    auto [latex_creation_result, pdf_files] = L2A::LATEX::CreateLatexItems(properties);
+    auto [latex_creation_result, pdf_files] = L2A::LATEX::CreateLatexItems(properties, lookup_compile_cache);
     if (latex_creation_result.result_ != L2A::LATEX::LatexCreationResult::Result::ok)
     {
         L2A::GlobalPluginMutable().GetUiManager().GetDebugForm().OpenDebugForm(
@@ -602,16 +623,48 @@ bool L2A::RedoLaTeXItems(std::vector<L2A::Item>& l2a_items)
 
     // Create the PDFs for the items and store them in the placed items. We dont reset the boundary box here. This is
     // done in the redo function, we leave it out here, since one might want to use this function without resetting the
-    // bounding box.
+    // bounding box. Items with the same pdf file share one file, which is only written if it does not already exist.
+    std::vector<ai::FilePath> new_paths;
+    std::vector<L2A::UTIL::EncodedFile> encoded_files;
+    std::set<std::string> written_files;
+    std::vector<unsigned int> written_items;
+    const ai::FilePath pdf_file_directory = L2A::UTIL::GetPdfFileDirectory();
+    if (l2a_items.size() > 0 && !L2A::UTIL::IsDirectory(pdf_file_directory))
+        L2A::UTIL::CreateDirectoryL2A(pdf_file_directory);
+    L2A::UTIL::LinksLock links_lock(pdf_file_directory);
+    L2A::UTIL::LinksManifest manifest = L2A::UTIL::ReadLinksManifest(pdf_file_directory);
     for (unsigned int i = 0; i < l2a_items.size(); i++)
     {
         // Get the PDF path.
         auto& l2a_item = l2a_items[i];
         l2a_item.GetPropertyMutable().SetPDFFile(pdf_files[i]);
-        ai::FilePath new_path = l2a_item.GetPDFPath();
-        l2a_item.SaveEncodedPDFFile(new_path);
-        L2A::AI::RelinkPlacedItem(l2a_item.GetPlacedItemMutable(), new_path);
-        l2a_item.SetNoteAndName();
+        new_paths.push_back(l2a_item.GetPDFPath());
+        const std::string pdf_path_std = L2A::UTIL::FilePathAiToStd(new_paths.back());
+        if (written_files.find(pdf_path_std) == written_files.end() &&
+            !L2A::UTIL::IsLinkFileValid(new_paths.back(), l2a_item.GetProperty().GetPDFFileHash(), manifest))
+        {
+            written_files.insert(pdf_path_std);
+            written_items.push_back(i);
+            encoded_files.push_back(l2a_item.GetEncodedPDFFile(new_paths.back()));
+        }
+    }
+
+    // The files are written in parallel, relinking has to be done on the plugin thread afterwards.
+    L2A::UTIL::decode_files(encoded_files);
+    for (unsigned int i = 0; i < l2a_items.size(); i++)
+    {
+        L2A::AI::RelinkPlacedItem(l2a_items[i].GetPlacedItemMutable(), new_paths[i]);
+        l2a_items[i].SetNoteAndName();
+    }
+
+    // Store the states of the written files and the references of this document, so the files are kept if another
+    // document in the folder is saved before this one.
+    for (const auto i : written_items)
+        L2A::UTIL::SetLinkFileState(new_paths[i], l2a_items[i].GetProperty().GetPDFFileHash(), manifest);
+    if (l2a_items.size() > 0)
+    {
+        L2A::UTIL::AddLinkReferences(L2A::UTIL::GetDocumentPath(), new_paths, manifest);
+        if (manifest.modified_) L2A::UTIL::WriteLinksManifest(pdf_file_directory, manifest);
     }
 
     return true;
@@ -620,10 +673,12 @@ bool L2A::RedoLaTeXItems(std::vector<L2A::Item>& l2a_items)
 /**
  *
  */
-void L2A::CheckItemDataStructure()
+std::vector<L2A::Item> L2A::CheckItemDataStructure()
 {
+    l2a_trace_scope("CheckItemDataStructure");
+
     // We need a valid document path for this function to work.
-    if (!L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false))) return;
+    if (!L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false))) return {};
 
     // Get all LaTeX2AI placed items in this document.
     std::vector<AIArtHandle> items_all;
@@ -639,19 +694,19 @@ void L2A::CheckItemDataStructure()
         L2A::Item l2a_item(item);
         if (!l2a_item.GetProperty().GetPDFFileHash().empty())
         {
-            working_items.push_back(l2a_item);
+            working_items.push_back(std::move(l2a_item));
         }
         else if (L2A::UTIL::IsFile(old_path))
         {
             // No pdf data is stored in the item and the pdf file exists -> Save the data to the item.
             l2a_item.GetPropertyMutable().SetPDFFile(old_path);
             l2a_item.SetNoteAndName();
-            working_items.push_back(l2a_item);
+            working_items.push_back(std::move(l2a_item));
         }
         else
         {
             // The LaTeX label has to be redone.
-            redo_items.push_back(l2a_item);
+            redo_items.push_back(std::move(l2a_item));
         }
     }
 
@@ -667,7 +722,7 @@ void L2A::CheckItemDataStructure()
             RedoLaTeXItems(redo_items);
 
             // Add the items to the working_items vector.
-            for (auto& item : redo_items) working_items.push_back(item);
+            for (auto& item : redo_items) working_items.push_back(std::move(item));
         }
     }
 
@@ -675,58 +730,43 @@ void L2A::CheckItemDataStructure()
     const ai::FilePath pdf_file_directory = L2A::UTIL::GetPdfFileDirectory();
     if (working_items.size() > 0) L2A::UTIL::CreateDirectoryL2A(pdf_file_directory);
 
-    // Loop over each LaTeX2AI item and check if it is stored correctly.
+    // Loop over each LaTeX2AI item and check if it is stored correctly. The pdf file is only written if it is missing
+    // or its contents do not match the hash stored in the item. The lock is held until the cleanup is finished.
+    L2A::UTIL::LinksLock links_lock(pdf_file_directory);
+    L2A::UTIL::LinksManifest manifest = L2A::UTIL::ReadLinksManifest(pdf_file_directory);
+    // Items with the same pdf file share one file, it is only written once.
     std::vector<ai::FilePath> used_pdf_files;
-    for (auto& item : working_items)
+    std::vector<char> write_pdf(working_items.size(), 0);
+    std::vector<L2A::UTIL::EncodedFile> encoded_files;
+    std::set<std::string> written_files;
+    for (unsigned int i = 0; i < working_items.size(); i++)
     {
-        const ai::FilePath new_pdf_path = item.GetPDFPath();
-        const ai::FilePath old_pdf_path = L2A::AI::GetPlacedItemPath(item.GetPlacedItem());
-        if (!(L2A::UTIL::IsEqualFile(new_pdf_path, old_pdf_path) && L2A::UTIL::IsFile(new_pdf_path)))
+        used_pdf_files.push_back(working_items[i].GetPDFPath());
+        const std::string& pdf_file_hash = working_items[i].GetProperty().GetPDFFileHash();
+        if (!L2A::UTIL::IsLinkFileValid(used_pdf_files[i], pdf_file_hash, manifest))
         {
-            // Store the pdf in the correct path and relink it.
-            item.SaveEncodedPDFFile(new_pdf_path);
-            L2A::AI::SetPlacedItemPath(item.GetPlacedItemMutable(), new_pdf_path);
+            write_pdf[i] = 1;
+            if (written_files.insert(L2A::UTIL::FilePathAiToStd(used_pdf_files[i])).second)
+                encoded_files.push_back(working_items[i].GetEncodedPDFFile(used_pdf_files[i]));
         }
-        used_pdf_files.push_back(new_pdf_path);
     }
 
-    // Cleanup pdf links directory.
+    // The files are written in parallel, relinking has to be done on the plugin thread afterwards. Items are relinked
+    // if the file was written or the item points to a different file.
+    L2A::UTIL::decode_files(encoded_files);
+    for (unsigned int i = 0; i < working_items.size(); i++)
     {
-        // Get all pdf items.
-        ai::UnicodeString pattern = ai::UnicodeString(".*") + L2A::NAMES::pdf_item_post_fix_ + ".*\\.pdf$";
-        std::vector<ai::FilePath> pdf_item_files = L2A::UTIL::FindFilesInFolder(pdf_file_directory, pattern);
-
-        // Get all documents parallel to the current document.
-        pattern = ai::UnicodeString(".*\\.ai$");
-        std::vector<ai::FilePath> ai_document_files =
-            L2A::UTIL::FindFilesInFolder(L2A::UTIL::GetDocumentPath().GetParent(), pattern);
-
-        // Loop over each pdf label and check if it should be deleted.
-        for (const auto& pdf_path : pdf_item_files)
-        {
-            bool delete_this_file = true;
+        if (write_pdf[i])
+            L2A::UTIL::SetLinkFileState(
+                used_pdf_files[i], working_items[i].GetProperty().GetPDFFileHash(), manifest);
 
-            // Check if the pdf if part of this document.
-            for (const auto& used_file : used_pdf_files)
-            {
-                if (pdf_path == used_file) delete_this_file = false;
-            }
-
-            // Check if the pdf fits to another Illustrator document by its name.
-            const ai::UnicodeString pdf_name = pdf_path.GetFileName();
-            for (const auto& ai_file : ai_document_files)
-            {
-                // Do not check the name of this document, as the individual items are already checked above.
-                if (L2A::UTIL::GetDocumentPath() == ai_file) continue;
+        const ai::FilePath old_pdf_path = L2A::AI::GetPlacedItemPath(working_items[i].GetPlacedItem());
+        if (write_pdf[i] || !L2A::UTIL::IsEqualFile(used_pdf_files[i], old_pdf_path))
+            L2A::AI::SetPlacedItemPath(working_items[i].GetPlacedItemMutable(), used_pdf_files[i]);
+    }
 
-                ai::UnicodeString ai_name = ai_file.GetFileNameNoExt();
-                if (L2A::UTIL::StartsWith(pdf_name, ai_name + L2A::NAMES::pdf_item_post_fix_, true))
-                    delete_this_file = false;
-            }
+    // Cleanup pdf links directory.
+    L2A::UTIL::CleanUpLinksDirectory(L2A::UTIL::GetDocumentPath(), used_pdf_files, manifest);
 
-            // If the file is not used by this document or shares the name with an existing Illustrator document, delete
-            // it.
-            if (delete_this_file) L2A::UTIL::RemoveFile(pdf_path);
-        }
-    }
+    return working_items;
 }
@@ -31,6 +31,7 @@
 #define L2A_ITEM_H_
 
 
+#include "l2a_file_system.h"
 #include "l2a_latex.h"
 #include "l2a_property.h"
 
@@ -158,6 +159,11 @@ namespace L2A
          */
         void SaveEncodedPDFFile(const ai::FilePath& pdf_path) const;
 
+        /**
+         * \brief Get the encoded PDF file, so it can be written outside of the plugin thread.
+         */
+        L2A::UTIL::EncodedFile GetEncodedPDFFile(const ai::FilePath& pdf_path) const;
+
         /**
          * \brief Get the name of the item in Illustrator.
          */
@@ -232,14 +238,16 @@ namespace L2A
     void RedoItems(std::vector<AIArtHandle>& items, const RedoItemsOption& redo_option);
 
     /**
-     * \brief Redo the LaTeX code for all items in the vector.
+     * \brief Redo the LaTeX code for all items in the vector. If lookup_compile_cache is false, all items are
+     * compiled again, i.e., the user explicitly requested a redo.
      */
-    bool RedoLaTeXItems(std::vector<L2A::Item>& l2a_items);
+    bool RedoLaTeXItems(std::vector<L2A::Item>& l2a_items, const bool lookup_compile_cache = true);
 
     /**
      * \brief Check if the pdf files of the items are stored and linked correctly.
+     * @return Items in the document that have a stored pdf file.
      */
-    void CheckItemDataStructure();
+    std::vector<L2A::Item> CheckItemDataStructure();
 
 }  // namespace L2A
 #endif
@@ -0,0 +1,164 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Verify the pdf files of the LaTeX2AI items in a document in the background.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_item_verification.h"
+
+#include "l2a_ai_functions.h"
+#include "l2a_file_system.h"
+#include "l2a_global.h"
+#include "l2a_links.h"
+#include "l2a_plugin.h"
+#include "l2a_string_functions.h"
+#include "l2a_trace.h"
+#include "l2a_ui_manager.h"
+
+
+/**
+ *
+ */
+void L2A::ItemVerification::Start(const std::vector<L2A::Item>& items)
+{
+    // A cancelled document is verified again once it is active.
+    if (IsRunning()) verified_documents_.erase(L2A::UTIL::StringAiToStd(document_path_.GetFullPath()));
+    Cancel();
+    if (L2A::Global().is_testing_ || items.size() == 0) return;
+
+    // Each document is only verified once per session.
+    document_path_ = L2A::UTIL::GetDocumentPath(false);
+    if (!verified_documents_.insert(L2A::UTIL::StringAiToStd(document_path_.GetFullPath())).second) return;
+
+    l2a_trace_scope("ItemVerification::Start");
+
+    // The data for the checks is collected on the plugin thread, the stored pdf files are shared with the items.
+    items_.clear();
+    hashes_.clear();
+    link_paths_.clear();
+    std::vector<L2A::UTIL::PdfVerificationTask> tasks;
+    tasks.reserve(items.size());
+    for (const auto& item : items)
+    {
+        const L2A::Property& property = item.GetProperty();
+        items_.push_back(item.GetPlacedItem());
+        hashes_.push_back(property.GetPDFFileHash());
+        link_paths_.push_back(item.GetPDFPath());
+        tasks.push_back({property.GetPDFFileContents(), property.GetPDFFileEncoding(), hashes_.back(),
+            L2A::UTIL::FilePathAiToStd(link_paths_.back())});
+    }
+    verifier_ = std::make_unique<L2A::UTIL::PdfVerifier>(std::move(tasks), time_budget_);
+}
+
+/**
+ *
+ */
+void L2A::ItemVerification::Update()
+{
+    if (verifier_ == nullptr || !verifier_->IsFinished()) return;
+    const auto verifier = std::move(verifier_);
+
+    // The results are discarded if the active document changed, the document is verified again once it is active.
+    if (L2A::AI::GetDocumentCount() == 0 || !L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false)) ||
+        !L2A::UTIL::IsEqualFile(L2A::UTIL::GetDocumentPath(false), document_path_))
+    {
+        verified_documents_.erase(L2A::UTIL::StringAiToStd(document_path_.GetFullPath()));
+        return;
+    }
+
+    l2a_trace_scope("ItemVerification::Update");
+
+    // Items that were deleted or changed since the verification started are skipped.
+    std::vector<AIArtHandle> document_items;
+    L2A::AI::GetDocumentItems(document_items, L2A::AI::SelectionState::all);
+    const std::set<AIArtHandle> document_item_set(document_items.begin(), document_items.end());
+
+    ItemVerificationReport report;
+    report.seconds_ = verifier->GetSeconds();
+    std::vector<L2A::Item> repair_items;
+    const auto& results = verifier->GetResults();
+    const auto is_broken = [](const L2A::UTIL::PdfFileState state)
+    { return state == L2A::UTIL::PdfFileState::corrupt || state == L2A::UTIL::PdfFileState::missing; };
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        if (document_item_set.find(items_[i]) == document_item_set.end()) continue;
+        report.n_items_++;
+
+        const auto& result = results[i];
+        if (result.payload_state_ == L2A::UTIL::PdfFileState::unchecked ||
+            result.link_file_state_ == L2A::UTIL::PdfFileState::unchecked)
+            report.n_unchecked_++;
+        if (!is_broken(result.payload_state_) && !is_broken(result.link_file_state_)) continue;
+
+        L2A::Item item(items_[i]);
+        if (item.GetProperty().GetPDFFileHash() != hashes_[i]) continue;
+        if (is_broken(result.payload_state_))
+            report.corrupt_items_.push_back(items_[i]);
+        else if (result.payload_state_ == L2A::UTIL::PdfFileState::valid)
+            repair_items.push_back(std::move(item));
+    }
+
+    RepairLinkFiles(repair_items);
+    report.n_repaired_ = repair_items.size();
+
+    // The report is only shown if there is something to report.
+    if (report.corrupt_items_.size() > 0 || report.n_repaired_ > 0 || report.n_unchecked_ > 0)
+        L2A::GlobalPluginMutable().GetUiManager().GetVerificationForm().OpenVerificationForm(report);
+}
+
+/**
+ *
+ */
+void L2A::ItemVerification::RepairLinkFiles(std::vector<L2A::Item>& items)
+{
+    if (items.size() == 0) return;
+
+    L2A::AI::UndoActivate();
+
+    // The files are written in parallel, the manifest and the placed items are updated on the plugin thread
+    // afterwards. Setting the path of the placed items reloads the rewritten files.
+    const ai::FilePath pdf_file_directory = L2A::UTIL::GetPdfFileDirectory();
+    L2A::UTIL::CreateDirectoryL2A(pdf_file_directory);
+    L2A::UTIL::LinksLock links_lock(pdf_file_directory);
+    L2A::UTIL::LinksManifest manifest = L2A::UTIL::ReadLinksManifest(pdf_file_directory);
+    std::vector<ai::FilePath> pdf_paths;
+    std::vector<L2A::UTIL::EncodedFile> encoded_files;
+    for (const auto& item : items)
+    {
+        pdf_paths.push_back(item.GetPDFPath());
+        encoded_files.push_back(item.GetEncodedPDFFile(pdf_paths.back()));
+    }
+    L2A::UTIL::decode_files(encoded_files);
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        L2A::UTIL::SetLinkFileState(pdf_paths[i], items[i].GetProperty().GetPDFFileHash(), manifest);
+        L2A::AI::SetPlacedItemPath(items[i].GetPlacedItemMutable(), pdf_paths[i]);
+    }
+    L2A::UTIL::WriteLinksManifest(pdf_file_directory, manifest);
+}
@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Verify the pdf files of the LaTeX2AI items in a document in the background.
+ */
+
+
+#ifndef L2A_ITEM_VERIFICATION_H_
+#define L2A_ITEM_VERIFICATION_H_
+
+
+#include "l2a_item.h"
+#include "l2a_pdf_verifier.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    /**
+     * \brief Summary of the verification of the items in a document.
+     */
+    struct ItemVerificationReport
+    {
+        //! Number of verified items that are still in the document.
+        size_t n_items_ = 0;
+
+        //! Number of items that could not be checked within the time budget.
+        size_t n_unchecked_ = 0;
+
+        //! Number of items whose linked pdf file was broken and rewritten from the pdf file stored in the item.
+        size_t n_repaired_ = 0;
+
+        //! Items whose stored pdf file is broken, they have to be redone.
+        std::vector<AIArtHandle> corrupt_items_;
+
+        //! Wall time of the verification in seconds.
+        double seconds_ = 0.0;
+    };
+
+    /**
+     * \brief Verify the pdf files stored in the items and the linked pdf files after a document is opened.
+     *
+     * The verification runs on worker threads, the plugin polls it with a timer and handles the results once it is
+     * finished. Broken linked files are rewritten from the pdf files stored in the items, items with a broken stored
+     * pdf file are queued to be redone in the report form. Each document is only verified once per session.
+     */
+    class ItemVerification
+    {
+       public:
+        //! Time in seconds after which no further files are checked.
+        static constexpr double time_budget_ = 30.0;
+
+        /**
+         * \brief Start the verification of the items in the active document. A running verification is cancelled.
+         * @param items Items of the document that have a stored pdf file, as returned by CheckItemDataStructure.
+         */
+        void Start(const std::vector<L2A::Item>& items);
+
+        /**
+         * \brief Handle the results if the verification is finished. This does not block.
+         */
+        void Update();
+
+        /**
+         * \brief Cancel a running verification, this blocks until the running checks are finished.
+         */
+        void Cancel() { verifier_ = nullptr; }
+
+        /**
+         * \brief Check if a verification is running.
+         */
+        bool IsRunning() const { return verifier_ != nullptr; }
+
+       private:
+        /**
+         * \brief Rewrite broken linked files from the pdf files stored in the items.
+         */
+        void RepairLinkFiles(std::vector<L2A::Item>& items);
+
+       private:
+        //! Verifier for the current document.
+        std::unique_ptr<L2A::UTIL::PdfVerifier> verifier_;
+
+        //! Document that is verified.
+        ai::FilePath document_path_;
+
+        //! Verified items with their hash and the path of the linked pdf file.
+        std::vector<AIArtHandle> items_;
+        std::vector<std::string> hashes_;
+        std::vector<ai::FilePath> link_paths_;
+
+        //! Documents that were already verified in this session.
+        std::set<std::string> verified_documents_;
+    };
+}  // namespace L2A
+
+#endif
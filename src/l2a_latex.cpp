@@ -34,14 +34,21 @@
 #include "auto_generated/tex.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_compile_cache.h"
+#include "l2a_constants.h"
 #include "l2a_execute.h"
 #include "l2a_file_system.h"
 #include "l2a_global.h"
+#include "l2a_hash.h"
 #include "l2a_names.h"
 #include "l2a_parameter_list.h"
+#include "l2a_pdf_info.h"
 #include "l2a_property.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 
+#include <chrono>
+#include <filesystem>
 #include <regex>
 
 #ifdef WIN_ENV
@@ -49,6 +56,13 @@
 #endif
 
 
+namespace
+{
+    //! Statistics of the pdf file optimizations in the current session.
+    L2A::LATEX::PdfOptimizationStatistics pdf_optimization_statistics_;
+}  // namespace
+
+
 /**
  *
  */
@@ -114,10 +128,21 @@ std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(const ai::FilePath& pdf_file
 std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(
     const ai::FilePath& pdf_file, const unsigned int& n_pages, const ai::UnicodeString& gs_command)
 {
+    l2a_trace_scope("SplitPdfPages");
+
     // Check if file exists
     if (!L2A::UTIL::IsFile(pdf_file))
         l2a_error("The file to split up '" + pdf_file.GetFullPath() + "' does not exits!");
 
+    // Check the number of pages before the file is split. Only the root of the page tree is read for this, so the
+    // check is cheap. If the file can not be parsed, the number of created files is checked after the split.
+    size_t n_pdf_pages = 0;
+    const bool is_page_count_read = L2A::UTIL::ReadPdfFilePageCount(L2A::UTIL::FilePathAiToStd(pdf_file), n_pdf_pages);
+    if (is_page_count_read && n_pages != n_pdf_pages)
+        l2a_error("The given number of pdf pages " + L2A::UTIL::IntegerToString(n_pages) +
+                  " does not match with the number of pages in the pdf file " +
+                  L2A::UTIL::IntegerToString(static_cast<unsigned int>(n_pdf_pages)));
+
     // Get name and folder of the pdf file
     const ai::UnicodeString pdf_name = pdf_file.GetFileName();
     const ai::UnicodeString pdf_name_no_ext = pdf_file.GetFileNameNoExt();
@@ -157,14 +182,15 @@ std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(
                   "<<. Exit code: " + L2A::UTIL::IntegerToString(command_result.exit_status_));
     }
 
-#ifdef _DEBUG
     // Check that the correct number of files was created
-    const auto new_pdf_pages = L2A::UTIL::FindFilesInFolder(pdf_folder, split_files_regex);
-    if (n_pages != new_pdf_pages.size())
-        l2a_error("The given number of pdf pages " + L2A::UTIL::IntegerToString(n_pages) +
-                  " does not match with the number of created split files " +
-                  L2A::UTIL::IntegerToString(static_cast<unsigned int>(new_pdf_pages.size())));
-#endif
+    if (!is_page_count_read)
+    {
+        const auto new_pdf_pages = L2A::UTIL::FindFilesInFolder(pdf_folder, split_files_regex);
+        if (n_pages != new_pdf_pages.size())
+            l2a_error("The given number of pdf pages " + L2A::UTIL::IntegerToString(n_pages) +
+                      " does not match with the number of created split files " +
+                      L2A::UTIL::IntegerToString(static_cast<unsigned int>(new_pdf_pages.size())));
+    }
 
     // Get vector of pdf files for the created split items
     std::vector<ai::FilePath> pdf_files;
@@ -183,6 +209,94 @@ std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(
     return pdf_files;
 }
 
+/**
+ *
+ */
+L2A::LATEX::PdfOptimizationReport L2A::LATEX::OptimizePdfFiles(const std::vector<ai::FilePath>& pdf_files)
+{
+    return OptimizePdfFiles(pdf_files, L2A::Global().gs_command_);
+}
+
+/**
+ *
+ */
+L2A::LATEX::PdfOptimizationReport L2A::LATEX::OptimizePdfFiles(
+    const std::vector<ai::FilePath>& pdf_files, const ai::UnicodeString& gs_command)
+{
+    l2a_trace_scope("OptimizePdfFiles");
+    const auto start_time = std::chrono::steady_clock::now();
+
+    PdfOptimizationReport report;
+    report.file_sizes_.reserve(pdf_files.size());
+    for (const auto& pdf_file : pdf_files)
+    {
+        std::error_code error_code;
+        const std::uintmax_t size = std::filesystem::file_size(L2A::UTIL::FilePathAiToStd(pdf_file), error_code);
+        report.file_sizes_.emplace_back(error_code ? 0 : size, error_code ? 0 : size);
+    }
+
+    // Each input file has a single page, so the output files are numbered in the order of the input files. The
+    // files are split into batches, so the command line does not get too long.
+    const size_t max_command_length = 8000;
+    const ai::UnicodeString optimized_name_base("LaTeX2AI_optimized");
+    size_t i_batch_start = 0;
+    for (size_t i_batch = 0; i_batch_start < pdf_files.size(); i_batch++)
+    {
+        const ai::FilePath pdf_folder = pdf_files[i_batch_start].GetParent();
+        const ai::UnicodeString optimized_name = optimized_name_base + "_" +
+                                                 L2A::UTIL::IntegerToString((unsigned int)i_batch) + "_";
+
+        ai::UnicodeString full_gs_command;
+        full_gs_command += "\"";
+        full_gs_command += gs_command;
+        full_gs_command += "\" -sDEVICE=pdfwrite -dCompatibilityLevel=1.5 -dWriteObjStms=true -dWriteXRefStm=true";
+        full_gs_command += " -dCompressStreams=true -dCompressFonts=true -dSubsetFonts=true";
+        full_gs_command += " -dDetectDuplicateImages=true -o ";
+        full_gs_command += optimized_name;
+        full_gs_command += "%d.pdf";
+        size_t i_batch_end = i_batch_start;
+        while (i_batch_end < pdf_files.size() &&
+               (i_batch_end == i_batch_start || full_gs_command.length() < max_command_length))
+        {
+            full_gs_command += " \"" + pdf_files[i_batch_end].GetFullPath() + "\"";
+            i_batch_end++;
+        }
+
+        // A failing optimization is not an error, the original files are used in this case.
+        L2A::UTIL::SetWorkingDirectory(pdf_folder);
+        const auto command_result = L2A::UTIL::ExecuteCommandLine(full_gs_command);
+        for (size_t i = i_batch_start; i < i_batch_end; i++)
+        {
+            ai::FilePath optimized_file = pdf_folder;
+            optimized_file.AddComponent(
+                optimized_name + L2A::UTIL::IntegerToString((unsigned int)(i - i_batch_start + 1)) + ".pdf");
+            const auto optimized_path = L2A::UTIL::FilePathAiToStd(optimized_file);
+
+            std::error_code error_code;
+            const std::uintmax_t optimized_size = std::filesystem::file_size(optimized_path, error_code);
+            if (command_result.exit_status_ == 0 && !error_code && optimized_size > 0 &&
+                optimized_size < report.file_sizes_[i].first)
+            {
+                std::filesystem::rename(optimized_path, L2A::UTIL::FilePathAiToStd(pdf_files[i]), error_code);
+                if (!error_code) report.file_sizes_[i].second = optimized_size;
+            }
+            std::filesystem::remove(optimized_path, error_code);
+        }
+        i_batch_start = i_batch_end;
+    }
+
+    report.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    return report;
+}
+
+/**
+ *
+ */
+const L2A::LATEX::PdfOptimizationStatistics& L2A::LATEX::GetPdfOptimizationStatistics()
+{
+    return pdf_optimization_statistics_;
+}
+
 /**
  *
  */
@@ -200,23 +314,67 @@ std::pair<L2A::LATEX::LatexCreationResult, ai::FilePath> L2A::LATEX::CreateLatex
  *
  */
 std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX::CreateLatexItems(
-    const std::vector<L2A::Property>& properties)
+    const std::vector<L2A::Property>& properties, const bool lookup_compile_cache)
 {
-    std::vector<ai::FilePath> pdf_files;
+    // The tests check the actual LaTeX compilation, so the cache is not used there.
+    const auto& global = L2A::Global();
+    if (global.is_testing_ || global.compile_cache_size_mb_ <= 0) return CreateLatexItems(properties, nullptr);
+
+    L2A::UTIL::CompileCache compile_cache(
+        global.compile_cache_directory_, std::uintmax_t(global.compile_cache_size_mb_) * 1024 * 1024);
+    return CreateLatexItems(properties, &compile_cache, lookup_compile_cache);
+}
+
+/**
+ *
+ */
+std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX::CreateLatexItems(
+    const std::vector<L2A::Property>& properties, L2A::UTIL::CompileCache* compile_cache,
+    const bool lookup_compile_cache)
+{
+    std::vector<ai::FilePath> pdf_files(properties.size());
 
     try
     {
-        // Loop over all properties and get the combined the latex code as string
+        // Copy the items that are in the compile cache to the temp directory. This is a separate directory, since the
+        // directory for the compilation is cleared before the LaTeX files are written.
+        std::vector<std::string> keys;
+        std::vector<bool> is_cached(properties.size(), false);
+        if (compile_cache != nullptr) keys = GetCompileCacheKeys(properties);
+        if (compile_cache != nullptr && lookup_compile_cache)
+        {
+            l2a_trace_scope("CompileCacheLookup");
+
+            ai::FilePath cached_directory = L2A::UTIL::GetTemporaryDirectory();
+            cached_directory.AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_cached_name_base_));
+            L2A::UTIL::ClearDirectory(cached_directory, false);
+            L2A::UTIL::CreateDirectoryL2A(cached_directory);
+            for (size_t i = 0; i < properties.size(); i++)
+            {
+                pdf_files[i] = cached_directory;
+                pdf_files[i].AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_cached_name_base_) + "_" +
+                                          L2A::UTIL::IntegerToString((unsigned int)i + 1) + ".pdf");
+            }
+
+            is_cached = compile_cache->Lookup(keys, pdf_files);
+        }
+
+        // Loop over all properties that are not cached and get the combined the latex code as string
         ai::UnicodeString combined_latex_code("\n\n");
-        for (const auto& property : properties)
+        std::vector<size_t> compiled_items;
+        for (size_t i = 0; i < properties.size(); i++)
         {
-            if (property.IsBaseline())
+            if (is_cached[i]) continue;
+            compiled_items.push_back(i);
+
+            if (properties[i].IsBaseline())
                 combined_latex_code += ai::UnicodeString("\\LaTeXtoAIbase{");
             else
                 combined_latex_code += ai::UnicodeString("\\LaTeXtoAI{");
-            combined_latex_code += property.GetLaTeXCode();
+            combined_latex_code += properties[i].GetLaTeXCode();
             combined_latex_code += ai::UnicodeString("}\n\n");
         }
+        if (compiled_items.empty()) return {{LatexCreationResult::Result::ok}, pdf_files};
 
         // Create the latex document
         ai::FilePath pdf_file;
@@ -242,14 +400,33 @@ std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX
 
         // Split up the created pdf file into the items, i.e., each page represents a single item. We split the document
         // into the individual pages with ghost script.
+        std::vector<ai::FilePath> compiled_pdf_files;
         try
         {
-            pdf_files = L2A::LATEX::SplitPdfPages(pdf_file, (unsigned int)properties.size());
+            compiled_pdf_files = L2A::LATEX::SplitPdfPages(pdf_file, (unsigned int)compiled_items.size());
         }
         catch (L2A::ERR::Exception& ex)
         {
             return {{LatexCreationResult::Result::error_gs}, {}};
         }
+        if (L2A::Global().optimize_pdf_files_)
+        {
+            const auto report = OptimizePdfFiles(compiled_pdf_files);
+            pdf_optimization_statistics_.n_files_ += report.file_sizes_.size();
+            pdf_optimization_statistics_.bytes_saved_ += report.GetBytesSaved();
+            pdf_optimization_statistics_.seconds_ += report.seconds_;
+        }
+        for (size_t i = 0; i < compiled_items.size(); i++) pdf_files[compiled_items[i]] = compiled_pdf_files[i];
+
+        // Add the compiled items to the cache.
+        if (compile_cache != nullptr)
+        {
+            l2a_trace_scope("CompileCacheInsert");
+
+            std::vector<std::string> compiled_keys;
+            for (const auto i_item : compiled_items) compiled_keys.push_back(keys[i_item]);
+            compile_cache->Insert(compiled_keys, compiled_pdf_files);
+        }
     }
     catch (...)
     {
@@ -260,11 +437,41 @@ std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX
     return {{LatexCreationResult::Result::ok}, pdf_files};
 }
 
+/**
+ *
+ */
+std::vector<std::string> L2A::LATEX::GetCompileCacheKeys(const std::vector<L2A::Property>& properties)
+{
+    // Everything that is the same for all items is hashed once.
+    const auto& global = L2A::Global();
+    std::string settings = GetHeaderWithIncludedInputs(GetHeaderPath());
+    for (const auto& setting : {global.latex_bin_path_.GetFullPath(), global.latex_engine_,
+             global.latex_command_options_, global.gs_command_, ai::UnicodeString(L2A_LATEX_ITEM_),
+             ai::UnicodeString(L2A_VERSION_STRING_)})
+        settings += std::string(1, '\0') + L2A::UTIL::StringAiToStd(setting);
+    settings += global.optimize_pdf_files_ ? "o" : "s";
+    const std::string settings_hash = L2A::UTIL::XXH3HashString(settings.data(), settings.size());
+
+    std::vector<std::string> keys;
+    keys.reserve(properties.size());
+    std::string item;
+    for (const auto& property : properties)
+    {
+        item = settings_hash;
+        item += property.IsBaseline() ? "b" : "n";
+        item += L2A::UTIL::StringAiToStd(property.GetLaTeXCode());
+        keys.push_back(L2A::UTIL::XXH3HashString(item.data(), item.size()));
+    }
+    return keys;
+}
+
 /**
  *
  */
 bool L2A::LATEX::CreateLatexDocument(const ai::UnicodeString& latex_code, ai::FilePath& pdf_file)
 {
+    l2a_trace_scope("CreateLatexDocument");
+
     // Get the directory where the items shall be created
     ai::FilePath tex_directory = L2A::UTIL::GetTemporaryDirectory();
     tex_directory.AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_tex_name_base_));
@@ -284,6 +491,8 @@ bool L2A::LATEX::CreateLatexDocument(const ai::UnicodeString& latex_code, ai::Fi
  */
 bool L2A::LATEX::CompileLatexDocument(const ai::FilePath& tex_file, ai::FilePath& pdf_file)
 {
+    l2a_trace_scope("CompileLatexDocument");
+
     // Get the pdf file name
     pdf_file = tex_file.GetParent();
     pdf_file.AddComponent(tex_file.GetFileNameNoExt() + ".pdf");
@@ -36,11 +36,19 @@
 #include "l2a_error.h"
 #include "l2a_names.h"
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 
 namespace L2A
 {
     // Forward declarations
     class Property;
+    namespace UTIL
+    {
+        class CompileCache;
+    }
 
     namespace LATEX
     {
@@ -79,6 +87,43 @@ namespace L2A
             ai::FilePath tex_header_file_;
         };
 
+        /**
+         * \brief Report of the optimization of pdf files.
+         */
+        struct PdfOptimizationReport
+        {
+            //! Size of each pdf file before and after the optimization in bytes.
+            std::vector<std::pair<std::uintmax_t, std::uintmax_t>> file_sizes_;
+
+            //! Time of the optimization in seconds.
+            double seconds_ = 0.0;
+
+            /**
+             * \brief Total number of bytes saved by the optimization.
+             */
+            std::uintmax_t GetBytesSaved() const
+            {
+                std::uintmax_t bytes_saved = 0;
+                for (const auto& [size_before, size_after] : file_sizes_) bytes_saved += size_before - size_after;
+                return bytes_saved;
+            }
+        };
+
+        /**
+         * \brief Accumulated optimization reports of the items created in the current session.
+         */
+        struct PdfOptimizationStatistics
+        {
+            //! Number of optimized pdf files.
+            std::uint64_t n_files_ = 0;
+
+            //! Number of bytes saved by the optimization.
+            std::uintmax_t bytes_saved_ = 0;
+
+            //! Time of the optimization in seconds.
+            double seconds_ = 0.0;
+        };
+
         /**
          * \brief Get the full LaTeX text for a given latex code.
          */
@@ -99,6 +144,27 @@ namespace L2A
         std::vector<ai::FilePath> SplitPdfPages(
             const ai::FilePath& pdf_file, const unsigned int& n_pages, const ai::UnicodeString& gs_command);
 
+        /**
+         * \brief Optimize the pdf files of the items in place, to reduce the size of the data embedded in the items.
+         *
+         * The files are distilled again with Ghostscript, which only writes the resources that are used on the page.
+         * The objects are stored in compressed object streams with a compressed cross-reference stream (this requires
+         * Ghostscript 10.02 or newer, older versions ignore these options), and all streams and fonts are compressed.
+         * All files are processed with a single Ghostscript call (or a few for many files). A file is only replaced
+         * if the optimized one is smaller, if the optimization fails the original files are kept.
+         *
+         * Optionally the path to the ghost script command can be given. Per default the one from the global object is
+         * taken.
+         */
+        PdfOptimizationReport OptimizePdfFiles(const std::vector<ai::FilePath>& pdf_files);
+        PdfOptimizationReport OptimizePdfFiles(
+            const std::vector<ai::FilePath>& pdf_files, const ai::UnicodeString& gs_command);
+
+        /**
+         * \brief Get the statistics of the pdf file optimizations done while creating items in the current session.
+         */
+        const PdfOptimizationStatistics& GetPdfOptimizationStatistics();
+
         /**
          * \brief Create a latex document for a latex code string
          * @param (in/out) property Property containing the item property that should be converted. If everything is
@@ -111,10 +177,31 @@ namespace L2A
          * \brief Create a latex document for a latex code string
          * @param (in/out) properties Vector containing all item properties that should be converted. If everything
          * is successful the pdf contents are stored in the properties.
+         * @param (in) lookup_compile_cache If this is false, all items are compiled, e.g., for an explicit redo. The
+         * compiled items are still added to the compile cache.
          * @return Result of the latex creation function
          */
         std::pair<LatexCreationResult, std::vector<ai::FilePath>> CreateLatexItems(
-            const std::vector<L2A::Property>& properties);
+            const std::vector<L2A::Property>& properties, const bool lookup_compile_cache = true);
+
+        /**
+         * \brief Create the pdf files for the items, the ones that are in the compile cache are not compiled again.
+         * @param (in) properties Vector containing all item properties that should be converted.
+         * @param (in) compile_cache Compile cache, newly compiled items are added to it. If this is a nullptr, all
+         * items are compiled.
+         * @param (in) lookup_compile_cache If this is false, all items are compiled and added to the compile cache.
+         * @return Result of the latex creation function
+         */
+        std::pair<LatexCreationResult, std::vector<ai::FilePath>> CreateLatexItems(
+            const std::vector<L2A::Property>& properties, L2A::UTIL::CompileCache* compile_cache,
+            const bool lookup_compile_cache = true);
+
+        /**
+         * \brief Get the compile cache keys of the items. The key contains everything that has an influence on the
+         * created pdf file, i.e., the header with its inputs, the LaTeX and Ghostscript settings, the item template,
+         * the plugin version and the item itself.
+         */
+        std::vector<std::string> GetCompileCacheKeys(const std::vector<L2A::Property>& properties);
 
         /**
          * \brief Create a latex document for a latex code string.
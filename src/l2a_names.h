@@ -43,9 +43,19 @@ namespace L2A
         //! Name of header in the L2A directory.
         static const char* tex_header_name_ = "LaTeX2AI_header.tex";
 
-        //! Postfix to the document name for the pdf items.
+        //! Name of the manifest file in the pdf directory.
+        static const char* links_manifest_name_ = "LaTeX2AI_links.xml";
+
+        //! Name of the lock file of the manifest in the pdf directory.
+        static const char* links_lock_name_ = "LaTeX2AI_links.lock";
+
+        //! Postfix to the document name for the pdf items. This was used for the pdf files of previous versions, which
+        //! were not shared between documents.
         static const char* pdf_item_post_fix_ = "_LaTeX2AI_";
 
+        //! Prefix for the shared pdf files in the links directory, it is followed by the hash of the pdf file.
+        static const char* pdf_link_pre_fix_ = "LaTeX2AI_";
+
         //! Name for the item in ai.
         static const char* ai_item_name_ = "LaTeX2AI";
 
@@ -55,6 +65,12 @@ namespace L2A
             "LaTeX2AI_item"
             ".tex";
 
+        //! Name of the directory in the temp directory, where the items from the compile cache are copied to.
+        static const char* create_pdf_cached_name_base_ = "LaTeX2AI_item_cached";
+
+        //! Name of the compile cache directory in the application data directory.
+        static const char* compile_cache_directory_ = "compile_cache";
+
         /**
          * \brief Get the name of a pdf for an item of the current document.
          */
@@ -62,6 +78,14 @@ namespace L2A
         {
             return document_name + L2A::NAMES::pdf_item_post_fix_ + L2A::UTIL::IntegerToString(i, 3) + ".pdf";
         }
+
+        /**
+         * \brief Get the name of the shared pdf file in the links directory for a pdf file hash.
+         */
+        inline ai::UnicodeString GetPdfLinkName(const std::string& pdf_file_hash)
+        {
+            return ai::UnicodeString(L2A::NAMES::pdf_link_pre_fix_) + L2A::UTIL::StringStdToAi(pdf_file_hash) + ".pdf";
+        }
     }  // namespace NAMES
 }  // namespace L2A
 
@@ -41,6 +41,7 @@
 #include "l2a_error.h"
 #include "l2a_global.h"
 #include "l2a_item.h"
+#include "l2a_trace.h"
 
 
 /*
@@ -73,7 +74,11 @@ L2APlugin::L2APlugin(SPPluginRef pluginRef)
       notify_document_save_(nullptr),
       notify_document_save_as_(nullptr),
       notify_active_doc_view_title_changed_(nullptr),
+      notify_layer_options_(nullptr),
+      notify_layer_list_changed_(nullptr),
+      notify_art_properties_changed_(nullptr),
       notify_CSXS_plugplug_setup_complete_(nullptr),
+      timer_item_verification_(nullptr),
       resource_manager_handle_(nullptr),
       ui_manager_(nullptr)
 {
@@ -102,10 +107,7 @@ ASErr L2APlugin::Notify(AINotifierMessage* message)
         {
             // Selection of art items changed in the document.
 
-            // Invalidate the entire document view bounds.
-            annotator_->InvalAnnotation();
-
-            // If the annotator is active, update the item vector.
+            // If the annotator is active, update the items. This also invalidates the region of the changed items.
             annotator_->ArtSelectionChanged();
 
             // Check if there is a single isolated l2a item.
@@ -119,14 +121,41 @@ ASErr L2APlugin::Notify(AINotifierMessage* message)
                 }
             }
         }
+        else if (message->notifier == notify_layer_options_ || message->notifier == notify_layer_list_changed_ ||
+                 message->notifier == notify_art_properties_changed_)
+        {
+            // The hidden or locked state of layers and groups, or the names of items could have changed.
+            hidden_locked_cache_.Invalidate();
+            if (message->notifier == notify_art_properties_changed_) item_registry_.Invalidate();
+
+            // Hidden items are not drawn and locked ones are dimmed, so the changed items have to be redrawn.
+            annotator_->ArtSelectionChanged();
+        }
         else if (message->notifier == notify_active_doc_view_title_changed_ ||
                  message->notifier == notify_document_save_ || message->notifier == notify_document_save_as_)
         {
+            // The cached art handles could belong to a different document.
+            if (message->notifier == notify_active_doc_view_title_changed_)
+            {
+                hidden_locked_cache_.Invalidate();
+                item_registry_.Invalidate();
+            }
+
             if (!L2A::AI::IsActiveDocumentCloudDocument())
             {
                 L2A::AI::UndoActivate();
-                L2A::CheckItemDataStructure();
+                const auto items = L2A::CheckItemDataStructure();
+
+                // The pdf files of the items in an opened document are verified in the background.
+                if (message->notifier == notify_active_doc_view_title_changed_)
+                {
+                    item_verification_.Start(items);
+                    if (item_verification_.IsRunning()) sAITimer->SetTimerActive(timer_item_verification_, true);
+                }
             }
+
+            // The recorded trace spans are written when documents are switched or saved.
+            if (L2A::UTIL::TRACE::IsTraceEnabled()) L2A::UTIL::TRACE::FlushTraceFile();
         }
         else if (message->notifier == notify_CSXS_plugplug_setup_complete_)
         {
@@ -231,6 +260,8 @@ ASErr L2APlugin::StartupPlugin(SPInterfaceMessage* message)
         aisdk::check_ai_error(error);
         error = AddAnnotator(message);
         aisdk::check_ai_error(error);
+        error = AddTimer(message);
+        aisdk::check_ai_error(error);
 
 #ifdef _DEBUG
         // In the debug mode perform all unit tests at startup.
@@ -267,6 +298,12 @@ ASErr L2APlugin::ShutdownPlugin(SPInterfaceMessage* message)
     ASErr error = kNoErr;
     try
     {
+        // Stop a running verification before the objects it uses are deleted.
+        item_verification_.Cancel();
+
+        // Write the remaining trace spans.
+        L2A::UTIL::TRACE::FlushTraceFile();
+
         // If it was created, delete the global object.
         if (L2A::GLOBAL::_l2a_global != nullptr) delete L2A::GLOBAL::_l2a_global;
 
@@ -431,6 +468,32 @@ ASErr L2APlugin::AddAnnotator(SPInterfaceMessage* message)
     return result;
 }
 
+/**
+ *
+ */
+ASErr L2APlugin::AddTimer(SPInterfaceMessage* message)
+{
+    ASErr result = kNoErr;
+    try
+    {
+        // The timer is only active while a verification is running.
+        result = sAITimer->AddTimer(
+            message->d.self, "LaTeX2AI item verification", kTicksPerSecond / 4, &timer_item_verification_);
+        aisdk::check_ai_error(result);
+        result = sAITimer->SetTimerActive(timer_item_verification_, false);
+        aisdk::check_ai_error(result);
+    }
+    catch (ai::Error& ex)
+    {
+        result = ex;
+    }
+    catch (...)
+    {
+        result = kCantHappenErr;
+    }
+    return result;
+}
+
 /*
  *
  */
@@ -451,6 +514,15 @@ ASErr L2APlugin::AddNotifier(SPInterfaceMessage* message)
         result = sAINotifier->AddNotifier(
             fPluginRef, L2A_PLUGIN_NAME, kAIActiveDocViewTitleChangedNotifier, &notify_active_doc_view_title_changed_);
         aisdk::check_ai_error(result);
+        result =
+            sAINotifier->AddNotifier(fPluginRef, L2A_PLUGIN_NAME, kAILayerOptionsNotifier, &notify_layer_options_);
+        aisdk::check_ai_error(result);
+        result = sAINotifier->AddNotifier(
+            fPluginRef, L2A_PLUGIN_NAME, kAILayerListChangedNotifier, &notify_layer_list_changed_);
+        aisdk::check_ai_error(result);
+        result = sAINotifier->AddNotifier(
+            fPluginRef, L2A_PLUGIN_NAME, kAIArtPropertiesChangedNotifier, &notify_art_properties_changed_);
+        aisdk::check_ai_error(result);
         result = sAINotifier->AddNotifier(message->d.self, L2A_PLUGIN_NAME, kAICSXSPlugPlugSetupCompleteNotifier,
             &notify_CSXS_plugplug_setup_complete_);
         aisdk::check_ai_error(result);
@@ -506,6 +578,10 @@ ASErr L2APlugin::SelectTool(AIToolMessage* message)
     {
         // Test the LaTeX2AI framework.
         L2A::TEST::TestFramework();
+
+        // The benchmarks take some time, so we only run them on request. They use the document created by the
+        // framework test.
+        if (L2A::AI::YesNoAlert(ai::UnicodeString("Run the LaTeX2AI benchmarks?"))) L2A::TEST::BenchmarkMain();
     }
 #endif
 
@@ -570,6 +646,30 @@ ASErr L2APlugin::TrackToolCursor(AIToolMessage* message)
     return error;
 }
 
+/**
+ *
+ */
+ASErr L2APlugin::GoTimer(AITimerMessage* message)
+{
+    ASErr result = kNoErr;
+
+    if (message->timer == timer_item_verification_)
+    {
+        try
+        {
+            item_verification_.Update();
+        }
+        catch (L2A::ERR::Exception&)
+        {
+            sAIUser->MessageAlert(ai::UnicodeString("L2APlugin::GoTimer Error caught."));
+        }
+
+        if (!item_verification_.IsRunning()) result = sAITimer->SetTimerActive(timer_item_verification_, false);
+    }
+
+    return result;
+}
+
 /**
  *
  */
@@ -34,6 +34,9 @@
 #include "Plugin.hpp"
 
 #include "l2a_annotator.h"
+#include "l2a_hidden_locked.h"
+#include "l2a_item_registry.h"
+#include "l2a_item_verification.h"
 #include "l2a_ui_manager.h"
 
 
@@ -93,6 +96,16 @@ class L2APlugin : public Plugin
      */
     L2A::UI::Manager& GetUiManager() { return *ui_manager_; }
 
+    /**
+     * \brief Return a reference to the cache for the hidden and locked state of art items
+     */
+    L2A::AI::HiddenLockedCache& GetHiddenLockedCache() { return hidden_locked_cache_; }
+
+    /**
+     * \brief Return a reference to the registry of LaTeX2AI items in the current document
+     */
+    L2A::AI::ItemRegistry& GetItemRegistry() { return item_registry_; }
+
    protected:
     /**
      * \brief Set a link to this plugin in the global object
@@ -157,6 +170,13 @@ class L2APlugin : public Plugin
      */
     virtual ASErr DeselectTool(AIToolMessage* message);
 
+    /**
+     * \brief Is called periodically while a timer of the plugin is active.
+     * @param message IN message data.
+     * @return kNoErr on success, other ASErr otherwise.
+     */
+    virtual ASErr GoTimer(AITimerMessage* message);
+
    private:
     /**
      * \brief Adds the tools for this plugin to the application toolbar.
@@ -172,6 +192,13 @@ class L2APlugin : public Plugin
      */
     ASErr AddAnnotator(SPInterfaceMessage* message);
 
+    /**
+     * \brief Adds the timer that polls the item verification.
+     * @param message IN message data.
+     * @return kNoErr on success, other ASErr otherwise.
+     */
+    ASErr AddTimer(SPInterfaceMessage* message);
+
     /**
      * \brief Performs plugin tasks that could not be performed until
      * the application was started.
@@ -191,9 +218,17 @@ class L2APlugin : public Plugin
     AINotifierHandle notify_document_save_as_;
     AINotifierHandle notify_active_doc_view_title_changed_;
 
+    //! Handle for changes of the layer and group structure.
+    AINotifierHandle notify_layer_options_;
+    AINotifierHandle notify_layer_list_changed_;
+    AINotifierHandle notify_art_properties_changed_;
+
     //! Handle for plug plug actions
     AINotifierHandle notify_CSXS_plugplug_setup_complete_;
 
+    //! Handle for the timer that polls the item verification
+    AITimerHandle timer_item_verification_;
+
     //! Handle for the resource manager added by this plug-in used for setting cursor
     AIResourceManagerHandle resource_manager_handle_;
 
@@ -202,6 +237,15 @@ class L2APlugin : public Plugin
 
     //! User Interface manager
     std::unique_ptr<L2A::UI::Manager> ui_manager_;
+
+    //! Cache for the hidden and locked state of art items
+    L2A::AI::HiddenLockedCache hidden_locked_cache_;
+
+    //! Registry of LaTeX2AI items in the current document
+    L2A::AI::ItemRegistry item_registry_;
+
+    //! Background verification of the pdf files of the items in a document
+    L2A::ItemVerification item_verification_;
 };
 
 #endif  // L2A_PLUGIN_H_
@@ -35,9 +35,84 @@
 #include "l2a_error.h"
 #include "l2a_file_system.h"
 #include "l2a_global.h"
+#include "l2a_hash.h"
 #include "l2a_parameter_list.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 #include "l2a_utils.h"
+#include "l2a_xml_reader.h"
+#include "l2a_xml_writer.h"
+
+
+/**
+ * \brief Schema of the property string. The fields are given in the order they are written in, which is the same
+ * order as in a parameter list.
+ */
+struct L2A::Property::Schema
+{
+    /**
+     * \brief The version of the property is read, but the current version is written.
+     */
+    struct VersionCodec
+    {
+        using value_type = semver::version;
+
+        bool Parse(const std::string_view value, const bool, const std::shared_ptr<const std::string>&,
+            semver::version& member) const
+        {
+            member = L2A::UTIL::ParseVersion(std::string(value));
+            return true;
+        }
+        std::string_view Emit(const semver::version&, std::string&) const { return L2A_VERSION_STRING_; }
+    };
+
+    /**
+     * \brief Codec for Illustrator strings.
+     */
+    struct UnicodeStringCodec
+    {
+        using value_type = ai::UnicodeString;
+
+        bool Parse(const std::string_view value, const bool, const std::shared_ptr<const std::string>&,
+            ai::UnicodeString& member) const
+        {
+            member = L2A::UTIL::StringStdToAi(std::string(value));
+            return true;
+        }
+        std::string_view Emit(const ai::UnicodeString& member, std::string& buffer) const
+        {
+            buffer = L2A::UTIL::StringAiToStd(member);
+            return buffer;
+        }
+    };
+
+    //! Name of the root element.
+    static constexpr std::string_view root_name_ = "LaTeX2AI_item";
+
+    //! Fields of the property string.
+    static constexpr auto fields_ = std::make_tuple(
+        L2A::UTIL::MakeSchemaField("", "latex2ai_version", &Property::version_, VersionCodec()),
+        L2A::UTIL::MakeSchemaField(
+            "", "text_align_horizontal", &Property::text_align_horizontal_, TextAlignHorizontalStrings()),
+        L2A::UTIL::MakeSchemaField(
+            "", "text_align_vertical", &Property::text_align_vertical_, TextAlignVerticalStrings()),
+        L2A::UTIL::MakeSchemaField("latex", "cursor_position", &Property::cursor_position_, L2A::UTIL::UnsignedCodec()),
+        L2A::UTIL::MakeSchemaField("latex", "", &Property::latex_code_, UnicodeStringCodec()),
+        L2A::UTIL::MakeSchemaField(
+            "pdf_file_contents", "encoding", &Property::pdf_file_encoding_, PDFEncodingStrings(), true),
+        L2A::UTIL::MakeSchemaField(
+            "pdf_file_contents", "hash", &Property::pdf_file_hash_, L2A::UTIL::StringCodec(), true),
+        L2A::UTIL::MakeSchemaField(
+            "pdf_file_contents", "hash_method", &Property::pdf_file_hash_method_, HashMethodStrings(), true),
+        L2A::UTIL::MakeSchemaField(
+            "pdf_file_contents", "", &Property::pdf_file_encoded_, L2A::UTIL::SharedStringCodec(), true));
+
+    static_assert(L2A::UTIL::IsSchemaSorted(fields_), "The property schema is not sorted");
+    static_assert(TextAlignHorizontalStrings().IsUnique() && TextAlignVerticalStrings().IsUnique() &&
+                      HashMethodStrings().IsUnique() && PDFEncodingStrings().IsUnique(),
+        "The enum names are not unique");
+};
+
 
 /**
  *
@@ -66,9 +141,11 @@ void L2A::Property::DefaultPropertyValues()
     cursor_position_ = 0;
 
     // PDF file contents.
-    pdf_file_encoded_ = ai::UnicodeString("");
-    pdf_file_hash_ = ai::UnicodeString("");
+    pdf_file_encoded_ = L2A::UTIL::SharedString();
+    pdf_file_parsed_ = true;
+    pdf_file_hash_.clear();
     pdf_file_hash_method_ = HashMethod::none;
+    pdf_file_encoding_ = L2A::UTIL::PayloadEncoding::compact;
 }
 
 /**
@@ -90,10 +167,10 @@ void L2A::Property::SetFromParameterList(const L2A::UTIL::ParameterList& propert
     version_ = L2A::UTIL::ParseVersion(version_string);
 
     // Set the placement options
-    text_align_horizontal_ = L2A::UTIL::KeyToValue(TextAlignHorizontalStrings(), TextAlignHorizontalEnums(),
-        property_parameter_list.GetStringOption(ai::UnicodeString("text_align_horizontal")));
-    text_align_vertical_ = L2A::UTIL::KeyToValue(TextAlignVerticalStrings(), TextAlignVerticalEnums(),
-        property_parameter_list.GetStringOption(ai::UnicodeString("text_align_vertical")));
+    text_align_horizontal_ = TextAlignHorizontalStrings().ToEnum(L2A::UTIL::StringAiToStd(
+        property_parameter_list.GetStringOption(ai::UnicodeString("text_align_horizontal"))));
+    text_align_vertical_ = TextAlignVerticalStrings().ToEnum(
+        L2A::UTIL::StringAiToStd(property_parameter_list.GetStringOption(ai::UnicodeString("text_align_vertical"))));
 
     // Set the latex code.
     latex_code_ = property_parameter_list.GetSubList(ai::UnicodeString("latex"))->GetMainOption();
@@ -102,37 +179,43 @@ void L2A::Property::SetFromParameterList(const L2A::UTIL::ParameterList& propert
     cursor_position_ = property_parameter_list.GetSubList(ai::UnicodeString("latex"))
                            ->GetIntOption(ai::UnicodeString("cursor_position"));
 
+    // Parameter lists from the item form do not contain the pdf file, in this case the current pdf file is kept.
     if (property_parameter_list.SubListExists(ai::UnicodeString("pdf_file_contents")))
     {
+        // The pdf file of a previous string is no longer valid.
+        pdf_file_encoded_ = L2A::UTIL::SharedString();
+        pdf_file_parsed_ = true;
+
         const std::shared_ptr<const L2A::UTIL::ParameterList>& pdf_sub_list =
             property_parameter_list.GetSubList(ai::UnicodeString("pdf_file_contents"));
-        pdf_file_encoded_ = pdf_sub_list->GetMainOption();
-        pdf_file_hash_ = pdf_sub_list->GetStringOption(ai::UnicodeString("hash"));
+        pdf_file_hash_ = L2A::UTIL::StringAiToStd(pdf_sub_list->GetStringOption(ai::UnicodeString("hash")));
 
         if (pdf_sub_list->OptionExists(ai::UnicodeString("hash_method")))
         {
-            pdf_file_hash_method_ = L2A::UTIL::KeyToValue(HashMethodStrings(), HashMethodEnums(),
-                pdf_sub_list->GetStringOption(ai::UnicodeString("hash_method")));
+            pdf_file_hash_method_ = HashMethodStrings().ToEnum(
+                L2A::UTIL::StringAiToStd(pdf_sub_list->GetStringOption(ai::UnicodeString("hash_method"))));
         }
         else
         {
             pdf_file_hash_method_ = HashMethod::none;
         }
 
-        if (pdf_file_hash_method_ != HashMethod::crc64)
+        if (pdf_sub_list->OptionExists(ai::UnicodeString("encoding")))
         {
-            // The current hash method is crc64 if this is not the one that the has was created with, recalculate the
-            // hash and set the hash method accordingly.
-            pdf_file_hash_ = L2A::UTIL::StringHash(pdf_file_encoded_);
-            pdf_file_hash_method_ = HashMethod::crc64;
+            pdf_file_encoding_ = PDFEncodingStrings().ToEnum(
+                L2A::UTIL::StringAiToStd(pdf_sub_list->GetStringOption(ai::UnicodeString("encoding"))));
         }
         else
         {
-#ifdef _DEBUG
-            // Safety check that the pdf hash is correct
-            if (pdf_file_hash_ != L2A::UTIL::StringHash(pdf_file_encoded_))
-                l2a_error("Hash and pdf contents do not match. This should not happen!");
-#endif
+            pdf_file_encoding_ = L2A::UTIL::PayloadEncoding::base64;
+        }
+
+        // If the contents are not in the parameter list, they were cut out by SetFromString and will be extracted
+        // later.
+        if (pdf_sub_list->GetMainOptionSet())
+        {
+            pdf_file_encoded_ = L2A::UTIL::SharedString(L2A::UTIL::StringAiToStd(pdf_sub_list->GetMainOption()));
+            CheckPDFFileHash();
         }
     }
 }
@@ -142,9 +225,86 @@ void L2A::Property::SetFromParameterList(const L2A::UTIL::ParameterList& propert
  */
 void L2A::Property::SetFromString(const ai::UnicodeString& string)
 {
-    // Convert the string to an parameter list.
-    L2A::UTIL::ParameterList property_parameter_list(string);
+    // The encoded pdf file is by far the largest part of the string. The string is read with a pull parser, so the
+    // meta data is read into a parameter list and the property refers to the pdf file in the source string.
+    auto source = std::make_shared<const std::string>(L2A::UTIL::StringAiToStd(string));
+    L2A::UTIL::SharedString::CountCopy();
+
+    // The string contains the whole property, a pdf file of the previous state is not kept.
+    pdf_file_encoded_ = L2A::UTIL::SharedString();
+    pdf_file_parsed_ = true;
+    pdf_file_hash_.clear();
+    pdf_file_hash_method_ = HashMethod::none;
+
+    // Strings written by the current version fit the schema and are read directly into the property. Strings with
+    // unknown or legacy keys are read with the generic parameter list.
+    {
+        L2A::UTIL::XMLReader reader(*source);
+        if (reader.Next() != L2A::UTIL::XMLReader::Event::start_element)
+            l2a_error("The property string does not start with an element.");
+        Property schema_property = *this;
+        if (L2A::UTIL::ParseSchema(Schema::fields_, reader, source, schema_property))
+        {
+            schema_property.pdf_file_parsed_ = schema_property.pdf_file_encoded_.empty();
+            *this = std::move(schema_property);
+            return;
+        }
+    }
+
+    L2A::UTIL::XMLReader reader(*source);
+    if (reader.Next() != L2A::UTIL::XMLReader::Event::start_element)
+        l2a_error("The property string does not start with an element.");
+
+    L2A::UTIL::ParameterList property_parameter_list;
+    L2A::UTIL::SharedString pdf_file_encoded;
+    for (auto event = reader.Next(); event != L2A::UTIL::XMLReader::Event::end_element; event = reader.Next())
+    {
+        if (event == L2A::UTIL::XMLReader::Event::attribute)
+        {
+            property_parameter_list.SetOption(L2A::UTIL::StringStdToAi(std::string(reader.GetName())),
+                L2A::UTIL::StringStdToAi(std::string(reader.GetValue())), true);
+        }
+        else if (event == L2A::UTIL::XMLReader::Event::start_element && reader.GetName() == "pdf_file_contents")
+        {
+            // Only the attributes of the pdf file are added to the parameter list.
+            std::shared_ptr<L2A::UTIL::ParameterList> pdf_sub_list =
+                property_parameter_list.SetSubList(ai::UnicodeString("pdf_file_contents"));
+            for (event = reader.Next(); event == L2A::UTIL::XMLReader::Event::attribute; event = reader.Next())
+            {
+                pdf_sub_list->SetOption(L2A::UTIL::StringStdToAi(std::string(reader.GetName())),
+                    L2A::UTIL::StringStdToAi(std::string(reader.GetValue())), true);
+            }
+            if (event == L2A::UTIL::XMLReader::Event::text)
+            {
+                const std::string_view contents = reader.GetValue();
+                if (reader.IsValueBorrowed())
+                    pdf_file_encoded =
+                        L2A::UTIL::SharedString(source, contents.data() - source->data(), contents.size());
+                else
+                {
+                    pdf_file_encoded = L2A::UTIL::SharedString(std::string(contents));
+                    L2A::UTIL::SharedString::CountCopy();
+                }
+                event = reader.Next();
+            }
+            if (event != L2A::UTIL::XMLReader::Event::end_element)
+                l2a_error("The pdf file element can only contain the encoded pdf file.");
+        }
+        else if (event == L2A::UTIL::XMLReader::Event::start_element)
+        {
+            const auto name = L2A::UTIL::StringStdToAi(std::string(reader.GetName()));
+            property_parameter_list.SetSubList(name, std::make_shared<L2A::UTIL::ParameterList>(reader), true);
+        }
+        else if (event == L2A::UTIL::XMLReader::Event::end_document)
+            l2a_error("Unexpected end of the property string.");
+    }
+
     SetFromParameterList(property_parameter_list);
+    if (pdf_file_encoded.size() > 0)
+    {
+        pdf_file_encoded_ = std::move(pdf_file_encoded);
+        pdf_file_parsed_ = false;
+    }
 }
 
 /**
@@ -157,9 +317,9 @@ L2A::UTIL::ParameterList L2A::Property::ToParameterList(const bool write_pdf_con
 
     // Add the options.
     property_parameter_list.SetOption(ai::UnicodeString("text_align_horizontal"),
-        L2A::UTIL::KeyToValue(TextAlignHorizontalEnums(), TextAlignHorizontalStrings(), text_align_horizontal_));
+        L2A::UTIL::StringStdToAi(std::string(TextAlignHorizontalStrings().ToString(text_align_horizontal_))));
     property_parameter_list.SetOption(ai::UnicodeString("text_align_vertical"),
-        L2A::UTIL::KeyToValue(TextAlignVerticalEnums(), TextAlignVerticalStrings(), text_align_vertical_));
+        L2A::UTIL::StringStdToAi(std::string(TextAlignVerticalStrings().ToString(text_align_vertical_))));
 
     // Add the latex text.
     std::shared_ptr<L2A::UTIL::ParameterList> tex_sub_list =
@@ -172,12 +332,9 @@ L2A::UTIL::ParameterList L2A::Property::ToParameterList(const bool write_pdf_con
     if (write_pdf_content && !pdf_file_hash_.empty())
     {
         // Add the encoded pdf file to the parameter list.
-        std::shared_ptr<L2A::UTIL::ParameterList> pdf_sub_list =
-            property_parameter_list.SetSubList(ai::UnicodeString("pdf_file_contents"));
-        pdf_sub_list->SetMainOption(pdf_file_encoded_);
-        pdf_sub_list->SetOption(ai::UnicodeString("hash"), pdf_file_hash_, true);
-        pdf_sub_list->SetOption(ai::UnicodeString("hash_method"),
-            L2A::UTIL::KeyToValue(HashMethodEnums(), HashMethodStrings(), pdf_file_hash_method_));
+        const L2A::UTIL::SharedString& pdf_file_contents = GetPDFFileContents();
+        SetPDFFileSubList(property_parameter_list)
+            ->SetMainOption(L2A::UTIL::StringStdToAi(std::string(pdf_file_contents.View())));
     }
 
     // We add the current version, i.e., each time a property is saved to an item, we add the version of the plugin that
@@ -192,7 +349,39 @@ L2A::UTIL::ParameterList L2A::Property::ToParameterList(const bool write_pdf_con
  */
 ai::UnicodeString L2A::Property::ToString(const bool write_pdf_content) const
 {
-    return ToParameterList(write_pdf_content).ToXMLString(ai::UnicodeString("LaTeX2AI_item"));
+    // The pdf file is materialized before it is written, this also updates hashes created with an old hash method.
+    const bool write_pdf = write_pdf_content && !pdf_file_hash_.empty();
+    if (write_pdf) MaterializePDFFile();
+
+    // The property is written with the schema, this gives the same string as printing the parameter list.
+    std::string property_string;
+    property_string.reserve(256 + 3 * latex_code_.length() + (write_pdf ? pdf_file_encoded_.size() : 0));
+    L2A::UTIL::XMLWriter writer(property_string);
+    L2A::UTIL::EmitSchema(Schema::fields_, Schema::root_name_, *this, write_pdf, writer);
+    if (write_pdf)
+    {
+        // The pdf file is copied into the string and the conversion to the Illustrator string type can not be
+        // avoided.
+        L2A::UTIL::SharedString::CountCopy();
+        L2A::UTIL::SharedString::CountCopy();
+    }
+    return L2A::UTIL::StringStdToAi(property_string);
+}
+
+/**
+ *
+ */
+std::shared_ptr<L2A::UTIL::ParameterList> L2A::Property::SetPDFFileSubList(
+    L2A::UTIL::ParameterList& parameter_list) const
+{
+    std::shared_ptr<L2A::UTIL::ParameterList> pdf_sub_list =
+        parameter_list.SetSubList(ai::UnicodeString("pdf_file_contents"));
+    pdf_sub_list->SetOption(ai::UnicodeString("hash"), L2A::UTIL::StringStdToAi(GetPDFFileHash()), true);
+    pdf_sub_list->SetOption(ai::UnicodeString("hash_method"),
+        L2A::UTIL::StringStdToAi(std::string(HashMethodStrings().ToString(pdf_file_hash_method_))));
+    pdf_sub_list->SetOption(ai::UnicodeString("encoding"),
+        L2A::UTIL::StringStdToAi(std::string(PDFEncodingStrings().ToString(pdf_file_encoding_))));
+    return pdf_sub_list;
 }
 
 /**
@@ -269,10 +458,65 @@ void L2A::Property::SetFromLastInput()
  */
 void L2A::Property::SetPDFFile(const ai::FilePath& pdf_file)
 {
+    l2a_trace_scope("Property::SetPDFFile");
+
+    // The hash is calculated from the pdf file, not from the encoded string.
+    const std::string pdf_data = L2A::UTIL::ReadFileBinary(pdf_file);
+    pdf_file_hash_ = L2A::UTIL::XXH3HashString(pdf_data.data(), pdf_data.size());
+    pdf_file_hash_method_ = HashMethod::xxh3;
+
     // Encode the pdf file.
-    pdf_file_encoded_ = ai::UnicodeString(L2A::UTIL::encode_file_base64(pdf_file));
+    pdf_file_encoding_ = L2A::UTIL::PayloadEncoding::compact;
+    pdf_file_encoded_ =
+        L2A::UTIL::SharedString(L2A::UTIL::EncodePayload(pdf_file_encoding_, pdf_data.data(), pdf_data.size()));
+    pdf_file_parsed_ = true;
+}
+
+/**
+ *
+ */
+void L2A::Property::MaterializePDFFile() const
+{
+    if (pdf_file_parsed_) return;
+
+    l2a_trace_scope("Property::MaterializePDFFile");
 
-    // Set the hash.
-    pdf_file_hash_ = L2A::UTIL::StringHash(pdf_file_encoded_);
-    pdf_file_hash_method_ = HashMethod::crc64;
+    // The xml reader already resolved escaped characters, only the hash has to be checked.
+    pdf_file_parsed_ = true;
+
+    CheckPDFFileHash();
+}
+
+/**
+ *
+ */
+void L2A::Property::CheckPDFFileHash() const
+{
+    if (pdf_file_hash_method_ != HashMethod::xxh3)
+    {
+        // The current hash method is xxh3 if this is not the one that the has was created with, recalculate the
+        // hash and set the hash method accordingly.
+        pdf_file_hash_ = DecodedPDFFileHash();
+        if (pdf_file_hash_.empty()) l2a_error("The encoded pdf file is not valid.");
+        pdf_file_hash_method_ = HashMethod::xxh3;
+    }
+    else
+    {
+#ifdef _DEBUG
+        // Safety check that the pdf hash is correct
+        if (pdf_file_hash_ != DecodedPDFFileHash())
+            l2a_error("Hash and pdf contents do not match. This should not happen!");
+#endif
+    }
+}
+
+/**
+ *
+ */
+std::string L2A::Property::DecodedPDFFileHash() const
+{
+    std::string pdf_data;
+    if (!L2A::UTIL::DecodePayload(pdf_file_encoding_, pdf_file_encoded_.data(), pdf_file_encoded_.size(), pdf_data))
+        return "";
+    return L2A::UTIL::XXH3HashString(pdf_data.data(), pdf_data.size());
 }
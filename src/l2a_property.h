@@ -32,9 +32,14 @@
 
 #include "IllustratorSDK.h"
 
+#include "l2a_payload.h"
+#include "l2a_schema.h"
+#include "l2a_shared_string.h"
 #include "l2a_version.h"
 
 #include <array>
+#include <memory>
+#include <string>
 
 
 // Forward declaration.
@@ -49,8 +54,11 @@ namespace L2A
         namespace UTIL
         {
             class UnitTest;
+            class Benchmark;
         }
         void TestFramework(L2A::TEST::UTIL::UnitTest& ut);
+        void TestProperty(L2A::TEST::UTIL::UnitTest& ut);
+        void BenchmarkProperty(L2A::TEST::UTIL::Benchmark& bm);
     }  // namespace TEST
 }  // namespace L2A
 
@@ -79,9 +87,10 @@ namespace L2A
     {
         return {TextAlignHorizontal::left, TextAlignHorizontal::centre, TextAlignHorizontal::right};
     }
-    inline std::array<ai::UnicodeString, 3> TextAlignHorizontalStrings()
+    constexpr L2A::UTIL::EnumStringMap<TextAlignHorizontal, 3> TextAlignHorizontalStrings()
     {
-        return {ai::UnicodeString("left"), ai::UnicodeString("centreH"), ai::UnicodeString("right")};
+        return {{{{TextAlignHorizontal::left, "left"}, {TextAlignHorizontal::centre, "centreH"},
+            {TextAlignHorizontal::right, "right"}}}};
     }
 
     /**
@@ -109,10 +118,10 @@ namespace L2A
         return {
             TextAlignVertical::top, TextAlignVertical::centre, TextAlignVertical::baseline, TextAlignVertical::bottom};
     }
-    inline std::array<ai::UnicodeString, 4> TextAlignVerticalStrings()
+    constexpr L2A::UTIL::EnumStringMap<TextAlignVertical, 4> TextAlignVerticalStrings()
     {
-        return {ai::UnicodeString("top"), ai::UnicodeString("centreV"), ai::UnicodeString("baseline"),
-            ai::UnicodeString("bottom")};
+        return {{{{TextAlignVertical::top, "top"}, {TextAlignVertical::centre, "centreV"},
+            {TextAlignVertical::baseline, "baseline"}, {TextAlignVertical::bottom, "bottom"}}}};
     }
 
     /**
@@ -166,15 +175,34 @@ namespace L2A
     {
         //! None
         none,
-        //! CRC64 algorithm
-        crc64
+        //! CRC64 algorithm of the encoded pdf file
+        crc64,
+        //! XXH3 algorithm of the pdf file
+        xxh3
     };
 
     /**
      *\brief Define the HashMethod enum conversions.
      */
-    inline std::array<HashMethod, 1> HashMethodEnums() { return {HashMethod::crc64}; }
-    inline std::array<ai::UnicodeString, 1> HashMethodStrings() { return {ai::UnicodeString("crc64")}; }
+    inline std::array<HashMethod, 2> HashMethodEnums() { return {HashMethod::crc64, HashMethod::xxh3}; }
+    constexpr L2A::UTIL::EnumStringMap<HashMethod, 2> HashMethodStrings()
+    {
+        return {{{{HashMethod::crc64, "crc64"}, {HashMethod::xxh3, "xxh3"}}}};
+    }
+
+    /**
+     *\brief Define the enum conversions for the encoding of the pdf file. Items without an encoding option were created
+     * with base64.
+     */
+    inline std::array<L2A::UTIL::PayloadEncoding, 2> PDFEncodingEnums()
+    {
+        return {L2A::UTIL::PayloadEncoding::base64, L2A::UTIL::PayloadEncoding::compact};
+    }
+    constexpr L2A::UTIL::EnumStringMap<L2A::UTIL::PayloadEncoding, 2> PDFEncodingStrings()
+    {
+        return {{{{L2A::UTIL::PayloadEncoding::base64, "base64"},
+            {L2A::UTIL::PayloadEncoding::compact, "compact_v1"}}}};
+    }
 
     /**
      * \brief Compare flags for property items.
@@ -202,6 +230,8 @@ namespace L2A
     {
         // Define the friend function for testing.
         friend void L2A::TEST::TestFramework(L2A::TEST::UTIL::UnitTest& ut);
+        friend void L2A::TEST::TestProperty(L2A::TEST::UTIL::UnitTest& ut);
+        friend void L2A::TEST::BenchmarkProperty(L2A::TEST::UTIL::Benchmark& bm);
 
        public:
         /**
@@ -221,6 +251,9 @@ namespace L2A
 
         /**
          * \brief Set the parameters form a string.
+         *
+         * Only the meta data of the property is parsed. The encoded pdf file is kept as an unparsed part of the string
+         * and is only extracted once it is accessed.
          */
         void SetFromString(const ai::UnicodeString& string);
 
@@ -277,14 +310,29 @@ namespace L2A
         void SetFromLastInput();
 
         /**
-         * \brief Get the pdf contents of the property.
+         * \brief Get the encoded pdf contents of the property. The contents are shared with all copies of this
+         * property and the string the property was created from.
+         */
+        const L2A::UTIL::SharedString& GetPDFFileContents() const
+        {
+            MaterializePDFFile();
+            return pdf_file_encoded_;
+        }
+
+        /**
+         * \brief Get the encoding of the pdf contents.
          */
-        ai::UnicodeString GetPDFFileContents() const { return pdf_file_encoded_; }
+        L2A::UTIL::PayloadEncoding GetPDFFileEncoding() const { return pdf_file_encoding_; }
 
         /**
-         * \brief Get the hash of the encoded pdf file.
+         * \brief Get the hash of the pdf file.
          */
-        ai::UnicodeString GetPDFFileHash() const { return pdf_file_hash_; }
+        const std::string& GetPDFFileHash() const
+        {
+            // Hashes that were not created with the current hash method have to be recalculated from the pdf contents.
+            if (pdf_file_hash_method_ != HashMethod::xxh3) MaterializePDFFile();
+            return pdf_file_hash_;
+        }
 
         /**
          * \brief Encode a pdf file and store it in this property.
@@ -296,6 +344,32 @@ namespace L2A
          */
         const semver::version& GetVersion() const { return version_; }
 
+       private:
+        //! Compile-time description of the property string.
+        struct Schema;
+
+        /**
+         * \brief Check the hash of the encoded pdf file that was read from a string, if this has not already been
+         * done.
+         */
+        void MaterializePDFFile() const;
+
+        /**
+         * \brief Check the hash of the encoded pdf file and recalculate it if it was created with an old hash method.
+         */
+        void CheckPDFFileHash() const;
+
+        /**
+         * \brief Calculate the hash of the decoded pdf file. An empty string is returned if the pdf file can not be
+         * decoded.
+         */
+        std::string DecodedPDFFileHash() const;
+
+        /**
+         * \brief Add the sub list for the pdf file with the hash to a parameter list. The contents are not added.
+         */
+        std::shared_ptr<L2A::UTIL::ParameterList> SetPDFFileSubList(L2A::UTIL::ParameterList& parameter_list) const;
+
        private:
         //! Horizontal and Vertical alignment of the text.
         TextAlignHorizontal text_align_horizontal_;
@@ -308,13 +382,20 @@ namespace L2A
         unsigned int cursor_position_;
 
         //! Encoded pdf file.
-        ai::UnicodeString pdf_file_encoded_;
+        mutable L2A::UTIL::SharedString pdf_file_encoded_;
 
-        //! Hash of encoded pdf file.
-        ai::UnicodeString pdf_file_hash_;
+        //! Flag if the hash of the encoded pdf file is checked. If not, the encoded pdf file refers to the string the
+        //! property was created from.
+        mutable bool pdf_file_parsed_;
+
+        //! Hash of the pdf file.
+        mutable std::string pdf_file_hash_;
 
         //! Method used to get the file hash.
-        HashMethod pdf_file_hash_method_;
+        mutable HashMethod pdf_file_hash_method_;
+
+        //! Encoding of the pdf file.
+        L2A::UTIL::PayloadEncoding pdf_file_encoding_;
 
         //! Version used to created this property
         //! This version will not be saved when the item is written to text, but rather the current version will be
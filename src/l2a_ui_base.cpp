@@ -132,7 +132,7 @@ void L2A::UI::FormBase::SendDataWrapper(
     full_form_data.SetOption(ai::UnicodeString("git_hash"), ai::UnicodeString(L2A_VERSION_GIT_SHA_HEAD_));
 
     // Get the string containing all data for the form and sent it
-    std::string xml_string = L2A::UTIL::StringAiToStd(full_form_data.ToXMLString(ai::UnicodeString("full_data")));
+    std::string xml_string = full_form_data.ToXMLStringUTF8(ai::UnicodeString("full_data"));
     csxs::event::Event event = {
         event_name.c_str(), csxs::event::kEventScope_Application, "LaTeX2AI", NULL, xml_string.c_str()};
     csxs::event::EventErrorCode result = htmlPPLib.DispatchEvent(&event);
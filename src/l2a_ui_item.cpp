@@ -231,8 +231,7 @@ ASErr L2A::UI::Item::SendData()
     form_parameter_list->SetOption(
         ai::UnicodeString("item_ui_finish_on_enter"), L2A::GlobalMutable().item_ui_finish_on_enter_);
 
-    // Add the item property
-    // TODO: Make sure we dont copy the pdf contents here
+    // Add the item property, the pdf contents are not added to the form data
     form_parameter_list->SetSubList(ai::UnicodeString("LaTeX2AI_item"), property_.ToParameterList());
 
     // Send the data to the form
@@ -41,6 +41,7 @@ L2A::UI::Manager::Manager()
     forms_[FormsEnum::redo] = std::make_unique<Redo>();
     forms_[FormsEnum::debug] = std::make_unique<Debug>();
     forms_[FormsEnum::options] = std::make_unique<Options>();
+    forms_[FormsEnum::verification] = std::make_unique<Verification>();
 }
 
 /**
@@ -34,6 +34,7 @@
 #include "l2a_ui_item.h"
 #include "l2a_ui_options.h"
 #include "l2a_ui_redo.h"
+#include "l2a_ui_verification.h"
 
 #include <map>
 #include <memory>
@@ -49,7 +50,8 @@ namespace L2A::UI
         item,
         redo,
         debug,
-        options
+        options,
+        verification
     };
 
     /**
@@ -109,6 +111,15 @@ namespace L2A::UI
             return *(form);
         }
 
+        /**
+         * @brief Return reference to the verification form
+         */
+        Verification& GetVerificationForm()
+        {
+            auto form = dynamic_cast<Verification*>(forms_[FormsEnum::verification].get());
+            return *(form);
+        }
+
        private:
         //! Map containing all forms for LaTeX2AI
         std::map<FormsEnum, std::unique_ptr<FormBase>> forms_;
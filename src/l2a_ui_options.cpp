@@ -32,6 +32,7 @@
 #include "l2a_ui_options.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_compile_cache.h"
 #include "l2a_constants.h"
 #include "l2a_execute.h"
 #include "l2a_file_system.h"
@@ -39,6 +40,7 @@
 #include "l2a_latex.h"
 #include "l2a_parameter_list.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 
 /**
  * \brief Set the names for item forms
@@ -113,6 +115,26 @@ void L2A::UI::Options::CallbackFormReady(const csxs::event::Event* const eventPa
     auto global_options_parameter_list = form_parameter_list->SetSubList(ai::UnicodeString("latex2ai_options"));
     L2A::Global().ToParameterList(global_options_parameter_list);
 
+    // Get the statistics of the compile cache, the size limit is not relevant for reading them
+    const auto statistics =
+        L2A::UTIL::CompileCache(L2A::Global().compile_cache_directory_, std::uintmax_t(-1)).GetStatistics();
+    auto compile_cache_info = form_parameter_list->SetSubList(ai::UnicodeString("compile_cache"));
+    const auto set_statistic = [&compile_cache_info](const char* name, const std::uintmax_t value)
+    { compile_cache_info->SetOption(ai::UnicodeString(name), L2A::UTIL::StringStdToAi(std::to_string(value))); };
+    set_statistic("hits", statistics.hits_);
+    set_statistic("misses", statistics.misses_);
+    set_statistic("n_entries", statistics.n_entries_);
+    set_statistic("size_mb", statistics.size_ / (1024 * 1024));
+
+    // Get the statistics of the pdf file optimizations in this session
+    const auto& optimization_statistics = L2A::LATEX::GetPdfOptimizationStatistics();
+    auto pdf_optimization_info = form_parameter_list->SetSubList(ai::UnicodeString("pdf_optimization"));
+    const auto set_optimization_statistic = [&pdf_optimization_info](const char* name, const std::uintmax_t value)
+    { pdf_optimization_info->SetOption(ai::UnicodeString(name), L2A::UTIL::StringStdToAi(std::to_string(value))); };
+    set_optimization_statistic("n_files", optimization_statistics.n_files_);
+    set_optimization_statistic("bytes_saved", optimization_statistics.bytes_saved_);
+    set_optimization_statistic("milliseconds", std::uintmax_t(1000.0 * optimization_statistics.seconds_));
+
     // Set the header data
     SetHeaderData(form_parameter_list);
 
@@ -142,6 +164,10 @@ void L2A::UI::Options::CallbackSave(const csxs::event::Event* const eventParam)
     global_mutable.warning_boundary_boxes_ =
         options_form->GetIntOption(ai::UnicodeString("warning_boundary_boxes")) == 1;
     global_mutable.warning_ai_not_saved_ = options_form->GetIntOption(ai::UnicodeString("warning_ai_not_saved")) == 1;
+    global_mutable.trace_enabled_ = options_form->GetIntOption(ai::UnicodeString("trace_enabled")) == 1;
+    global_mutable.compile_cache_size_mb_ = options_form->GetIntOption(ai::UnicodeString("compile_cache_size_mb"));
+    global_mutable.optimize_pdf_files_ = options_form->GetIntOption(ai::UnicodeString("optimize_pdf_files")) == 1;
+    L2A::UTIL::TRACE::SetTraceEnabled(global_mutable.trace_enabled_);
 
     CloseForm();
 }
@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Form for the report of the item verification
+ */
+
+#include "IllustratorSDK.h"
+
+#include "l2a_ui_verification.h"
+
+#include "l2a_ai_functions.h"
+#include "l2a_global.h"
+#include "l2a_item.h"
+#include "l2a_parameter_list.h"
+
+#include <set>
+
+
+/**
+ * \brief Set the names for verification forms
+ */
+const std::string L2A::UI::Verification::FORM_NAME = "LaTeX2AI item verification";
+const std::string L2A::UI::Verification::FORM_ID = "com.adobe.illustrator.latex2aiui.dialog_verification";
+const std::string L2A::UI::Verification::EVENT_TYPE_BASE = "com.adobe.csxs.events.latex2ai.verification";
+const std::string L2A::UI::Verification::EVENT_TYPE_READY = L2A::UI::Verification::EVENT_TYPE_BASE + ".ready";
+const std::string L2A::UI::Verification::EVENT_TYPE_REDO = L2A::UI::Verification::EVENT_TYPE_BASE + ".redo";
+const std::string L2A::UI::Verification::EVENT_TYPE_CANCEL = L2A::UI::Verification::EVENT_TYPE_BASE + ".cancel";
+const std::string L2A::UI::Verification::EVENT_TYPE_UPDATE = L2A::UI::Verification::EVENT_TYPE_BASE + ".update";
+
+
+/**
+ *
+ */
+L2A::UI::Verification::Verification() : FormBase(FORM_NAME, FORM_ID.c_str(), EVENT_TYPE_BASE), report_()
+{
+    // If we don't do this this way, we get a compiler error
+    std::vector<EventListenerData> event_listener_data = {
+        {EVENT_TYPE_READY, CallbackHandler<Verification, &Verification::CallbackFormReady>()},  //
+        {EVENT_TYPE_REDO, CallbackHandler<Verification, &Verification::CallbackRedo>()},        //
+        {EVENT_TYPE_CANCEL, CallbackHandler<Verification, &Verification::CallbackCancel>()}     //
+    };
+    event_listener_data_ = std::move(event_listener_data);
+}
+
+/**
+ *
+ */
+void L2A::UI::Verification::OpenVerificationForm(const L2A::ItemVerificationReport& report)
+{
+    report_ = report;
+    LoadForm();
+}
+
+/**
+ *
+ */
+void L2A::UI::Verification::CallbackFormReady(const csxs::event::Event* const eventParam) { SendData(); }
+
+/**
+ *
+ */
+void L2A::UI::Verification::CallbackRedo(const csxs::event::Event* const eventParam)
+{
+    // We need to activate the app context here, because otherwise functions like the GetDocumentName will not work
+    auto app_context = L2A::GlobalPluginAppContext();
+
+    // The form is not modal, so only the items that are still in the active document are redone.
+    std::vector<AIArtHandle> document_items;
+    L2A::AI::GetDocumentItems(document_items, L2A::AI::SelectionState::all);
+    const std::set<AIArtHandle> document_item_set(document_items.begin(), document_items.end());
+    std::vector<AIArtHandle> redo_items;
+    for (const auto& item : report_.corrupt_items_)
+        if (document_item_set.find(item) != document_item_set.end()) redo_items.push_back(item);
+
+    CloseForm();
+    L2A::RedoItems(redo_items, L2A::RedoItemsOption::latex);
+}
+
+/**
+ *
+ */
+void L2A::UI::Verification::CallbackCancel(const csxs::event::Event* const eventParam) { CloseForm(); }
+
+/**
+ *
+ */
+ASErr L2A::UI::Verification::SendData()
+{
+    auto verification_parameter_list = std::make_shared<L2A::UTIL::ParameterList>();
+    verification_parameter_list->SetOption(ai::UnicodeString("n_items"), (int)report_.n_items_);
+    verification_parameter_list->SetOption(ai::UnicodeString("n_unchecked"), (int)report_.n_unchecked_);
+    verification_parameter_list->SetOption(ai::UnicodeString("n_repaired"), (int)report_.n_repaired_);
+    verification_parameter_list->SetOption(ai::UnicodeString("n_corrupt"), (int)report_.corrupt_items_.size());
+    verification_parameter_list->SetOption(ai::UnicodeString("milliseconds"), (int)(1000.0 * report_.seconds_));
+    SendDataWrapper(verification_parameter_list, EVENT_TYPE_UPDATE);
+
+    return kNoErr;
+}
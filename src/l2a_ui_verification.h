@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Form for the report of the item verification
+ */
+
+#ifndef L2A_UI_VERIFICATION_H_
+#define L2A_UI_VERIFICATION_H_
+
+#include "l2a_item_verification.h"
+#include "l2a_ui_base.h"
+
+namespace L2A::UI
+{
+    /**
+     * @brief Non-modal form that shows the report of the item verification and allows to redo the broken items
+     */
+    class Verification : public FormBase
+    {
+       public:
+        // Define names for this form
+        static const std::string FORM_NAME;
+        static const std::string FORM_ID;
+        static const std::string EVENT_TYPE_BASE;
+        static const std::string EVENT_TYPE_READY;
+        static const std::string EVENT_TYPE_REDO;
+        static const std::string EVENT_TYPE_CANCEL;
+        static const std::string EVENT_TYPE_UPDATE;
+
+       public:
+        /**
+         * @brief Constructor
+         */
+        Verification();
+
+        /**
+         * @brief Reset internal data of the form that is not relevant after it is closed
+         */
+        void ResetFormData() override { report_ = L2A::ItemVerificationReport(); }
+
+        /**
+         * @brief Open the form with the report of a verification
+         */
+        void OpenVerificationForm(const L2A::ItemVerificationReport& report);
+
+        /**
+         * @brief This function is called once the ui is loaded. We send the data to the ui here
+         */
+        void CallbackFormReady(const csxs::event::Event* const eventParam);
+
+        /**
+         * @brief Callback when the broken items should be redone
+         */
+        void CallbackRedo(const csxs::event::Event* const eventParam);
+
+        /**
+         * @brief Callback when the form is closed without action
+         */
+        void CallbackCancel(const csxs::event::Event* const eventParam);
+
+        /**
+         * \brief Send data to the form
+         */
+        ASErr SendData() override;
+
+       private:
+        //! Report of the last verification
+        L2A::ItemVerificationReport report_;
+    };
+}  // namespace L2A::UI
+#endif
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Benchmark of the base64 codec.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "benchmark_base64.h"
+
+#include "base64.h"
+#include "benchmark_utility.h"
+
+#include "l2a_base64.h"
+#include "l2a_error.h"
+
+#include <array>
+
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkBase64(L2A::TEST::UTIL::Benchmark& bm)
+{
+    // Set benchmark name.
+    bm.SetBenchmarkName(ai::UnicodeString("BenchmarkBase64"));
+
+    // Each case is repeated until this amount of data is processed, so small sizes also give stable results.
+    const size_t processed_size = 64 << 20;
+    const std::array<size_t, 3> data_sizes = {64 << 10, 1 << 20, 8 << 20};
+    const std::array<const char*, 3> kernel_names = {"scalar", "ssse3", "avx2"};
+
+    for (const auto data_size : data_sizes)
+    {
+        // Pseudo random data, similar to compressed pdf streams.
+        std::string data(data_size, 0);
+        unsigned int state = 1;
+        for (auto& byte : data)
+        {
+            state = state * 1103515245u + 12345u;
+            byte = (char)(state >> 16);
+        }
+        const size_t n_repetitions = processed_size / data_size;
+        const auto mega_bytes_per_second = [&](const double seconds)
+        { return (double)(data_size * n_repetitions) / (1 << 20) / seconds; };
+
+        // Reference values from the third party implementation.
+        L2A::TEST::UTIL::Timer timer;
+        std::string encoded;
+        for (size_t i = 0; i < n_repetitions; i++) encoded = base64::encode(data.c_str(), (unsigned int)data.size());
+        bm.AddValue(ai::UnicodeString("encode tpl"), data_size, mega_bytes_per_second(timer.Elapsed()),
+            ai::UnicodeString("MB/s"));
+        timer.Reset();
+        for (size_t i = 0; i < n_repetitions; i++) base64::decode(encoded);
+        bm.AddValue(ai::UnicodeString("decode tpl"), data_size, mega_bytes_per_second(timer.Elapsed()),
+            ai::UnicodeString("MB/s"));
+
+        for (const auto kernel : L2A::UTIL::Base64AvailableKernels())
+        {
+            const ai::UnicodeString kernel_name(kernel_names[(size_t)kernel]);
+
+            timer.Reset();
+            for (size_t i = 0; i < n_repetitions; i++)
+            {
+                L2A::UTIL::Base64Encoder encoder(kernel);
+                encoded.clear();
+                encoder.Append(data.data(), data.size(), encoded);
+                encoder.Finish(encoded);
+            }
+            bm.AddValue("encode " + kernel_name, data_size, mega_bytes_per_second(timer.Elapsed()),
+                ai::UnicodeString("MB/s"));
+
+            std::string decoded;
+            timer.Reset();
+            for (size_t i = 0; i < n_repetitions; i++)
+            {
+                L2A::UTIL::Base64Decoder decoder(kernel);
+                decoded.clear();
+                decoder.Append(encoded.data(), encoded.size(), decoded);
+                decoder.Finish(decoded);
+            }
+            bm.AddValue("decode " + kernel_name, data_size, mega_bytes_per_second(timer.Elapsed()),
+                ai::UnicodeString("MB/s"));
+            if (decoded != data) l2a_error("The decoded data does not match the original data");
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Benchmark of the base64 codec.
+ */
+
+
+#ifndef BENCHMARK_BASE64_H_
+#define BENCHMARK_BASE64_H_
+
+
+// Forward declarations.
+namespace L2A
+{
+    namespace TEST
+    {
+        namespace UTIL
+        {
+            class Benchmark;
+        }
+    }  // namespace TEST
+}  // namespace L2A
+
+
+namespace L2A
+{
+    namespace TEST
+    {
+        /**
+         * \brief Benchmark the throughput of the base64 encoder and decoder for all kernels supported by the CPU.
+         */
+        void BenchmarkBase64(L2A::TEST::UTIL::Benchmark& bm);
+    }  // namespace TEST
+}  // namespace L2A
+
+#endif
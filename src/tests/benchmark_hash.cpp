@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Benchmark of the pdf file hash.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "benchmark_hash.h"
+
+#include "benchmark_utility.h"
+
+#include "l2a_base64.h"
+#include "l2a_error.h"
+#include "l2a_hash.h"
+#include "l2a_string_functions.h"
+
+#include <array>
+
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkHash(L2A::TEST::UTIL::Benchmark& bm)
+{
+    // Set benchmark name.
+    bm.SetBenchmarkName(ai::UnicodeString("BenchmarkHash"));
+
+    // Each case is repeated until this amount of data is processed, so small sizes also give stable results.
+    const size_t processed_size = 64 << 20;
+    const std::array<size_t, 4> data_sizes = {1 << 10, 64 << 10, 1 << 20, 8 << 20};
+
+    for (const auto data_size : data_sizes)
+    {
+        // Pseudo random data, similar to compressed pdf streams.
+        std::string data(data_size, 0);
+        unsigned int state = 1;
+        for (auto& byte : data)
+        {
+            state = state * 1103515245u + 12345u;
+            byte = (char)(state >> 16);
+        }
+        std::string encoded;
+        L2A::UTIL::Base64Encoder encoder;
+        encoder.Append(data.data(), data.size(), encoded);
+        encoder.Finish(encoded);
+
+        // The throughput is given with respect to the size of the pdf file for all methods.
+        const size_t n_repetitions = processed_size / data_size;
+        const auto mega_bytes_per_second = [&](const double seconds)
+        { return (double)(data_size * n_repetitions) / (1 << 20) / seconds; };
+
+        // Old hash method, CRC-64 of the encoded pdf file.
+        L2A::TEST::UTIL::Timer timer;
+        size_t hash_length = 0;
+        for (size_t i = 0; i < n_repetitions; i++)
+            hash_length += L2A::UTIL::StringHash(encoded.data(), encoded.size()).size();
+        bm.AddValue(ai::UnicodeString("crc64 encoded"), data_size, mega_bytes_per_second(timer.Elapsed()),
+            ai::UnicodeString("MB/s"));
+
+        // Current hash method, XXH3 of the pdf file.
+        timer.Reset();
+        for (size_t i = 0; i < n_repetitions; i++)
+            hash_length += L2A::UTIL::XXH3HashString(data.data(), data.size()).size();
+        bm.AddValue(ai::UnicodeString("xxh3"), data_size, mega_bytes_per_second(timer.Elapsed()),
+            ai::UnicodeString("MB/s"));
+
+        // XXH3 when only the encoded pdf file is available, i.e., when an old hash is replaced.
+        timer.Reset();
+        for (size_t i = 0; i < n_repetitions; i++)
+            hash_length += L2A::UTIL::XXH3HashBase64(encoded.data(), encoded.size()).size();
+        bm.AddValue(ai::UnicodeString("xxh3 encoded"), data_size, mega_bytes_per_second(timer.Elapsed()),
+            ai::UnicodeString("MB/s"));
+
+        if (hash_length == 0) l2a_error("The hashes should not be empty");
+    }
+}
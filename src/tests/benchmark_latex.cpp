@@ -0,0 +1,198 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Benchmark of the LaTeX pipeline with stub engines.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "benchmark_latex.h"
+
+#include "auto_generated/benchmark.h"
+
+#include "benchmark_utility.h"
+
+#include "l2a_compile_cache.h"
+#include "l2a_error.h"
+#include "l2a_file_system.h"
+#include "l2a_global.h"
+#include "l2a_latex.h"
+#include "l2a_parameter_list.h"
+#include "l2a_property.h"
+#include "l2a_string_functions.h"
+
+
+/**
+ * \brief Write the stub engine and a wrapper that calls it with the given latency.
+ *
+ * Return the command that has to be used to call the wrapper.
+ */
+ai::UnicodeString WriteStubEngine(
+    const ai::FilePath& stub_directory, const ai::UnicodeString& engine, const unsigned int latency_ms)
+{
+    ai::FilePath stub_script = stub_directory;
+    stub_script.AddComponent(ai::UnicodeString("stub_engine.py"));
+    if (!L2A::UTIL::IsFile(stub_script))
+        L2A::UTIL::WriteFileUTF8(stub_script, ai::UnicodeString(L2A_BENCHMARK_STUB_ENGINE_), true);
+
+    ai::FilePath wrapper = stub_directory;
+    ai::UnicodeString wrapper_code;
+#ifdef WIN_ENV
+    wrapper.AddComponent("stub_" + engine + ".bat");
+    wrapper_code += "@python \"%~dp0stub_engine.py\" " + engine + " " + L2A::UTIL::IntegerToString(latency_ms) +
+                    " %*\r\n";
+#else
+    wrapper.AddComponent("stub_" + engine + ".sh");
+    wrapper_code += "#!/bin/sh\nexec python3 \"$(dirname \"$0\")/stub_engine.py\" " + engine + " " +
+                    L2A::UTIL::IntegerToString(latency_ms) + " \"$@\"\n";
+#endif
+    L2A::UTIL::WriteFileUTF8(wrapper, wrapper_code, true);
+#ifndef WIN_ENV
+    std::filesystem::permissions(L2A::UTIL::FilePathAiToStd(wrapper), std::filesystem::perms::owner_exec,
+        std::filesystem::perm_options::add);
+#endif
+
+    return wrapper.GetFullPath();
+}
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkLatex(L2A::TEST::UTIL::Benchmark& bm)
+{
+    // Set benchmark name.
+    bm.SetBenchmarkName(ai::UnicodeString("BenchmarkLatex"));
+
+    // Store the global options and the working directory, so we can reset them at the end.
+    auto& global = L2A::GlobalMutable();
+    const auto old_cwd = std::filesystem::current_path();
+    const auto old_latex_bin_path = global.latex_bin_path_;
+    const auto old_latex_engine = global.latex_engine_;
+    const auto old_gs_command = global.gs_command_;
+    const auto old_optimize_pdf_files = global.optimize_pdf_files_;
+
+    try
+    {
+        ai::FilePath stub_directory = L2A::UTIL::GetTemporaryDirectory();
+        stub_directory.AddComponent(ai::UnicodeString("benchmark_stub_engines"));
+        L2A::UTIL::RemoveDirectoryAI(stub_directory, false);
+        L2A::UTIL::CreateDirectoryL2A(stub_directory);
+
+        const std::array<unsigned int, 2> latencies_ms = {0, 100};
+        const std::array<size_t, 4> n_items_vector = {1, 10, 100, 1000};
+        global.optimize_pdf_files_ = false;
+        for (const auto latency_ms : latencies_ms)
+        {
+            // With an empty binary path the engine is called directly, this way we can pass the full path to the stub.
+            global.latex_bin_path_ = ai::FilePath(ai::UnicodeString(""));
+            global.latex_engine_ =
+                "\"" + WriteStubEngine(stub_directory, ai::UnicodeString("pdflatex"), latency_ms) + "\"";
+            global.gs_command_ = WriteStubEngine(stub_directory, ai::UnicodeString("gs"), latency_ms);
+
+            const ai::UnicodeString case_postfix = " (latency " + L2A::UTIL::IntegerToString(latency_ms) + "ms)";
+            for (const auto n_items : n_items_vector)
+            {
+                // Alternate between normal and baseline items, so both templates are part of the benchmark.
+                std::vector<L2A::Property> properties(n_items);
+                for (size_t i = 0; i < n_items; i++)
+                {
+                    if (i % 2 == 1)
+                    {
+                        auto property_list = properties[i].ToParameterList();
+                        property_list.SetOption(
+                            ai::UnicodeString("text_align_vertical"), ai::UnicodeString("baseline"));
+                        properties[i].SetFromParameterList(property_list);
+                    }
+                }
+
+                L2A::TEST::UTIL::Timer timer;
+                const auto [latex_result, pdf_files] = L2A::LATEX::CreateLatexItems(properties);
+                const double time_create = timer.Elapsed();
+                if (latex_result.result_ != L2A::LATEX::LatexCreationResult::Result::ok ||
+                    pdf_files.size() != n_items)
+                    l2a_error("The stub engines did not create the expected pdf files");
+
+                timer.Reset();
+                for (size_t i = 0; i < n_items; i++) properties[i].SetPDFFile(pdf_files[i]);
+                const double time_embed = timer.Elapsed();
+
+                bm.AddTiming("CreateLatexItems" + case_postfix, n_items, time_create);
+                bm.AddTiming("SetPDFFile" + case_postfix, n_items, time_embed);
+                bm.AddTiming("total" + case_postfix, n_items, time_create + time_embed);
+
+                // Optimize the created pdf files and report the item sizes before and after the optimization.
+                const auto report = L2A::LATEX::OptimizePdfFiles(pdf_files);
+                double size_before = 0.0;
+                double size_after = 0.0;
+                for (const auto& [file_size_before, file_size_after] : report.file_sizes_)
+                {
+                    size_before += (double)file_size_before;
+                    size_after += (double)file_size_after;
+                }
+                bm.AddTiming("OptimizePdfFiles" + case_postfix, n_items, report.seconds_);
+                bm.AddValue("pdf size per item" + case_postfix, n_items, size_before / (double)n_items,
+                    ai::UnicodeString("bytes"));
+                bm.AddValue("optimized pdf size per item" + case_postfix, n_items, size_after / (double)n_items,
+                    ai::UnicodeString("bytes"));
+
+                // The same items with the compile cache, first with an empty cache and then with all items cached.
+                ai::FilePath cache_directory = stub_directory;
+                cache_directory.AddComponent(ai::UnicodeString("compile_cache"));
+                L2A::UTIL::RemoveDirectoryAI(cache_directory, false);
+                L2A::UTIL::CompileCache compile_cache(cache_directory, std::uintmax_t(256) * 1024 * 1024);
+                for (const char* cache_state : {"cold", "warm"})
+                {
+                    timer.Reset();
+                    const auto [cache_result, cache_pdf_files] =
+                        L2A::LATEX::CreateLatexItems(properties, &compile_cache);
+                    const double time_cache = timer.Elapsed();
+                    if (cache_result.result_ != L2A::LATEX::LatexCreationResult::Result::ok ||
+                        cache_pdf_files.size() != n_items)
+                        l2a_error("The stub engines did not create the expected pdf files");
+                    bm.AddTiming(ai::UnicodeString("CreateLatexItems cache ") + ai::UnicodeString(cache_state) +
+                                     case_postfix,
+                        n_items, time_cache);
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        global.latex_bin_path_ = old_latex_bin_path;
+        global.latex_engine_ = old_latex_engine;
+        global.gs_command_ = old_gs_command;
+        global.optimize_pdf_files_ = old_optimize_pdf_files;
+        L2A::UTIL::SetWorkingDirectory(L2A::UTIL::FilePathStdToAi(old_cwd));
+        throw;
+    }
+
+    global.latex_bin_path_ = old_latex_bin_path;
+    global.latex_engine_ = old_latex_engine;
+    global.gs_command_ = old_gs_command;
+    global.optimize_pdf_files_ = old_optimize_pdf_files;
+    L2A::UTIL::SetWorkingDirectory(L2A::UTIL::FilePathStdToAi(old_cwd));
+}
@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Benchmark of the LaTeX pipeline with stub engines.
+ */
+
+
+#ifndef BENCHMARK_LATEX_H_
+#define BENCHMARK_LATEX_H_
+
+
+// Forward declarations.
+namespace L2A
+{
+    namespace TEST
+    {
+        namespace UTIL
+        {
+            class Benchmark;
+        }
+    }  // namespace TEST
+}  // namespace L2A
+
+
+namespace L2A
+{
+    namespace TEST
+    {
+        /**
+         * \brief Benchmark the scaling of CreateLatexItems with the number of items.
+         *
+         * The LaTeX engine and Ghostscript are replaced by deterministic stub engines (see
+         * scripts/benchmark/stub_engine.py) with a configurable latency. Therefore, the measured times only contain the
+         * overhead that LaTeX2AI itself adds per item, i.e., template assembly, file writes, process spawning, page
+         * splitting and base64 embedding. The stub engines require a python3 interpreter in the path. Each case is
+         * also run with an empty and with a filled compile cache.
+         *
+         * This benchmark needs a saved document, since the LaTeX header is located next to the document.
+         */
+        void BenchmarkLatex(L2A::TEST::UTIL::Benchmark& bm);
+    }  // namespace TEST
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,120 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Benchmark of the parameter list representations.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "benchmark_parameter_list.h"
+
+#include "benchmark_utility.h"
+
+#include "l2a_error.h"
+#include "l2a_flat_parameter_list.h"
+#include "l2a_parameter_list.h"
+#include "l2a_string_functions.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkParameterList(L2A::TEST::UTIL::Benchmark& bm)
+{
+    // Set benchmark name.
+    bm.SetBenchmarkName(ai::UnicodeString("BenchmarkParameterList"));
+
+    // Each case is repeated until this number of sub lists is processed.
+    const size_t processed_sub_lists = 20000;
+    const std::array<size_t, 3> n_sub_lists_array = {10, 100, 1000};
+
+    for (const auto n_sub_lists : n_sub_lists_array)
+    {
+        // Create a document similar to the links manifest, with a sub list for each file.
+        L2A::UTIL::ParameterList parameter_list;
+        std::vector<ai::UnicodeString> keys_ai;
+        std::vector<std::string> keys_std;
+        for (size_t i = 0; i < n_sub_lists; i++)
+        {
+            keys_std.push_back("file_" + std::to_string(i));
+            keys_ai.push_back(L2A::UTIL::StringStdToAi(keys_std.back()));
+            auto sub_list = parameter_list.SetSubList(keys_ai.back());
+            sub_list->SetOption(ai::UnicodeString("name"), "document_LaTeX2AI_" + L2A::UTIL::IntegerToString((int)i));
+            sub_list->SetOption(ai::UnicodeString("size"), (int)(1000 + i));
+            sub_list->SetOption(ai::UnicodeString("time"), ai::UnicodeString("2024-01-01 12:00:00"));
+            sub_list->SetOption(ai::UnicodeString("hash"), ai::UnicodeString("0123456789abcdef"));
+        }
+        const ai::UnicodeString xml_string = parameter_list.ToXMLString(ai::UnicodeString("manifest"));
+        const size_t n_repetitions = processed_sub_lists / n_sub_lists;
+
+        // Parse the document and read one option of each sub list.
+        L2A::TEST::UTIL::Timer timer;
+        size_t n_sizes = 0;
+        for (size_t i_repetition = 0; i_repetition < n_repetitions; i_repetition++)
+        {
+            L2A::UTIL::ParameterList read_list(xml_string);
+            for (const auto& key : keys_ai)
+                n_sizes += read_list.GetSubList(key)->GetIntOption(ai::UnicodeString("size"));
+        }
+        bm.AddTiming(ai::UnicodeString("ParameterList"), n_sub_lists, timer.Elapsed() / n_repetitions);
+
+        timer.Reset();
+        for (size_t i_repetition = 0; i_repetition < n_repetitions; i_repetition++)
+        {
+            L2A::UTIL::FlatParameterList read_list(xml_string);
+            for (const auto& key : keys_std) n_sizes -= read_list.GetSubList(key).GetIntOption("size");
+        }
+        bm.AddTiming(ai::UnicodeString("FlatParameterList"), n_sub_lists, timer.Elapsed() / n_repetitions);
+
+        // Only parse the document, the UTF-8 conversion of the string is the same for both classes.
+        const std::string xml_string_std = L2A::UTIL::StringAiToStd(xml_string);
+        timer.Reset();
+        for (size_t i_repetition = 0; i_repetition < n_repetitions; i_repetition++)
+            L2A::UTIL::FlatParameterList read_list(xml_string_std);
+        bm.AddTiming(ai::UnicodeString("FlatParameterList parse UTF-8"), n_sub_lists, timer.Elapsed() / n_repetitions);
+
+        // Write the document.
+        timer.Reset();
+        size_t n_characters = 0;
+        for (size_t i_repetition = 0; i_repetition < n_repetitions; i_repetition++)
+            n_characters += parameter_list.ToXMLString(ai::UnicodeString("manifest")).length();
+        bm.AddTiming(ai::UnicodeString("ToXMLString"), n_sub_lists, timer.Elapsed() / n_repetitions);
+
+        timer.Reset();
+        for (size_t i_repetition = 0; i_repetition < n_repetitions; i_repetition++)
+            n_characters -= parameter_list.ToXMLStringUTF8(ai::UnicodeString("manifest")).size();
+        bm.AddTiming(ai::UnicodeString("ToXMLStringUTF8"), n_sub_lists, timer.Elapsed() / n_repetitions);
+
+        if (n_characters != 0) l2a_error("The XML strings do not have the same length");
+        if (n_sizes != 0) l2a_error("The parameter lists do not have the same values");
+    }
+}
@@ -0,0 +1,200 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Benchmark of the pdf payload in the property.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "benchmark_property.h"
+
+#include "benchmark_utility.h"
+
+#include "l2a_error.h"
+#include "l2a_file_system.h"
+#include "l2a_parameter_list.h"
+#include "l2a_property.h"
+#include "l2a_shared_string.h"
+#include "l2a_string_functions.h"
+
+#include <array>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkProperty(L2A::TEST::UTIL::Benchmark& bm)
+{
+    // Set benchmark name.
+    bm.SetBenchmarkName(ai::UnicodeString("BenchmarkProperty"));
+
+    const auto temp_directory = L2A::UTIL::ClearTemporaryDirectory();
+    ai::FilePath pdf_path = temp_directory;
+    pdf_path.AddComponent(ai::UnicodeString("benchmark_payload.pdf"));
+    ai::FilePath pdf_path_out = temp_directory;
+    pdf_path_out.AddComponent(ai::UnicodeString("benchmark_payload_out.pdf"));
+
+    const std::array<size_t, 3> pdf_sizes = {100 << 10, 1 << 20, 8 << 20};
+    for (const auto pdf_size : pdf_sizes)
+    {
+        // Pseudo random data, similar to compressed pdf streams. Every fourth block is text, similar to the pdf
+        // objects and fonts.
+        {
+            std::string data(pdf_size, 0);
+            unsigned int state = 1;
+            for (size_t i = 0; i < pdf_size; i++)
+            {
+                state = state * 1103515245u + 12345u;
+                data[i] = (i >> 10) % 4 == 3 ? "<< /Type /Font /Subtype /Type1 >>\n"[i % 34] : (char)(state >> 16);
+            }
+            std::ofstream output_stream(L2A::UTIL::FilePathAiToStd(pdf_path), std::ofstream::binary);
+            output_stream.write(data.data(), data.size());
+        }
+
+        // Embed the pdf file in the property string.
+        L2A::UTIL::SharedString::ResetNumberOfCopies();
+        L2A::TEST::UTIL::Timer timer;
+        L2A::Property property;
+        property.SetPDFFile(pdf_path);
+        const ai::UnicodeString property_string = property.ToString(true);
+        bm.AddTiming(ai::UnicodeString("embed"), pdf_size, timer.Elapsed());
+        bm.AddValue(ai::UnicodeString("embed copies"), pdf_size,
+            (double)L2A::UTIL::SharedString::GetNumberOfCopies(), ai::UnicodeString("copies"));
+
+        // Compare the note format used by previous versions with the current one.
+        const std::string pdf_data = L2A::UTIL::ReadFileBinary(pdf_path);
+        for (const auto encoding : L2A::PDFEncodingEnums())
+        {
+            const ai::UnicodeString encoding_name =
+                L2A::UTIL::StringStdToAi(std::string(L2A::PDFEncodingStrings().ToString(encoding)));
+
+            timer.Reset();
+            std::string encoded_pdf = L2A::UTIL::EncodePayload(encoding, pdf_data.data(), pdf_data.size());
+            bm.AddTiming("encode " + encoding_name, pdf_size, timer.Elapsed());
+
+            L2A::Property encoded_property = property;
+            encoded_property.pdf_file_encoding_ = encoding;
+            encoded_property.pdf_file_encoded_ = L2A::UTIL::SharedString(std::move(encoded_pdf));
+            const ai::UnicodeString note = encoded_property.ToString(true);
+            bm.AddValue("note size " + encoding_name, pdf_size, (double)note.length(), ai::UnicodeString("characters"));
+
+            // Read the note and write the pdf file.
+            L2A::UTIL::SharedString::ResetNumberOfCopies();
+            timer.Reset();
+            L2A::Property property_from_string;
+            property_from_string.SetFromString(note);
+            bm.AddTiming("parse " + encoding_name, pdf_size, timer.Elapsed());
+            L2A::UTIL::decode_files({{L2A::UTIL::FilePathAiToStd(pdf_path_out),
+                property_from_string.GetPDFFileContents(), property_from_string.GetPDFFileEncoding()}});
+            bm.AddTiming("extract " + encoding_name, pdf_size, timer.Elapsed());
+            bm.AddValue("extract copies " + encoding_name, pdf_size,
+                (double)L2A::UTIL::SharedString::GetNumberOfCopies(), ai::UnicodeString("copies"));
+
+            // The note is read with a pull parser, the pdf file refers to the UTF-8 copy of the note. For the largest
+            // pdf file the base64 note has more than 10 MB.
+            bm.AddValue("extract memory " + encoding_name, pdf_size,
+                property_from_string.pdf_file_encoded_.GetMemoryUsage(), ai::UnicodeString("bytes"));
+
+            if (property_from_string.GetPDFFileHash() != property.GetPDFFileHash() ||
+                L2A::UTIL::ReadFileBinary(pdf_path_out) != pdf_data)
+                l2a_error("The extracted pdf file does not match the embedded one");
+        }
+    }
+
+    // Read and write the meta data of 1000 properties. Strings that fit the schema are read directly, a string with an
+    // unknown option is read with the generic parameter list.
+    {
+        const size_t n_items = 1000;
+        L2A::Property property;
+        property.latex_code_ = ai::UnicodeString("$\\int_0^1 x^2 \\, \\mathrm{d}x = \\frac{1}{3}$");
+        property.cursor_position_ = 12;
+        const ai::UnicodeString property_string = property.ToString(false);
+        L2A::UTIL::ParameterList generic_parameter_list = property.ToParameterList(false);
+        generic_parameter_list.SetOption(ai::UnicodeString("unknown_option"), ai::UnicodeString("1"));
+        const ai::UnicodeString generic_string = generic_parameter_list.ToXMLString(ai::UnicodeString("LaTeX2AI_item"));
+
+        size_t n_changed = 0;
+        L2A::TEST::UTIL::Timer timer;
+        for (size_t i = 0; i < n_items; i++)
+        {
+            L2A::Property property_from_string;
+            property_from_string.SetFromString(property_string);
+            n_changed += property_from_string.Compare(property).Changed();
+        }
+        bm.AddTiming(ai::UnicodeString("parse meta data schema"), n_items, timer.Elapsed());
+        timer.Reset();
+        for (size_t i = 0; i < n_items; i++)
+        {
+            L2A::Property property_from_string;
+            property_from_string.SetFromString(generic_string);
+            n_changed += property_from_string.Compare(property).Changed();
+        }
+        bm.AddTiming(ai::UnicodeString("parse meta data parameter list"), n_items, timer.Elapsed());
+
+        size_t n_characters = 0;
+        timer.Reset();
+        for (size_t i = 0; i < n_items; i++) n_characters += property.ToString(false).length();
+        bm.AddTiming(ai::UnicodeString("write meta data schema"), n_items, timer.Elapsed());
+        timer.Reset();
+        for (size_t i = 0; i < n_items; i++)
+            n_characters -=
+                property.ToParameterList(false).ToXMLString(ai::UnicodeString("LaTeX2AI_item")).length();
+        bm.AddTiming(ai::UnicodeString("write meta data parameter list"), n_items, timer.Elapsed());
+
+        if (n_changed != 0 || n_characters != 0) l2a_error("The schema does not match the parameter list");
+    }
+
+    // Memory of the pdf payloads and hashes for 1000 items, each item is copied once (as done when the items are
+    // redone). The payload is stored as shared UTF-8 bytes, compare this to an UTF-16 string for each copy.
+    {
+        const size_t n_items = 1000;
+        std::vector<L2A::Property> properties(n_items);
+        for (size_t i = 0; i < n_items; i++)
+        {
+            std::string encoded_pdf(12 << 10, 'A' + (char)(i % 26));
+            properties[i].pdf_file_hash_ = L2A::UTIL::StringHash(encoded_pdf.data(), encoded_pdf.size());
+            properties[i].pdf_file_encoded_ = L2A::UTIL::SharedString(std::move(encoded_pdf));
+        }
+        const std::vector<L2A::Property> property_copies = properties;
+
+        double memory_utf8 = 0.0;
+        double memory_utf16 = 0.0;
+        for (const auto& property_vector : {std::cref(properties), std::cref(property_copies)})
+        {
+            for (const auto& property : property_vector.get())
+            {
+                memory_utf8 += property.pdf_file_encoded_.GetMemoryUsage() + property.pdf_file_hash_.capacity();
+                memory_utf16 += 2.0 * (property.pdf_file_encoded_.size() + property.pdf_file_hash_.size());
+            }
+        }
+        bm.AddValue(ai::UnicodeString("payload memory utf-8"), n_items, memory_utf8, ai::UnicodeString("bytes"));
+        bm.AddValue(ai::UnicodeString("payload memory utf-16"), n_items, memory_utf16, ai::UnicodeString("bytes"));
+    }
+}
@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Benchmark of the pdf payload in the property.
+ */
+
+
+#ifndef BENCHMARK_PROPERTY_H_
+#define BENCHMARK_PROPERTY_H_
+
+
+// Forward declarations.
+namespace L2A
+{
+    namespace TEST
+    {
+        namespace UTIL
+        {
+            class Benchmark;
+        }
+    }  // namespace TEST
+}  // namespace L2A
+
+
+namespace L2A
+{
+    namespace TEST
+    {
+        /**
+         * \brief Benchmark the embedding of a pdf file into a property string and the extraction back to a file.
+         * Besides the time, the number of copies of the encoded pdf file is reported for both directions.
+         */
+        void BenchmarkProperty(L2A::TEST::UTIL::Benchmark& bm);
+    }  // namespace TEST
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Utility functions for benchmarks.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "benchmark_utility.h"
+
+#include "l2a_file_system.h"
+#include "l2a_string_functions.h"
+
+#include <iomanip>
+#include <sstream>
+
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::SetBenchmarkName(const ai::UnicodeString& benchmark_name)
+{
+    benchmark_name_ = benchmark_name;
+}
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::AddTiming(const ai::UnicodeString& case_name, const size_t n, const double seconds)
+{
+    AddValue(case_name, n, seconds, ai::UnicodeString("s"));
+}
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::AddValue(
+    const ai::UnicodeString& case_name, const size_t n, const double value, const ai::UnicodeString& unit)
+{
+    results_.push_back({benchmark_name_, case_name, n, value, unit});
+}
+
+/**
+ *
+ */
+ai::UnicodeString L2A::TEST::UTIL::Benchmark::ToString() const
+{
+    std::ostringstream stream;
+    stream << std::left << std::setw(24) << "benchmark" << std::setw(48) << "case" << std::right << std::setw(8)
+           << "n" << std::setw(16) << "value" << std::setw(16) << "value / n"
+           << "  unit\n";
+    for (const auto& result : results_)
+    {
+        const double value_per_n = result.n_ > 0 ? result.value_ / (double)result.n_ : result.value_;
+        stream << std::left << std::setw(24) << L2A::UTIL::StringAiToStd(result.benchmark_name_) << std::setw(48)
+               << L2A::UTIL::StringAiToStd(result.case_name_) << std::right << std::setw(8) << result.n_
+               << std::setw(16) << std::setprecision(6) << result.value_ << std::setw(16) << value_per_n << "  "
+               << L2A::UTIL::StringAiToStd(result.unit_) << "\n";
+    }
+    return L2A::UTIL::StringStdToAi(stream.str());
+}
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::PrintBenchmarkSummary(const bool print_status) const
+{
+    ai::FilePath result_file = L2A::UTIL::GetApplicationDataDirectory();
+    L2A::UTIL::CreateDirectoryL2A(result_file);
+    result_file.AddComponent(ai::UnicodeString("benchmark_results.txt"));
+    L2A::UTIL::WriteFileUTF8(result_file, ToString(), true);
+
+    if (print_status)
+    {
+        ai::UnicodeString summary_string("");
+        summary_string += "Performed ";
+        summary_string += L2A::UTIL::IntegerToString((unsigned int)results_.size());
+        summary_string += " benchmark measurements\nThe results were written to \"";
+        summary_string += result_file.GetFullPath();
+        summary_string += "\"";
+        sAIUser->MessageAlert(summary_string);
+    }
+}
@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Utility functions for benchmarks.
+ */
+
+#ifndef BENCHMARK_UTILITY_H_
+#define BENCHMARK_UTILITY_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <chrono>
+
+
+namespace L2A
+{
+    namespace TEST
+    {
+        namespace UTIL
+        {
+            /**
+             * \brief Simple wall clock timer, the time is measured from the construction of the object.
+             */
+            class Timer
+            {
+               public:
+                /**
+                 * \brief Default constructor, starts the timer.
+                 */
+                Timer() : start_(std::chrono::steady_clock::now()) {};
+
+                /**
+                 * \brief Restart the timer.
+                 */
+                void Reset() { start_ = std::chrono::steady_clock::now(); }
+
+                /**
+                 * \brief Return the elapsed time in seconds.
+                 */
+                double Elapsed() const
+                {
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+                }
+
+               private:
+                //! Start time of the timer.
+                std::chrono::steady_clock::time_point start_;
+            };
+
+            /**
+             * \brief A class that collects benchmark results.
+             */
+            class Benchmark
+            {
+               public:
+                /**
+                 * \brief Default constructor.
+                 */
+                Benchmark() : benchmark_name_(ai::UnicodeString("default")) {};
+
+                /**
+                 * \brief Set the name of the current benchmark.
+                 */
+                void SetBenchmarkName(const ai::UnicodeString& benchmark_name);
+
+                /**
+                 * \brief Add a timing to the current benchmark.
+                 * @param case_name Name of the measured case.
+                 * @param n Problem size of the case, e.g., the number of items.
+                 * @param seconds Measured wall clock time.
+                 */
+                void AddTiming(const ai::UnicodeString& case_name, const size_t n, const double seconds);
+
+                /**
+                 * \brief Add an arbitrary value to the current benchmark, e.g., a number of bytes.
+                 */
+                void AddValue(const ai::UnicodeString& case_name, const size_t n, const double value,
+                    const ai::UnicodeString& unit);
+
+                /**
+                 * \brief Return the results as a formatted table.
+                 */
+                ai::UnicodeString ToString() const;
+
+                /**
+                 * \brief Write the results to the application data directory and optionally show a summary.
+                 */
+                void PrintBenchmarkSummary(const bool print_status) const;
+
+               private:
+                /**
+                 * \brief A single benchmark result.
+                 */
+                struct Result
+                {
+                    ai::UnicodeString benchmark_name_;
+                    ai::UnicodeString case_name_;
+                    size_t n_;
+                    double value_;
+                    ai::UnicodeString unit_;
+                };
+
+                //! Name of the current benchmark.
+                ai::UnicodeString benchmark_name_;
+
+                //! All results collected so far.
+                std::vector<Result> results_;
+            };
+        }  // namespace UTIL
+    }  // namespace TEST
+}  // namespace L2A
+
+#endif
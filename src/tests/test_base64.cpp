@@ -34,6 +34,7 @@
 #include "base64.h"
 #include "testing_utlity.h"
 
+#include "l2a_base64.h"
 #include "l2a_file_system.h"
 #include "l2a_string_functions.h"
 
@@ -63,6 +64,85 @@ void TestBase64Unit(L2A::TEST::UTIL::UnitTest& ut)
         auto decoded_char = base64::decode(encoded);
         std::string decoded(decoded_char.data(), decoded_char.size());
         ut.CompareStr(ai::UnicodeString(decoded), ai::UnicodeString(text[i_value]));
+
+        // The LaTeX2AI codec has to give the same results with all kernels.
+        for (const auto kernel : L2A::UTIL::Base64AvailableKernels())
+        {
+            L2A::UTIL::Base64Encoder encoder(kernel);
+            std::string l2a_encoded;
+            encoder.Append(text[i_value].data(), text[i_value].size(), l2a_encoded);
+            encoder.Finish(l2a_encoded);
+            ut.CompareStr(ai::UnicodeString(l2a_encoded), ai::UnicodeString(result[i_value]));
+
+            L2A::UTIL::Base64Decoder decoder(kernel);
+            std::string l2a_decoded;
+            ut.CompareInt(decoder.Append(l2a_encoded.data(), l2a_encoded.size(), l2a_decoded), 1);
+            ut.CompareInt(decoder.Finish(l2a_decoded), 1);
+            ut.CompareInt(l2a_decoded == text[i_value], 1);
+        }
+    }
+}
+
+/**
+ *
+ */
+void TestBase64Kernels(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Pseudo random data, long enough for the vectorized kernels.
+    std::string data(100003, 0);
+    unsigned int state = 1;
+    for (auto& byte : data)
+    {
+        state = state * 1103515245u + 12345u;
+        byte = (char)(state >> 16);
+    }
+    const std::string reference = base64::encode(data.c_str(), (unsigned int)data.size());
+
+    for (const auto kernel : L2A::UTIL::Base64AvailableKernels())
+    {
+        for (const size_t chunk_size : {1, 7, 4096, 1 << 20})
+        {
+            // Encode and decode in chunks, the results have to be independent of the chunk size.
+            L2A::UTIL::Base64Encoder encoder(kernel);
+            std::string encoded;
+            const auto get_chunk_size = [&](const size_t i, const size_t size)
+            { return size - i < chunk_size ? size - i : chunk_size; };
+            for (size_t i = 0; i < data.size(); i += chunk_size)
+                encoder.Append(data.data() + i, get_chunk_size(i, data.size()), encoded);
+            encoder.Finish(encoded);
+            ut.CompareInt(encoded == reference, 1);
+
+            L2A::UTIL::Base64Decoder decoder(kernel);
+            std::string decoded;
+            bool is_valid = true;
+            for (size_t i = 0; i < encoded.size(); i += chunk_size)
+                is_valid = decoder.Append(encoded.data() + i, get_chunk_size(i, encoded.size()), decoded) && is_valid;
+            is_valid = decoder.Finish(decoded) && is_valid;
+            ut.CompareInt(is_valid, 1);
+            ut.CompareInt(decoded == data, 1);
+        }
+
+        // Line breaks and padding characters are accepted.
+        std::string formatted;
+        for (size_t i = 0; i < reference.size(); i += 76) formatted += reference.substr(i, 76) + "\r\n";
+        formatted += std::string((4 - reference.size() % 4) % 4, '=');
+        L2A::UTIL::Base64Decoder decoder(kernel);
+        std::string decoded;
+        ut.CompareInt(decoder.Append(formatted.data(), formatted.size(), decoded), 1);
+        ut.CompareInt(decoder.Finish(decoded), 1);
+        ut.CompareInt(decoded == data, 1);
+
+        // Invalid characters are detected in the vectorized part.
+        std::string invalid = reference.substr(0, 1000);
+        invalid[500] = '*';
+        ut.CompareInt(L2A::UTIL::Base64Decoder(kernel).Append(invalid.data(), invalid.size(), decoded), 0);
+        invalid[500] = (char)0xc3;
+        ut.CompareInt(L2A::UTIL::Base64Decoder(kernel).Append(invalid.data(), invalid.size(), decoded), 0);
+
+        // A single character at the end can not be decoded.
+        L2A::UTIL::Base64Decoder decoder_truncated(kernel);
+        ut.CompareInt(decoder_truncated.Append("TWFuT", 5, decoded), 1);
+        ut.CompareInt(decoder_truncated.Finish(decoded), 0);
     }
 }
 
@@ -98,6 +178,21 @@ void TestBase64EnAndDecoding(L2A::TEST::UTIL::UnitTest& ut)
 
     // Compare values.
     ut.CompareStr(text_from_file, ai::UnicodeString(L2A::TEST::UTIL::test_string_4_));
+
+    // Decode multiple files at once, duplicate paths are only written once.
+    std::vector<L2A::UTIL::EncodedFile> encoded_files;
+    std::vector<ai::FilePath> decoded_paths;
+    for (unsigned int i = 0; i < 20; i++)
+    {
+        decoded_paths.push_back(temp_directory);
+        decoded_paths.back().AddComponent(
+            ai::UnicodeString("l2a_test_base64_out_") + L2A::UTIL::IntegerToString(i % 10) + ".txt");
+        encoded_files.push_back(
+            {L2A::UTIL::FilePathAiToStd(decoded_paths.back()), L2A::UTIL::SharedString(std::string(encoded_file))});
+    }
+    L2A::UTIL::decode_files(encoded_files);
+    for (const auto& decoded_path : decoded_paths)
+        ut.CompareStr(L2A::UTIL::ReadFileUTF8(decoded_path), ai::UnicodeString(L2A::TEST::UTIL::test_string_4_));
 }
 
 /**
@@ -109,5 +204,6 @@ void L2A::TEST::TestBase64(L2A::TEST::UTIL::UnitTest& ut)
     ut.SetTestName(ai::UnicodeString("TestBase64"));
 
     TestBase64Unit(ut);
+    TestBase64Kernels(ut);
     TestBase64EnAndDecoding(ut);
 }
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Test the compile cache.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_compile_cache.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_compile_cache.h"
+#include "l2a_file_system.h"
+#include "l2a_string_functions.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestCompileCache(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("CompileCache"));
+
+    // Create the cache and some dummy pdf files in the temp directory.
+    const auto temp_directory = L2A::UTIL::ClearTemporaryDirectory();
+    ai::FilePath cache_directory = temp_directory;
+    cache_directory.AddComponent(ai::UnicodeString("compile_cache"));
+    const auto get_path = [&temp_directory](const std::string& name)
+    {
+        ai::FilePath path = temp_directory;
+        path.AddComponent(L2A::UTIL::StringStdToAi(name));
+        return path;
+    };
+    for (const char name : {'a', 'b', 'c'})
+        L2A::UTIL::WriteFileUTF8(
+            get_path(std::string(1, name) + ".pdf"), ai::UnicodeString(std::string(100, name)), true);
+    const auto is_content = [&get_path](const std::string& name, const char content)
+    { return L2A::UTIL::ReadFileUTF8(get_path(name)) == ai::UnicodeString(std::string(100, content)); };
+
+    // Entries are found after they were inserted, also by other cache objects for the same directory.
+    L2A::UTIL::CompileCache cache(cache_directory, 250);
+    auto is_found = cache.Lookup({"key_a", "key_b"}, {get_path("out_a.pdf"), get_path("out_b.pdf")});
+    ut.CompareInt(is_found == std::vector<bool>{false, false}, 1);
+    cache.Insert({"key_a", "key_b"}, {get_path("a.pdf"), get_path("b.pdf")});
+    L2A::UTIL::CompileCache other_cache(cache_directory, 250);
+    is_found = other_cache.Lookup({"key_b", "key_a"}, {get_path("out_b.pdf"), get_path("out_a.pdf")});
+    ut.CompareInt(is_found == std::vector<bool>{true, true}, 1);
+    ut.CompareInt(is_content("out_a.pdf", 'a'), 1);
+    ut.CompareInt(is_content("out_b.pdf", 'b'), 1);
+
+    // The least recently used entry is removed if the size limit is exceeded.
+    cache.Insert({"key_c"}, {get_path("c.pdf")});
+    is_found = cache.Lookup(
+        {"key_b", "key_a", "key_c"}, {get_path("out_b.pdf"), get_path("out_a.pdf"), get_path("out_c.pdf")});
+    ut.CompareInt(is_found == std::vector<bool>{false, true, true}, 1);
+    auto statistics = cache.GetStatistics();
+    ut.CompareInt((int)statistics.hits_, 4);
+    ut.CompareInt((int)statistics.misses_, 3);
+    ut.CompareInt((int)statistics.evictions_, 1);
+    ut.CompareInt((int)statistics.n_entries_, 2);
+    ut.CompareInt((int)statistics.size_, 200);
+
+    // Keys that are not valid file names are never stored.
+    cache.Insert({"../key_d"}, {get_path("a.pdf")});
+    ut.CompareInt(cache.Lookup({"../key_d"}, {get_path("out_d.pdf")})[0], 0);
+    ut.CompareInt(L2A::UTIL::IsFile(get_path("key_d.pdf")), 0);
+
+    // A corrupted index is rebuilt from the cached files, only the statistics are lost.
+    ai::FilePath index_path = cache_directory;
+    index_path.AddComponent(ai::UnicodeString("LaTeX2AI_compile_cache.txt"));
+    L2A::UTIL::WriteFileUTF8(index_path, ai::UnicodeString("LaTeX2AI_compile_cache 1\nbroken"), true);
+    statistics = cache.GetStatistics();
+    ut.CompareInt((int)statistics.hits_, 0);
+    ut.CompareInt((int)statistics.n_entries_, 2);
+    ut.CompareInt(cache.Lookup({"key_c"}, {get_path("out_c.pdf")})[0], 1);
+    ut.CompareInt(is_content("out_c.pdf", 'c'), 1);
+}
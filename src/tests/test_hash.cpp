@@ -0,0 +1,73 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Test the hash functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_hash.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_base64.h"
+#include "l2a_hash.h"
+#include "l2a_string_functions.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::TEST::TestHash(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("Hash"));
+
+    // Reference values from the xxHash library, one for each code path of the algorithm.
+    std::string data(5000, 0);
+    for (size_t i = 0; i < data.size(); i++) data[i] = (char)(i * 31 + 7);
+    const std::vector<std::pair<size_t, std::string>> reference_hashes = {{0, "2d06800538d394c2"},
+        {3, "15f7093b173d005c"}, {8, "dec6a9a43575982e"}, {16, "7e484c18d74895d0"}, {100, "8c97158042fbf926"},
+        {200, "12fdb864685f344d"}, {1000, "989765d0ea7a5ecd"}, {5000, "559fff92c2b7f8ee"}};
+    for (const auto& [size, reference_hash] : reference_hashes)
+        ut.CompareStr(L2A::UTIL::StringStdToAi(L2A::UTIL::XXH3HashString(data.data(), size)),
+            L2A::UTIL::StringStdToAi(reference_hash));
+
+    // The hash of base64 encoded data is the hash of the decoded bytes.
+    std::string encoded;
+    L2A::UTIL::Base64Encoder encoder;
+    encoder.Append(data.data(), data.size(), encoded);
+    encoder.Finish(encoded);
+    ut.CompareStr(L2A::UTIL::StringStdToAi(L2A::UTIL::XXH3HashBase64(encoded.data(), encoded.size())),
+        ai::UnicodeString("559fff92c2b7f8ee"));
+    ut.CompareInt(L2A::UTIL::XXH3HashBase64("invalid!", 8).empty(), 1);
+}
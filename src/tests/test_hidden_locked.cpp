@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the hidden and locked cache.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_hidden_locked.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_hidden_locked.h"
+
+#include <map>
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::TEST::TestHiddenLocked(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("HiddenLocked"));
+
+    // Synthetic art tree. The art handles are only used as keys, so the addresses of the node objects are used.
+    struct Node
+    {
+        int parent;
+        bool is_hidden;
+        bool is_locked;
+    };
+    const std::vector<Node> nodes = {
+        {-1, false, false},  // 0: layer
+        {-1, true, false},   // 1: hidden layer
+        {0, false, true},    // 2: locked group in layer 0
+        {2, false, false},   // 3: group in group 2
+        {0, false, false},   // 4: group in layer 0
+        {4, false, false},   // 5: item in group 4
+        {4, true, false},    // 6: hidden item in group 4
+        {3, false, false},   // 7: item in group 3
+        {3, false, false},   // 8: item in group 3
+        {1, false, false},   // 9: item in layer 1
+        {1, false, true}     // 10: locked item in layer 1
+    };
+    const auto to_handle = [&nodes](const int i) { return (AIArtHandle)(&nodes[i]); };
+    const auto to_index = [&nodes](const AIArtHandle& handle) { return int((const Node*)handle - nodes.data()); };
+
+    // Count the number of attribute evaluations.
+    int n_attribute_calls = 0;
+    L2A::AI::HiddenLockedCache cache(
+        [&](const AIArtHandle& art_item)
+        {
+            const int parent = nodes[to_index(art_item)].parent;
+            return parent < 0 ? AIArtHandle(nullptr) : to_handle(parent);
+        },
+        [&](const AIArtHandle& art_item)
+        {
+            n_attribute_calls++;
+            const Node& node = nodes[to_index(art_item)];
+            return std::make_pair(node.is_hidden, node.is_locked);
+        });
+
+    // Compare with the state obtained by walking up the full parent chain for each item.
+    const std::vector<int> items = {5, 6, 7, 8, 9, 10};
+    for (const int item : items)
+    {
+        bool expected_hidden = false;
+        bool expected_locked = false;
+        for (int i = item; i >= 0; i = nodes[i].parent)
+        {
+            expected_hidden = expected_hidden || nodes[i].is_hidden;
+            expected_locked = expected_locked || nodes[i].is_locked;
+        }
+
+        bool is_hidden;
+        bool is_locked;
+        cache.GetIsHiddenLocked(to_handle(item), is_hidden, is_locked);
+        ut.CompareInt(is_hidden, expected_hidden);
+        ut.CompareInt(is_locked, expected_locked);
+    }
+
+    // Each of the 5 groups and layers was evaluated once, in addition to the 6 items.
+    ut.CompareInt((int)cache.GetNumberOfCachedGroups(), 5);
+    ut.CompareInt(n_attribute_calls, 11);
+
+    // Evaluating an item again only requires the attributes of the item itself.
+    bool is_hidden;
+    bool is_locked;
+    cache.GetIsHiddenLocked(to_handle(7), is_hidden, is_locked);
+    ut.CompareInt(n_attribute_calls, 12);
+    ut.CompareInt(is_locked, 1);
+
+    // After invalidating the cache, the parents are evaluated again.
+    cache.Invalidate();
+    ut.CompareInt((int)cache.GetNumberOfCachedGroups(), 0);
+    cache.GetIsHiddenLocked(to_handle(8), is_hidden, is_locked);
+    ut.CompareInt(n_attribute_calls, 16);
+    ut.CompareInt(is_hidden, 0);
+    ut.CompareInt(is_locked, 1);
+}
@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the item registry.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_item_registry.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_item_registry.h"
+
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::TEST::TestItemRegistry(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("ItemRegistry"));
+
+    // Synthetic document with placed items. The art handles are only used as keys, so the addresses of the item
+    // objects are used.
+    struct PlacedItem
+    {
+        bool is_l2a_item;
+        bool is_selected;
+        bool is_in_document;
+    };
+    std::vector<PlacedItem> placed_items(10);
+    for (unsigned int i = 0; i < placed_items.size(); i++)
+        placed_items[i] = {i % 3 != 0, i % 2 == 0, true};
+    const auto to_handle = [&placed_items](const size_t i) { return (AIArtHandle)(&placed_items[i]); };
+
+    // Count the number of checks if an item is a LaTeX2AI item.
+    int n_checks = 0;
+    L2A::AI::ItemRegistry registry(
+        [&](std::vector<AIArtHandle>& items, L2A::AI::SelectionState selected)
+        {
+            items.clear();
+            for (size_t i = 0; i < placed_items.size(); i++)
+            {
+                const PlacedItem& item = placed_items[i];
+                if (item.is_in_document && (selected == L2A::AI::SelectionState::all ||
+                                               (selected == L2A::AI::SelectionState::selected) == item.is_selected))
+                    items.push_back(to_handle(i));
+            }
+        },
+        [&](const AIArtHandle& item)
+        {
+            n_checks++;
+            return ((const PlacedItem*)item)->is_l2a_item;
+        });
+
+    // Get the expected items.
+    const auto expected_items = [&](L2A::AI::SelectionState selected)
+    {
+        std::vector<AIArtHandle> items;
+        for (size_t i = 0; i < placed_items.size(); i++)
+        {
+            const PlacedItem& item = placed_items[i];
+            if (item.is_in_document && item.is_l2a_item &&
+                (selected == L2A::AI::SelectionState::all ||
+                    (selected == L2A::AI::SelectionState::selected) == item.is_selected))
+                items.push_back(to_handle(i));
+        }
+        return items;
+    };
+
+    // The first query checks all items, the following ones only use the registry.
+    std::vector<AIArtHandle> items;
+    registry.GetItems(items, L2A::AI::SelectionState::all);
+    ut.CompareInt(items == expected_items(L2A::AI::SelectionState::all), 1);
+    ut.CompareInt(n_checks, 10);
+    registry.GetItems(items, L2A::AI::SelectionState::selected);
+    ut.CompareInt(items == expected_items(L2A::AI::SelectionState::selected), 1);
+    registry.GetItems(items, L2A::AI::SelectionState::deselected);
+    ut.CompareInt(items == expected_items(L2A::AI::SelectionState::deselected), 1);
+    registry.GetItems(items, L2A::AI::SelectionState::all);
+    ut.CompareInt((int)items.size(), 6);
+    ut.CompareInt(n_checks, 10);
+
+    // Remove an item from the document and change the name of another one.
+    placed_items[1].is_in_document = false;
+    placed_items[3].is_l2a_item = true;
+    registry.InvalidateItem(to_handle(3));
+    registry.GetItems(items, L2A::AI::SelectionState::all);
+    ut.CompareInt(items == expected_items(L2A::AI::SelectionState::all), 1);
+    ut.CompareInt(n_checks, 11);
+    ut.CompareInt((int)registry.GetNumberOfRegisteredItems(), 9);
+
+    // Invalidate the whole registry.
+    registry.Invalidate();
+    ut.CompareInt((int)registry.GetNumberOfRegisteredItems(), 0);
+    registry.GetItems(items, L2A::AI::SelectionState::selected);
+    ut.CompareInt(items == expected_items(L2A::AI::SelectionState::selected), 1);
+    ut.CompareInt(n_checks, 16);
+}
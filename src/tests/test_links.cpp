@@ -0,0 +1,219 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the links directory functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_links.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_file_system.h"
+#include "l2a_hash.h"
+#include "l2a_links.h"
+#include "l2a_string_functions.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestLinks(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("Links"));
+
+    using FileSet = std::set<std::string>;
+
+    // Assign files to documents.
+    {
+        const std::vector<std::string> pdf_files = {"doc_LaTeX2AI_a.pdf", "doc_LaTeX2AI_b.pdf", "Other_LaTeX2AI_c.pdf",
+            "other_LaTeX2AI_x_LaTeX2AI_d.pdf", "removed_LaTeX2AI_e.pdf"};
+        const auto document_files = L2A::UTIL::AssignLinkFiles(
+            pdf_files, "doc", {"doc_LaTeX2AI_a.pdf"}, {"other", "other_LaTeX2AI_x", "unrelated"});
+        ut.CompareInt((int)document_files.size(), 4);
+        ut.CompareInt(document_files.at("doc") == FileSet{"doc_LaTeX2AI_a.pdf"}, 1);
+        ut.CompareInt(document_files.at("other") == FileSet{"Other_LaTeX2AI_c.pdf"}, 1);
+        ut.CompareInt(document_files.at("other_LaTeX2AI_x") == FileSet{"other_LaTeX2AI_x_LaTeX2AI_d.pdf"}, 1);
+        ut.CompareInt(document_files.at("") == FileSet{"doc_LaTeX2AI_b.pdf", "removed_LaTeX2AI_e.pdf"}, 1);
+    }
+
+    // Create a dummy document folder in the temp directory.
+    const auto temp_directory = L2A::UTIL::ClearTemporaryDirectory();
+    const auto create_file = [](const ai::FilePath& directory, const char* name)
+    {
+        ai::FilePath path = directory;
+        path.AddComponent(ai::UnicodeString(name));
+        L2A::UTIL::WriteFileUTF8(path, ai::UnicodeString("dummy"), true);
+        return path;
+    };
+    const auto file_exists = [](const ai::FilePath& directory, const char* name)
+    {
+        ai::FilePath path = directory;
+        path.AddComponent(ai::UnicodeString(name));
+        return L2A::UTIL::IsFile(path);
+    };
+    ai::FilePath links_directory = temp_directory;
+    links_directory.AddComponent(ai::UnicodeString("links"));
+    L2A::UTIL::CreateDirectoryL2A(links_directory);
+    const ai::FilePath document_path = create_file(temp_directory, "doc.ai");
+    const ai::FilePath other_document_path = create_file(temp_directory, "Other.ai");
+    const std::vector<ai::FilePath> used_files = {
+        create_file(links_directory, "doc_LaTeX2AI_a.pdf"), create_file(links_directory, "doc_LaTeX2AI_b.pdf")};
+    create_file(links_directory, "doc_LaTeX2AI_c.pdf");
+    create_file(links_directory, "other_LaTeX2AI_d.pdf");
+    create_file(links_directory, "removed_LaTeX2AI_e.pdf");
+
+    // Clean up the directory and check that the manifest was created.
+    L2A::UTIL::LinksManifest manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, used_files, manifest);
+    ut.CompareInt(file_exists(links_directory, "doc_LaTeX2AI_a.pdf"), 1);
+    ut.CompareInt(file_exists(links_directory, "doc_LaTeX2AI_b.pdf"), 1);
+    ut.CompareInt(file_exists(links_directory, "doc_LaTeX2AI_c.pdf"), 0);
+    ut.CompareInt(file_exists(links_directory, "other_LaTeX2AI_d.pdf"), 1);
+    ut.CompareInt(file_exists(links_directory, "removed_LaTeX2AI_e.pdf"), 0);
+    manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+    ut.CompareInt((int)manifest.document_files_.size(), 2);
+    ut.CompareInt(manifest.document_files_["doc"] == FileSet{"doc_LaTeX2AI_a.pdf", "doc_LaTeX2AI_b.pdf"}, 1);
+    ut.CompareInt(manifest.document_files_["Other"] == FileSet{"other_LaTeX2AI_d.pdf"}, 1);
+    ut.CompareStr(manifest.links_time_, L2A::UTIL::GetLastWriteTimeString(links_directory));
+
+    // Nothing changed in the links directory, so it is not scanned again. Therefore, the files of the removed
+    // document are kept.
+    L2A::UTIL::RemoveFile(other_document_path);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, used_files, manifest);
+    ut.CompareInt(file_exists(links_directory, "other_LaTeX2AI_d.pdf"), 1);
+
+    // Check the hashes of the files. The state of the file is stored in the manifest.
+    const std::string data_a = L2A::UTIL::ReadFileBinary(used_files[0]);
+    const std::string hash_a = L2A::UTIL::XXH3HashString(data_a.data(), data_a.size());
+    ut.CompareInt(L2A::UTIL::IsLinkFileValid(used_files[0], hash_a, manifest), 1);
+    ut.CompareInt(L2A::UTIL::IsLinkFileValid(used_files[1], "wrong_hash", manifest), 0);
+    ut.CompareInt((int)manifest.file_states_.size(), 2);
+    ut.CompareInt(manifest.modified_, 1);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, used_files, manifest);
+    ut.CompareInt(manifest.modified_, 0);
+    manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+    ut.CompareInt((int)manifest.file_states_.size(), 2);
+    ut.CompareInt(manifest.file_states_["doc_LaTeX2AI_a.pdf"].hash_ == hash_a, 1);
+
+    // If the file did not change, the stored hash is used and the file is not read.
+    manifest.file_states_["doc_LaTeX2AI_a.pdf"].hash_ = "stored_hash";
+    ut.CompareInt(L2A::UTIL::IsLinkFileValid(used_files[0], "stored_hash", manifest), 1);
+    ut.CompareInt(manifest.modified_, 0);
+
+    // A changed file is read again.
+    L2A::UTIL::WriteFileUTF8(used_files[0], ai::UnicodeString("changed contents"), true);
+    ut.CompareInt(L2A::UTIL::IsLinkFileValid(used_files[0], "stored_hash", manifest), 0);
+    ut.CompareInt(L2A::UTIL::IsLinkFileValid(used_files[0], hash_a, manifest), 0);
+    ut.CompareInt(manifest.modified_, 1);
+
+    // Missing files are not valid.
+    ai::FilePath missing_path = links_directory;
+    missing_path.AddComponent(ai::UnicodeString("doc_LaTeX2AI_missing.pdf"));
+    ut.CompareInt(L2A::UTIL::IsLinkFileValid(missing_path, hash_a, manifest), 0);
+
+    // The files used by the document changed, the directory is scanned again.
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {used_files[0]}, manifest);
+    ut.CompareInt(file_exists(links_directory, "doc_LaTeX2AI_a.pdf"), 1);
+    ut.CompareInt(file_exists(links_directory, "doc_LaTeX2AI_b.pdf"), 0);
+    ut.CompareInt(file_exists(links_directory, "other_LaTeX2AI_d.pdf"), 0);
+    manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+    ut.CompareInt((int)manifest.document_files_.size(), 1);
+    ut.CompareInt((int)manifest.file_states_.size(), 1);
+
+    // Names of the shared pdf files.
+    ut.CompareInt(L2A::UTIL::IsSharedLinkFile("LaTeX2AI_0123456789abcdef.pdf"), 1);
+    ut.CompareInt(L2A::UTIL::IsSharedLinkFile("doc_LaTeX2AI_0123456789abcdef.pdf"), 0);
+    ut.CompareInt(L2A::UTIL::IsSharedLinkFile("LaTeX2AI_0123456789ABCDEF.pdf"), 0);
+    ut.CompareInt(L2A::UTIL::IsSharedLinkFile("LaTeX2AI_0123456789abcde.pdf"), 0);
+
+    // Shared pdf files are referenced by all documents that use them.
+    const ai::FilePath second_document_path = create_file(temp_directory, "second.ai");
+    const ai::FilePath shared_a = create_file(links_directory, "LaTeX2AI_000000000000000a.pdf");
+    const ai::FilePath shared_b = create_file(links_directory, "LaTeX2AI_000000000000000b.pdf");
+    create_file(links_directory, "LaTeX2AI_000000000000000c.pdf");
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {shared_a, shared_b}, manifest);
+    L2A::UTIL::CleanUpLinksDirectory(second_document_path, {shared_a}, manifest);
+    ut.CompareInt(file_exists(links_directory, "doc_LaTeX2AI_a.pdf"), 0);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000c.pdf"), 0);
+    manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+    std::map<std::string, unsigned int> references = L2A::UTIL::CountLinkReferences(manifest);
+    ut.CompareInt((int)references.size(), 2);
+    ut.CompareInt((int)references["LaTeX2AI_000000000000000a.pdf"], 2);
+    ut.CompareInt((int)references["LaTeX2AI_000000000000000b.pdf"], 1);
+
+    // A file is deleted once it is no longer referenced.
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {shared_a}, manifest);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000a.pdf"), 1);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000b.pdf"), 0);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {}, manifest);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000a.pdf"), 1);
+
+    // Files written for new items of a document that is not saved yet are referenced right away, so they are kept if
+    // another document in the folder is saved first.
+    const std::vector<ai::FilePath> new_item_files = {create_file(links_directory, "LaTeX2AI_000000000000000d.pdf")};
+    L2A::UTIL::AddLinkReferences(second_document_path, new_item_files, manifest);
+    ut.CompareInt(manifest.modified_, 1);
+    L2A::UTIL::WriteLinksManifest(links_directory, manifest);
+    L2A::UTIL::AddLinkReferences(second_document_path, new_item_files, manifest);
+    ut.CompareInt(manifest.modified_, 0);
+    manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {}, manifest);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000d.pdf"), 1);
+    ut.CompareInt(
+        manifest.document_files_["second"] == FileSet{"LaTeX2AI_000000000000000a.pdf", "LaTeX2AI_000000000000000d.pdf"},
+        1);
+
+    // A document that was copied into the folder is not in the manifest, but it can use shared pdf files. Shared pdf
+    // files that are not referenced are kept until all documents in the folder are in the manifest. The cleanup is
+    // done while the lock of the links directory is held, the lock file is kept.
+    const ai::FilePath copied_document_path = create_file(temp_directory, "copied.ai");
+    create_file(links_directory, "LaTeX2AI_000000000000000e.pdf");
+    {
+        L2A::UTIL::LinksLock links_lock(links_directory);
+        ut.CompareInt(links_lock.IsLocked(), 1);
+        manifest = L2A::UTIL::ReadLinksManifest(links_directory);
+        L2A::UTIL::CleanUpLinksDirectory(document_path, {shared_a}, manifest);
+    }
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000e.pdf"), 1);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_links.lock"), 1);
+    L2A::UTIL::CleanUpLinksDirectory(copied_document_path, {}, manifest);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000e.pdf"), 0);
+    L2A::UTIL::RemoveFile(copied_document_path);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {}, manifest);
+    ut.CompareInt((int)manifest.document_files_.size(), 2);
+
+    // Documents that no longer exist release their references.
+    L2A::UTIL::RemoveFile(second_document_path);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {shared_a}, manifest);
+    references = L2A::UTIL::CountLinkReferences(manifest);
+    ut.CompareInt((int)manifest.document_files_.size(), 1);
+    ut.CompareInt((int)references["LaTeX2AI_000000000000000a.pdf"], 1);
+    L2A::UTIL::CleanUpLinksDirectory(document_path, {}, manifest);
+    ut.CompareInt(file_exists(links_directory, "LaTeX2AI_000000000000000a.pdf"), 0);
+}
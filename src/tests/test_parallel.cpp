@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Test the parallel functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_parallel.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_parallel.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::TEST::TestParallel(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("Parallel"));
+
+    // Each task is executed exactly once.
+    for (const unsigned int n_threads : {0u, 1u, 4u})
+    {
+        std::vector<int> counter(1000, 0);
+        L2A::UTIL::ParallelFor(counter.size(), [&](size_t i) { counter[i]++; }, n_threads);
+        int n_wrong = 0;
+        for (const auto& count : counter)
+            if (count != 1) n_wrong++;
+        ut.CompareInt(n_wrong, 0);
+    }
+
+    // Nothing is done for zero tasks.
+    std::atomic<int> n_calls(0);
+    L2A::UTIL::ParallelFor(0, [&](size_t) { n_calls++; });
+    ut.CompareInt(n_calls, 0);
+
+    // Exceptions are rethrown on the calling thread.
+    bool thrown = false;
+    try
+    {
+        L2A::UTIL::ParallelFor(
+            100,
+            [&](size_t i)
+            {
+                if (i == 42) throw std::runtime_error("task failed");
+            },
+            4);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    ut.CompareInt(thrown, 1);
+}
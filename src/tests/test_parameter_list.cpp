@@ -33,8 +33,14 @@
 
 #include "testing_utlity.h"
 
+#include "tinyxml2.h"
+
+#include "l2a_flat_parameter_list.h"
 #include "l2a_parameter_list.h"
 #include "l2a_string_functions.h"
+#include "l2a_xml_reader.h"
+
+#include <vector>
 
 
 /**
@@ -118,4 +124,104 @@ void L2A::TEST::TestParameterList(L2A::TEST::UTIL::UnitTest& ut)
     // Transform the list to a string and read it again.
     L2A::UTIL::ParameterList transformed_unicode_list(unicode_list.ToXMLString(ai::UnicodeString("root")));
     ut.CompareStr(test_string_unicode_value, transformed_unicode_list.GetStringOption(test_string_unicode_key));
+
+    // Read the list with the flat representation.
+    L2A::UTIL::FlatParameterList flat_list(first_list.ToXMLString(ai::UnicodeString("root")));
+    ut.CompareInt(first_list == flat_list.ToParameterList(), 1);
+    ut.CompareInt((int)flat_list.GetNumberOfSubList(), 2);
+    ut.CompareInt((int)flat_list.GetNumberOfOptions(), 6);
+    ut.CompareInt(flat_list.GetStringOption("key0") == "value0", 1);
+    ut.CompareInt(flat_list.GetIntOption("key2"), 2);
+    ut.CompareInt(flat_list.GetStringOption("key3") == L2A::TEST::UTIL::test_string_1_, 1);
+    ut.CompareInt(flat_list.OptionExists("subkey0"), 0);
+    ut.CompareInt(flat_list.SubListExists("sublist_key0"), 1);
+    ut.CompareInt(flat_list.SubListExists("key0"), 0);
+    const L2A::UTIL::FlatParameterList flat_sub_list = flat_list.GetSubList("sublist_key0");
+    ut.CompareInt(flat_sub_list.GetName() == "sublist_key0", 1);
+    ut.CompareInt(flat_sub_list.GetIntOption("subkey0"), 0);
+    ut.CompareInt(flat_sub_list.GetMainOption() == L2A::TEST::UTIL::test_string_3_, 1);
+    ut.CompareInt(flat_list.GetSubList("sublist_key1").GetStringOption("key0") == "newvalue", 1);
+    ut.CompareInt(flat_list.GetMainOptionSet(), 0);
+
+    // The sub list keeps the document alive after the list it was created from is deleted.
+    const L2A::UTIL::FlatParameterList flat_sub_list_1 =
+        L2A::UTIL::FlatParameterList(first_list.ToXMLString(ai::UnicodeString("root"))).GetSubList("sublist_key1");
+    ut.CompareInt(flat_sub_list_1.GetMainOption() == L2A::TEST::UTIL::test_string_4_, 1);
+
+    // Unicode strings are returned as UTF-8.
+    L2A::UTIL::FlatParameterList flat_unicode_list(unicode_list.ToXMLString(ai::UnicodeString("root")));
+    ut.CompareStr(L2A::UTIL::StringStdToAi(std::string(flat_unicode_list.GetStringOption("unicode_key"))),
+        test_string_unicode_value);
+
+    // The streamed XML string has to be the same as the one printed by tinyxml2.
+    const auto tinyxml2_print = [](const std::string& xml_string)
+    {
+        tinyxml2::XMLDocument xml_doc;
+        xml_doc.Parse(xml_string.c_str());
+        tinyxml2::XMLPrinter printer;
+        xml_doc.Accept(&printer);
+        return std::string(printer.CStr());
+    };
+    const std::string first_list_string = first_list.ToXMLStringUTF8(ai::UnicodeString("root"));
+    ut.CompareInt(first_list_string == tinyxml2_print(first_list_string), 1);
+    ut.CompareStr(L2A::UTIL::StringStdToAi(first_list_string), first_list.ToXMLString(ai::UnicodeString("root")));
+    const std::string unicode_list_string = unicode_list.ToXMLStringUTF8(ai::UnicodeString("root"));
+    ut.CompareInt(unicode_list_string == tinyxml2_print(unicode_list_string), 1);
+
+    L2A::UTIL::ParameterList escape_list;
+    escape_list.SetOption(ai::UnicodeString("b"), ai::UnicodeString("<a & \"b\" 'c'>"));
+    escape_list.SetOption(ai::UnicodeString("a"), ai::UnicodeString("0123456789abcdef0123456789abcdef&"));
+    escape_list.SetSubList(ai::UnicodeString("text"))->SetMainOption(ai::UnicodeString("<a & \"b\" 'c'>"));
+    escape_list.SetSubList(ai::UnicodeString("empty"))->SetSubList(ai::UnicodeString("child"));
+    const std::string escape_list_string = escape_list.ToXMLStringUTF8(ai::UnicodeString("root"));
+    ut.CompareInt(escape_list_string ==
+                      "<root a=\"0123456789abcdef0123456789abcdef&amp;\" "
+                      "b=\"&lt;a &amp; &quot;b&quot; &apos;c&apos;&gt;\">\n"
+                      "    <empty>\n"
+                      "        <child/>\n"
+                      "    </empty>\n"
+                      "    <text>&lt;a &amp; \"b\" 'c'&gt;</text>\n"
+                      "</root>\n",
+        1);
+    ut.CompareInt(escape_list_string == tinyxml2_print(escape_list_string), 1);
+    ut.CompareInt(L2A::UTIL::ParameterList(L2A::UTIL::StringStdToAi(escape_list_string)) == escape_list, 1);
+
+    // Read the lists with the pull parser.
+    const std::vector<std::pair<std::string, const L2A::UTIL::ParameterList*>> reader_cases = {
+        {first_list_string, &first_list}, {unicode_list_string, &unicode_list}, {escape_list_string, &escape_list}};
+    for (const auto& [xml_string, list] : reader_cases)
+    {
+        L2A::UTIL::XMLReader reader(xml_string);
+        ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::start_element, 1);
+        ut.CompareInt(L2A::UTIL::ParameterList(reader) == *list, 1);
+        ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::end_document, 1);
+    }
+
+    // Values without entities are views into the XML string, sub trees can be skipped.
+    const std::string reader_string = "<root a=\"value\" b=\"&lt;&#x41;&#66;\">\n    <skip><c>&amp;</c></skip>\n"
+                                      "    <text>line 1\r\nline 2</text>\n    <data>0123456789</data>\n</root>\n";
+    L2A::UTIL::XMLReader reader(reader_string);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::start_element, 1);
+    ut.CompareInt(reader.GetName() == "root", 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::attribute, 1);
+    ut.CompareInt(reader.GetName() == "a" && reader.GetValue() == "value", 1);
+    ut.CompareInt(reader.IsValueBorrowed() && reader.GetValue().data() == reader_string.data() + 9, 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::attribute, 1);
+    ut.CompareInt(reader.GetValue() == "<AB" && !reader.IsValueBorrowed(), 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::start_element, 1);
+    ut.CompareInt(reader.GetName() == "skip" && reader.GetDepth() == 2, 1);
+    reader.SkipElement();
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::start_element, 1);
+    ut.CompareInt(reader.GetName() == "text", 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::text, 1);
+    ut.CompareInt(reader.GetValue() == "line 1\nline 2", 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::end_element, 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::start_element, 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::text, 1);
+    ut.CompareInt(reader.IsValueBorrowed(), 1);
+    ut.CompareInt(reader.GetValue().data() == reader_string.data() + reader_string.find("0123456789"), 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::end_element, 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::end_element, 1);
+    ut.CompareInt(reader.GetDepth() == 0, 1);
+    ut.CompareInt(reader.Next() == L2A::UTIL::XMLReader::Event::end_document, 1);
 }
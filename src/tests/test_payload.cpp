@@ -0,0 +1,118 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Test the payload encodings.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_payload.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_lz4.h"
+#include "l2a_payload.h"
+
+#include <string>
+
+
+/**
+ *
+ */
+void L2A::TEST::TestPayload(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("Payload"));
+
+    // Base85 with trailing bytes.
+    std::string encoded;
+    L2A::UTIL::Base85Encode("LaTeX2AI", 8, encoded);
+    ut.CompareInt(encoded == "=TZt6BCJ39", 1);
+    encoded.clear();
+    L2A::UTIL::Base85Encode("\xff\xff\xff\xff\x00\x01", 6, encoded);
+    ut.CompareInt(encoded == "y;]0!!!-", 1);
+    std::string decoded;
+    ut.CompareInt(L2A::UTIL::Base85Decode(encoded.data(), encoded.size(), decoded), 1);
+    ut.CompareInt(decoded == std::string("\xff\xff\xff\xff\x00\x01", 6), 1);
+    ut.CompareInt(L2A::UTIL::Base85Decode("=TZt6\n BCJ39", 12, decoded), 1);
+    ut.CompareInt(decoded.substr(6) == "LaTeX2AI", 1);
+    ut.CompareInt(L2A::UTIL::Base85Decode("=TZt6B", 6, decoded), 0);
+    ut.CompareInt(L2A::UTIL::Base85Decode("=TZ&6", 5, decoded), 0);
+    ut.CompareInt(L2A::UTIL::Base85Decode("{{{{{", 5, decoded), 0);
+
+    // LZ4 block, this is the output of the reference implementation.
+    std::string text;
+    for (unsigned int i = 0; i < 8; i++) text += "LaTeX2AI item ";
+    const std::string reference_block(
+        "\xef\x4c\x61\x54\x65\x58\x32\x41\x49\x20\x69\x74\x65\x6d\x20\x0e\x00\x4a\x50\x69\x74\x65\x6d\x20", 24);
+    std::string compressed;
+    L2A::UTIL::CompressLZ4(text.data(), text.size(), compressed);
+    ut.CompareInt(compressed == reference_block, 1);
+    decoded.clear();
+    ut.CompareInt(L2A::UTIL::DecompressLZ4(compressed.data(), compressed.size(), text.size(), decoded), 1);
+    ut.CompareInt(decoded == text, 1);
+    ut.CompareInt(L2A::UTIL::DecompressLZ4(compressed.data(), compressed.size(), text.size() + 1, decoded), 0);
+    ut.CompareInt(L2A::UTIL::DecompressLZ4(compressed.data(), compressed.size() - 1, text.size(), decoded), 0);
+    ut.CompareInt(decoded == text, 1);
+
+    // Payloads in both encodings, the compact one is compressed if this reduces the size.
+    std::string data;
+    unsigned int state = 1;
+    for (unsigned int i = 0; i < 10000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        data.push_back(i < 5000 ? text[i % text.size()] : (char)(state >> 16));
+    }
+    for (const auto& payload : {data, data.substr(5000), std::string()})
+    {
+        for (const auto encoding : {L2A::UTIL::PayloadEncoding::base64, L2A::UTIL::PayloadEncoding::compact})
+        {
+            const std::string encoded_payload = L2A::UTIL::EncodePayload(encoding, payload.data(), payload.size());
+            ut.CompareInt(encoded_payload.find_first_of("&<>\"'") == std::string::npos, 1);
+            decoded.clear();
+            ut.CompareInt(
+                L2A::UTIL::DecodePayload(encoding, encoded_payload.data(), encoded_payload.size(), decoded), 1);
+            ut.CompareInt(decoded == payload, 1);
+        }
+    }
+    const std::string compact = L2A::UTIL::EncodePayload(L2A::UTIL::PayloadEncoding::compact, data.data(), data.size());
+    ut.CompareInt(compact.size() < L2A::UTIL::Base85EncodedLength(data.size()), 1);
+    const std::string random = data.substr(5000);
+    const std::string stored =
+        L2A::UTIL::EncodePayload(L2A::UTIL::PayloadEncoding::compact, random.data(), random.size());
+    ut.CompareInt(stored.size() == L2A::UTIL::Base85EncodedLength(random.size() + 16), 1);
+
+    // Corrupted payloads are rejected.
+    std::string corrupted = compact;
+    corrupted[2] = corrupted[2] == '!' ? '#' : '!';
+    ut.CompareInt(L2A::UTIL::DecodePayload(
+                      L2A::UTIL::PayloadEncoding::compact, corrupted.data(), corrupted.size(), decoded),
+        0);
+    ut.CompareInt(L2A::UTIL::DecodePayload(
+                      L2A::UTIL::PayloadEncoding::compact, compact.data(), compact.size() - 10, decoded),
+        0);
+}
@@ -0,0 +1,181 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Test the native reader for pdf metadata.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_pdf_info.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_inflate.h"
+#include "l2a_pdf_info.h"
+
+#include <cstdio>
+
+
+namespace
+{
+    /**
+     * \brief Create a pdf file with a cross reference table.
+     */
+    std::string CreatePdfWithXRefTable(const std::vector<std::string>& objects, const std::string& trailer)
+    {
+        std::string pdf = "%PDF-1.5\n";
+        std::vector<size_t> offsets;
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            offsets.push_back(pdf.size());
+            pdf += std::to_string(i + 1) + " 0 obj\n" + objects[i] + "\nendobj\n";
+        }
+        const size_t xref_offset = pdf.size();
+        pdf += "xref\n0 " + std::to_string(objects.size() + 1) + "\n0000000000 65535 f \n";
+        for (const auto offset : offsets)
+        {
+            char entry[21];
+            std::snprintf(entry, sizeof(entry), "%010zu 00000 n \n", offset);
+            pdf += entry;
+        }
+        pdf += "trailer\n<< /Size " + std::to_string(objects.size() + 1) + " /Root 1 0 R " + trailer +
+               " >>\nstartxref\n" + std::to_string(xref_offset) + "\n%%EOF\n";
+        return pdf;
+    }
+
+    /**
+     * \brief Create a pdf file with a cross reference stream, the page tree is in a compressed object stream.
+     */
+    std::string CreatePdfWithObjectStream()
+    {
+        // Objects 2 and 3 compressed with zlib (the page tree and a page with the media box [0 0 7 8]).
+        const std::string object_stream(
+            "\x78\xda\x33\x52\x30\x50\x30\x56\x30\x31\x52\xb0\xb1\x51\xd0\x0f\xa9\x2c\x48\x55\xd0\x0f\x48\x4c\x4f\x2d"
+            "\x56\xd0\xf7\xce\x4c\x29\x56\x88\x36\x06\xca\x07\xc5\x2a\xe8\x3b\xe7\x97\xe6\x95\x28\x18\x2a\xd8\xd9\xa1"
+            "\xa9\x04\x91\x45\xa9\x40\x39\x23\x90\x4a\x05\x7d\xdf\xd4\x94\xcc\x44\xa7\xfc\x0a\x85\x68\x03\xa0\x80\xb9"
+            "\x82\x45\x2c\x50\x0f\x00\x65\xa5\x1b\x2d",
+            88);
+
+        std::string pdf = "%PDF-1.5\n";
+        const size_t catalog_offset = pdf.size();
+        pdf += "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+        const size_t object_stream_offset = pdf.size();
+        pdf += "4 0 obj\n<< /Type /ObjStm /N 2 /First 9 /Filter /FlateDecode /Length 88 >>\nstream\n" +
+               object_stream + "\nendstream\nendobj\n";
+        const size_t xref_offset = pdf.size();
+
+        // Entries with a type byte, two bytes for the offset or the object stream and one byte for the index.
+        std::string entries;
+        const auto add_entry = [&entries](const int type, const size_t offset, const int index)
+        {
+            entries.push_back((char)type);
+            entries.push_back((char)(offset >> 8));
+            entries.push_back((char)(offset & 0xFF));
+            entries.push_back((char)index);
+        };
+        add_entry(0, 0, 0);
+        add_entry(1, catalog_offset, 0);
+        add_entry(2, 4, 0);
+        add_entry(2, 4, 1);
+        add_entry(1, object_stream_offset, 0);
+        add_entry(1, xref_offset, 0);
+        pdf += "5 0 obj\n<< /Type /XRef /Size 6 /W [1 2 1] /Root 1 0 R /Length 24 >>\nstream\n" + entries +
+               "\nendstream\nendobj\nstartxref\n" + std::to_string(xref_offset) + "\n%%EOF\n";
+        return pdf;
+    }
+
+    /**
+     * \brief Check if a box has the given coordinates.
+     */
+    bool CompareBox(const L2A::UTIL::PdfBox& box, const double left, const double bottom, const double right,
+        const double top)
+    {
+        return box.left_ == left && box.bottom_ == bottom && box.right_ == right && box.top_ == top;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+void L2A::TEST::TestPdfInfo(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("PdfInfo"));
+
+    // Zlib stream, this is the output of the reference implementation.
+    std::string text;
+    for (unsigned int i = 0; i < 8; i++) text += "LaTeX2AI item ";
+    const std::string compressed(
+        "\x78\xda\xf3\x49\x0c\x49\x8d\x30\x72\xf4\x54\xc8\x2c\x49\xcd\x55\xf0\xa1\x39\x0f\x00\xcc\x79\x23\x49", 25);
+    std::string decompressed;
+    ut.CompareInt(L2A::UTIL::DecompressZlib(compressed.data(), compressed.size(), decompressed), 1);
+    ut.CompareInt(decompressed == text, 1);
+    decompressed.clear();
+    ut.CompareInt(L2A::UTIL::DecompressZlib(compressed.data(), compressed.size() - 8, decompressed), 0);
+    ut.CompareInt(L2A::UTIL::DecompressZlib(compressed.data() + 2, compressed.size() - 2, decompressed), 0);
+
+    // Boxes are inherited in the page tree, the crop box defaults to the media box and the corners are normalized.
+    const std::vector<std::string> objects = {"<< /Type /Catalog /Pages 2 0 R >>",
+        "<< /Type /Pages /Kids [3 0 R 4 0 R] /Count 3 /MediaBox [0 0 100 50] >>",
+        "<< /Type /Page /Parent 2 0 R /CropBox [90 40 10 5] >>",
+        "<< /Type /Pages /Parent 2 0 R /Kids [5 0 R 6 0 R] /Count 2 >>", "<< /Type /Page /Parent 4 0 R >>",
+        "<< /Type /Page /Parent 4 0 R /MediaBox [-1.5 .25 3 4.] >>",
+        "<< /Producer <FEFF004C0061005400650058003200410049002000E4> >>"};
+    const std::string pdf = CreatePdfWithXRefTable(objects, "/Info 7 0 R");
+    L2A::UTIL::PdfInfo info;
+    size_t n_pages = 0;
+    ut.CompareInt(L2A::UTIL::ReadPdfInfo(pdf, info), 1);
+    ut.CompareInt((int)info.pages_.size(), 3);
+    ut.CompareInt(CompareBox(info.pages_[0].media_box_, 0, 0, 100, 50), 1);
+    ut.CompareInt(CompareBox(info.pages_[0].crop_box_, 10, 5, 90, 40), 1);
+    ut.CompareInt(CompareBox(info.pages_[1].crop_box_, 0, 0, 100, 50), 1);
+    ut.CompareInt(CompareBox(info.pages_[2].media_box_, -1.5, 0.25, 3, 4), 1);
+    ut.CompareInt(info.producer_ == "LaTeX2AI \xc3\xa4", 1);
+    ut.CompareInt(L2A::UTIL::ReadPdfPageCount(pdf, n_pages), 1);
+    ut.CompareInt((int)n_pages, 3);
+
+    // Cross reference stream and compressed objects.
+    const std::string pdf_object_stream = CreatePdfWithObjectStream();
+    ut.CompareInt(L2A::UTIL::ReadPdfInfo(pdf_object_stream, info), 1);
+    ut.CompareInt((int)info.pages_.size(), 1);
+    ut.CompareInt(CompareBox(info.pages_[0].crop_box_, 0, 0, 7, 8), 1);
+    ut.CompareInt(info.producer_.empty(), 1);
+    ut.CompareInt(L2A::UTIL::ReadPdfPageCount(pdf_object_stream, n_pages), 1);
+    ut.CompareInt((int)n_pages, 1);
+
+    // Invalid files and loops in the page tree.
+    ut.CompareInt(L2A::UTIL::ReadPdfInfo(pdf.substr(0, pdf.size() - 10), info), 0);
+    ut.CompareInt(L2A::UTIL::ReadPdfPageCount(pdf_object_stream.substr(0, pdf_object_stream.size() / 2), n_pages), 0);
+    ut.CompareInt(L2A::UTIL::ReadPdfInfo(std::string(100, 'a'), info), 0);
+    const std::string pdf_loop = CreatePdfWithXRefTable(
+        {"<< /Type /Catalog /Pages 2 0 R >>", "<< /Type /Pages /Kids [3 0 R] /Count 1 >>",
+            "<< /Type /Pages /Parent 2 0 R /Kids [2 0 R] /Count 1 >>"},
+        "");
+    ut.CompareInt(L2A::UTIL::ReadPdfInfo(pdf_loop, info), 0);
+}
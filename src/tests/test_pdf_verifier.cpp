@@ -0,0 +1,160 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Test the verification of pdf files.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_pdf_verifier.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_file_system.h"
+#include "l2a_hash.h"
+#include "l2a_pdf_verifier.h"
+#include "l2a_string_functions.h"
+
+#include <cstdio>
+#include <fstream>
+
+
+namespace
+{
+    /**
+     * \brief Create a pdf file with a cross reference table.
+     */
+    std::string CreatePdfWithXRefTable()
+    {
+        const std::vector<std::string> objects = {"<< /Type /Catalog /Pages 2 0 R >>",
+            "<< /Type /Pages /Kids [3 0 R] /Count 1 >>",
+            "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 20 10] >>"};
+        std::string pdf = "%PDF-1.5\n";
+        std::vector<size_t> offsets;
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            offsets.push_back(pdf.size());
+            pdf += std::to_string(i + 1) + " 0 obj\n" + objects[i] + "\nendobj\n";
+        }
+        const size_t xref_offset = pdf.size();
+        pdf += "xref\n0 4\n0000000000 65535 f \n";
+        for (const auto offset : offsets)
+        {
+            char entry[21];
+            std::snprintf(entry, sizeof(entry), "%010zu 00000 n \n", offset);
+            pdf += entry;
+        }
+        pdf += "trailer\n<< /Size 4 /Root 1 0 R >>\nstartxref\n" + std::to_string(xref_offset) + "\n%%EOF\n";
+        return pdf;
+    }
+
+    /**
+     * \brief Create a pdf file with a cross reference stream.
+     */
+    std::string CreatePdfWithXRefStream()
+    {
+        std::string pdf = "%PDF-1.5\n1 0 obj\n<< /Type /Catalog >>\nendobj\n";
+        const size_t xref_offset = pdf.size();
+        pdf += "2 0 obj\n<< /Type /XRef /Size 3 /Root 1 0 R /Length 0 >>\nstream\n\nendstream\nendobj\nstartxref\n" +
+               std::to_string(xref_offset) + "\n%%EOF\n";
+        return pdf;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+void L2A::TEST::TestPdfVerifier(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("PdfVerifier"));
+
+    // Valid pdf files.
+    const std::string pdf = CreatePdfWithXRefTable();
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(pdf), 1);
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(CreatePdfWithXRefStream()), 1);
+
+    // Truncated files and wrong offsets of the cross reference table or the objects are detected.
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(pdf.substr(0, pdf.size() - 10)), 0);
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(pdf.substr(0, pdf.size() / 2)), 0);
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(pdf.substr(1)), 0);
+    std::string wrong_xref_offset = pdf;
+    wrong_xref_offset.insert(wrong_xref_offset.find("startxref\n") + 10, "1");
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(wrong_xref_offset), 0);
+    std::string wrong_object_offset = pdf;
+    char entry[11];
+    std::snprintf(entry, sizeof(entry), "%010zu", pdf.find("2 0 obj"));
+    wrong_object_offset.replace(wrong_object_offset.find(entry), 10, std::string(entry).replace(9, 1, "9"));
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(wrong_object_offset), 0);
+    ut.CompareInt(L2A::UTIL::IsPdfStructureValid(std::string(100, 'a')), 0);
+
+    // Write a valid and a truncated linked file.
+    const auto temp_directory = L2A::UTIL::ClearTemporaryDirectory();
+    const auto get_path = [&temp_directory](const std::string& name)
+    {
+        ai::FilePath path = temp_directory;
+        path.AddComponent(L2A::UTIL::StringStdToAi(name));
+        return L2A::UTIL::FilePathAiToStd(path);
+    };
+    const std::string hash = L2A::UTIL::XXH3HashString(pdf.data(), pdf.size());
+    std::ofstream(get_path("valid.pdf"), std::ofstream::binary) << pdf;
+    std::ofstream(get_path("truncated.pdf"), std::ofstream::binary) << pdf.substr(0, pdf.size() - 10);
+
+    // Create the tasks, the last two tasks share the same linked file.
+    const auto encoding = L2A::UTIL::PayloadEncoding::compact;
+    const auto payload =
+        L2A::UTIL::SharedString(L2A::UTIL::EncodePayload(encoding, pdf.data(), pdf.size()));
+    const std::string other_pdf = CreatePdfWithXRefStream();
+    const auto other_payload =
+        L2A::UTIL::SharedString(L2A::UTIL::EncodePayload(encoding, other_pdf.data(), other_pdf.size()));
+    std::vector<L2A::UTIL::PdfVerificationTask> tasks = {{payload, encoding, hash, get_path("valid.pdf")},
+        {other_payload, encoding, hash, get_path("missing.pdf")},
+        {L2A::UTIL::SharedString(), encoding, hash, get_path("truncated.pdf")},
+        {payload, encoding, hash, get_path("truncated.pdf")}};
+
+    // Verify the files.
+    L2A::UTIL::PdfVerifier verifier(tasks, 60.0, 2);
+    const auto& results = verifier.GetResults();
+    ut.CompareInt(verifier.IsFinished(), 1);
+    ut.CompareInt(results[0].payload_state_ == L2A::UTIL::PdfFileState::valid, 1);
+    ut.CompareInt(results[0].link_file_state_ == L2A::UTIL::PdfFileState::valid, 1);
+    ut.CompareInt(results[1].payload_state_ == L2A::UTIL::PdfFileState::corrupt, 1);
+    ut.CompareInt(results[1].link_file_state_ == L2A::UTIL::PdfFileState::missing, 1);
+    ut.CompareInt(results[2].payload_state_ == L2A::UTIL::PdfFileState::missing, 1);
+    ut.CompareInt(results[2].link_file_state_ == L2A::UTIL::PdfFileState::corrupt, 1);
+    ut.CompareInt(results[3].payload_state_ == L2A::UTIL::PdfFileState::valid, 1);
+    ut.CompareInt(results[3].link_file_state_ == L2A::UTIL::PdfFileState::corrupt, 1);
+
+    // No checks are performed if the time budget is exceeded.
+    L2A::UTIL::PdfVerifier verifier_no_time(tasks, -1.0);
+    bool all_unchecked = true;
+    for (const auto& result : verifier_no_time.GetResults())
+        all_unchecked = all_unchecked && result.payload_state_ == L2A::UTIL::PdfFileState::unchecked &&
+                        result.link_file_state_ == L2A::UTIL::PdfFileState::unchecked;
+    ut.CompareInt(all_unchecked, 1);
+}
@@ -0,0 +1,198 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the property class.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_property.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_constants.h"
+#include "l2a_hash.h"
+#include "l2a_parameter_list.h"
+#include "l2a_payload.h"
+#include "l2a_property.h"
+#include "l2a_shared_string.h"
+#include "l2a_string_functions.h"
+#include "l2a_version.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestProperty(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("Property"));
+
+    // Create a property with a dummy pdf file.
+    const ai::UnicodeString pdf_contents(
+        "JVBERi0xLjUKJcfsj6IKNSAwIG9iago8PC9MZW5ndGggNiAwIFIvRmlsdGVyIC9GbGF0ZURlY29kZT4+");
+    L2A::Property property;
+    property.latex_code_ = L2A::UTIL::StringStdToAi(L2A::TEST::UTIL::test_string_1_);
+    property.text_align_vertical_ = L2A::TextAlignVertical::baseline;
+    property.pdf_file_encoded_ = L2A::UTIL::SharedString(L2A::UTIL::StringAiToStd(pdf_contents));
+    property.pdf_file_encoding_ = L2A::UTIL::PayloadEncoding::base64;
+    property.pdf_file_hash_ =
+        L2A::UTIL::XXH3HashBase64(property.pdf_file_encoded_.data(), property.pdf_file_encoded_.size());
+    property.pdf_file_hash_method_ = L2A::HashMethod::xxh3;
+    const ai::UnicodeString property_string = property.ToString(true);
+    const auto contents_equal = [&](const L2A::UTIL::SharedString& contents)
+    { return contents.View() == L2A::UTIL::StringAiToStd(pdf_contents); };
+
+    // The property is written with the schema, this has to give the same string as the full xml tree.
+    ut.CompareStr(property_string, property.ToParameterList(true).ToXMLString(ai::UnicodeString("LaTeX2AI_item")));
+    ut.CompareStr(
+        property.ToString(false), property.ToParameterList(false).ToXMLString(ai::UnicodeString("LaTeX2AI_item")));
+
+    // The enum names are converted with compile-time maps.
+    ut.CompareInt(L2A::TextAlignVerticalStrings().ToEnum("centreV") == L2A::TextAlignVertical::centre, 1);
+    ut.CompareInt(L2A::TextAlignHorizontalStrings().ToString(L2A::TextAlignHorizontal::centre) == "centreH", 1);
+    L2A::HashMethod hash_method = L2A::HashMethod::none;
+    ut.CompareInt(L2A::HashMethodStrings().TryToEnum("crc32", hash_method), 0);
+    ut.CompareInt(hash_method == L2A::HashMethod::none, 1);
+
+    // Strings with unknown or missing keys do not fit the schema, they are read with the generic parameter list.
+    L2A::UTIL::ParameterList unknown_parameter_list = property.ToParameterList(true);
+    unknown_parameter_list.SetOption(ai::UnicodeString("unknown_option"), ai::UnicodeString("value"));
+    unknown_parameter_list.SetSubList(ai::UnicodeString("unknown_list"))
+        ->SetMainOption(ai::UnicodeString("<unknown>"));
+    L2A::Property unknown_property;
+    unknown_property.SetFromString(unknown_parameter_list.ToXMLString(ai::UnicodeString("LaTeX2AI_item")));
+    ut.CompareInt(unknown_property.Compare(property).Changed(), 0);
+    ut.CompareInt(unknown_property.GetVersion() == L2A::UTIL::ParseVersion(L2A_VERSION_STRING_), 1);
+    ut.CompareInt(contents_equal(unknown_property.GetPDFFileContents()), 1);
+    ut.CompareStr(unknown_property.ToString(true), property_string);
+    L2A::Property legacy_property;
+    legacy_property.SetFromString(ai::UnicodeString("<LaTeX2AI_item text_align_horizontal=\"left\" "
+                                                    "text_align_vertical=\"top\"><latex cursor_position=\"3\">"
+                                                    "$x &amp; y$</latex></LaTeX2AI_item>"));
+    ut.CompareInt(legacy_property.GetVersion() == L2A::UTIL::ParseVersion("0.0.0"), 1);
+    ut.CompareInt(legacy_property.text_align_horizontal_ == L2A::TextAlignHorizontal::left, 1);
+    ut.CompareInt(legacy_property.cursor_position_, 3);
+    ut.CompareStr(legacy_property.GetLaTeXCode(), ai::UnicodeString("$x & y$"));
+
+    // Only the meta data is parsed when the property is read from a string.
+    L2A::Property lazy_property;
+    lazy_property.SetFromString(property_string);
+    ut.CompareInt(lazy_property.Compare(property).Changed(), 0);
+    ut.CompareInt(lazy_property.pdf_file_parsed_, 0);
+    ut.CompareInt(lazy_property.GetPDFFileHash() == property.pdf_file_hash_, 1);
+    ut.CompareInt(lazy_property.pdf_file_parsed_, 0);
+
+    // Accessing the pdf file does not copy it out of the string.
+    ut.CompareInt(contents_equal(lazy_property.GetPDFFileContents()), 1);
+    ut.CompareInt(lazy_property.pdf_file_parsed_, 1);
+    ut.CompareInt(lazy_property.GetPDFFileContents().IsPartOfSource(), 1);
+    ut.CompareStr(lazy_property.ToString(true), property_string);
+
+    // A property that is written again without being accessed has to contain the same pdf file.
+    L2A::Property lazy_property_copy;
+    lazy_property_copy.SetFromString(property_string);
+    ut.CompareStr(L2A::Property(lazy_property_copy).ToString(true), property_string);
+
+    // Properties created with an old hash method get the new hash, once the hash is requested.
+    L2A::UTIL::ParameterList old_parameter_list = property.ToParameterList(false);
+    std::shared_ptr<L2A::UTIL::ParameterList> pdf_sub_list =
+        old_parameter_list.SetSubList(ai::UnicodeString("pdf_file_contents"));
+    pdf_sub_list->SetMainOption(pdf_contents);
+    pdf_sub_list->SetOption(ai::UnicodeString("hash"), ai::UnicodeString("old_hash"));
+    L2A::Property old_property;
+    old_property.SetFromString(old_parameter_list.ToXMLString(ai::UnicodeString("LaTeX2AI_item")));
+    ut.CompareInt(old_property.pdf_file_parsed_, 0);
+    ut.CompareInt(old_property.GetPDFFileHash() == property.pdf_file_hash_, 1);
+    ut.CompareInt(contents_equal(old_property.GetPDFFileContents()), 1);
+
+    // The same is done for properties with a crc64 hash of the encoded pdf file.
+    pdf_sub_list->SetOption(ai::UnicodeString("hash"), L2A::UTIL::StringHash(pdf_contents));
+    pdf_sub_list->SetOption(ai::UnicodeString("hash_method"), ai::UnicodeString("crc64"));
+    L2A::Property crc64_property;
+    crc64_property.SetFromString(old_parameter_list.ToXMLString(ai::UnicodeString("LaTeX2AI_item")));
+    ut.CompareInt(crc64_property.pdf_file_hash_method_ == L2A::HashMethod::crc64, 1);
+    ut.CompareInt(crc64_property.GetPDFFileHash() == property.pdf_file_hash_, 1);
+    ut.CompareInt(crc64_property.pdf_file_hash_method_ == L2A::HashMethod::xxh3, 1);
+
+    // New pdf files are stored in the compact encoding, notes without an encoding are base64.
+    ut.CompareInt(old_property.GetPDFFileEncoding() == L2A::UTIL::PayloadEncoding::base64, 1);
+    const std::string pdf_contents_std = L2A::UTIL::StringAiToStd(pdf_contents);
+    std::string pdf_data;
+    L2A::UTIL::DecodePayload(
+        L2A::UTIL::PayloadEncoding::base64, pdf_contents_std.data(), pdf_contents_std.size(), pdf_data);
+    L2A::Property compact_property = property;
+    compact_property.pdf_file_encoding_ = L2A::UTIL::PayloadEncoding::compact;
+    compact_property.pdf_file_encoded_ = L2A::UTIL::SharedString(
+        L2A::UTIL::EncodePayload(L2A::UTIL::PayloadEncoding::compact, pdf_data.data(), pdf_data.size()));
+    const ai::UnicodeString compact_string = compact_property.ToString(true);
+    L2A::Property compact_from_string;
+    compact_from_string.SetFromString(compact_string);
+    ut.CompareInt(compact_from_string.GetPDFFileEncoding() == L2A::UTIL::PayloadEncoding::compact, 1);
+    ut.CompareInt(compact_from_string.GetPDFFileContents().IsPartOfSource(), 1);
+    ut.CompareInt(compact_from_string.GetPDFFileHash() == property.pdf_file_hash_, 1);
+    ut.CompareStr(compact_from_string.ToString(true), compact_string);
+    ut.CompareInt(L2A::Property().GetPDFFileEncoding() == L2A::UTIL::PayloadEncoding::compact, 1);
+
+    // Properties without a pdf file are parsed directly.
+    L2A::Property no_pdf_property;
+    no_pdf_property.SetFromString(property.ToString(false));
+    ut.CompareInt(no_pdf_property.pdf_file_parsed_, 1);
+    ut.CompareInt(no_pdf_property.GetPDFFileHash().empty(), 1);
+
+    // Parameter lists from the item form do not contain the pdf file, editing an item keeps its pdf file.
+    L2A::Property edited_property;
+    edited_property.SetFromString(property_string);
+    L2A::UTIL::ParameterList form_parameter_list = property.ToParameterList(false);
+    form_parameter_list.SetOption(ai::UnicodeString("text_align_horizontal"), ai::UnicodeString("left"));
+    edited_property.SetFromParameterList(form_parameter_list);
+    ut.CompareInt(edited_property.text_align_horizontal_ == L2A::TextAlignHorizontal::left, 1);
+    ut.CompareInt(edited_property.GetPDFFileHash() == property.pdf_file_hash_, 1);
+    ut.CompareInt(contents_equal(edited_property.GetPDFFileContents()), 1);
+    edited_property.text_align_horizontal_ = property.text_align_horizontal_;
+    ut.CompareStr(edited_property.ToString(true), property_string);
+
+    // Count the copies of the pdf file when it is written to and read from a string.
+    L2A::UTIL::SharedString::ResetNumberOfCopies();
+    const ai::UnicodeString counted_string = property.ToString(true);
+    ut.CompareInt((int)L2A::UTIL::SharedString::GetNumberOfCopies(), 2);
+    L2A::UTIL::SharedString::ResetNumberOfCopies();
+    L2A::Property counted_property;
+    counted_property.SetFromString(counted_string);
+    ut.CompareInt(contents_equal(counted_property.GetPDFFileContents()), 1);
+    ut.CompareInt((int)L2A::UTIL::SharedString::GetNumberOfCopies(), 1);
+
+    // Copies of the property share the pdf file.
+    L2A::UTIL::SharedString::ResetNumberOfCopies();
+    L2A::Property property_copy = counted_property;
+    ut.CompareInt(property_copy.GetPDFFileContents().data() == counted_property.GetPDFFileContents().data(), 1);
+    ut.CompareInt((int)L2A::UTIL::SharedString::GetNumberOfCopies(), 0);
+
+    // Changing the pdf file of a copy does not change the shared data.
+    property_copy.SetFromString(property.ToString(false));
+    ut.CompareInt(property_copy.GetPDFFileContents().empty(), 1);
+    ut.CompareInt(contents_equal(counted_property.GetPDFFileContents()), 1);
+}
@@ -0,0 +1,136 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the spatial index.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_spatial_index.h"
+
+#include "testing_utlity.h"
+
+#include "l2a_annotator.h"
+#include "l2a_spatial_index.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestSpatialIndex(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("SpatialIndex"));
+
+    // Create synthetic item bounds on a regular grid with some overlap between the cells.
+    const auto create_rect = [](const AIReal left, const AIReal bottom, const AIReal width, const AIReal height)
+    {
+        AIRealRect rect;
+        rect.left = left;
+        rect.right = left + width;
+        rect.bottom = bottom;
+        rect.top = bottom + height;
+        return rect;
+    };
+    std::map<int, AIRealRect> all_bounds;
+    L2A::UTIL::SpatialIndex<int> index(50.0);
+    for (int i = 0; i < 20; i++)
+    {
+        for (int j = 0; j < 20; j++)
+        {
+            const int key = 20 * i + j;
+            all_bounds[key] = create_rect(-500.0 + 37.0 * i, -300.0 + 23.0 * j, 10.0 + (key % 7) * 11.0, 15.0);
+            index.Insert(key, all_bounds[key]);
+        }
+    }
+    ut.CompareInt((int)index.Size(), 400);
+
+    // Move and remove some items.
+    for (int key = 0; key < 400; key += 13)
+    {
+        all_bounds[key] = create_rect(-1000.0 + key, 1000.0 - key, 80.0, 40.0);
+        index.Insert(key, all_bounds[key]);
+    }
+    for (int key = 5; key < 400; key += 17)
+    {
+        all_bounds.erase(key);
+        ut.CompareInt(index.Remove(key), 1);
+    }
+    ut.CompareInt(index.Remove(5), 0);
+    ut.CompareInt((int)index.Size(), (int)all_bounds.size());
+    ut.CompareInt(index.Contains(5), 0);
+    ut.CompareInt(index.Contains(6), 1);
+
+    // Compare the query results with the brute force results.
+    const std::vector<AIRealRect> query_rects = {create_rect(-400.0, -200.0, 100.0, 100.0),
+        create_rect(0.0, 0.0, 1.0, 1.0), create_rect(-2000.0, -2000.0, 4000.0, 4000.0),
+        create_rect(100.0, 100.0, 0.0, 0.0), create_rect(5000.0, 5000.0, 10.0, 10.0),
+        create_rect(-900.0, 600.0, 300.0, 300.0)};
+    for (const auto& query_rect : query_rects)
+    {
+        std::vector<int> brute_force;
+        for (const auto& [key, bounds] : all_bounds)
+            if (L2A::UTIL::RectsIntersect(bounds, query_rect)) brute_force.push_back(key);
+        std::vector<int> query = index.Query(query_rect);
+        ut.CompareInt((int)query.size(), (int)brute_force.size());
+        ut.CompareInt(query == brute_force, 1);
+
+        // The orientation of the vertical axis in the query rectangle does not matter.
+        AIRealRect flipped_rect = query_rect;
+        std::swap(flipped_rect.top, flipped_rect.bottom);
+        ut.CompareInt(index.Query(flipped_rect) == brute_force, 1);
+    }
+
+    // Union of rectangles.
+    AIRealRect union_rect = create_rect(0.0, 0.0, 10.0, 10.0);
+    L2A::UTIL::RectUnion(union_rect, create_rect(-5.0, 5.0, 10.0, 20.0));
+    ut.CompareRect(union_rect, create_rect(-5.0, 0.0, 15.0, 25.0));
+
+    // The annotator redraws an item if its state changed. Hiding or locking an item, or one of its parents, does
+    // not change the geometry of the item, but it changes how the item is drawn.
+    L2A::AnnotatorItemState state;
+    sAIRealMath->AIRealMatrixSetTranslate(&state.matrix_, 10.0, 20.0);
+    state.bounds_ = create_rect(10.0, 20.0, 30.0, 15.0);
+    state.alignment_ = PlaceAlignment::kMidMid;
+    state.pdf_path_ = ai::UnicodeString("LaTeX2AI_000000000000000a.pdf");
+    state.is_hidden_ = false;
+    state.is_locked_ = false;
+    L2A::AnnotatorItemState changed_state = state;
+    ut.CompareInt(changed_state == state, 1);
+    changed_state.is_hidden_ = true;
+    ut.CompareInt(changed_state == state, 0);
+    changed_state = state;
+    changed_state.is_locked_ = true;
+    ut.CompareInt(changed_state == state, 0);
+    changed_state = state;
+    changed_state.bounds_.left += 1.0;
+    ut.CompareInt(changed_state == state, 0);
+
+    // Clear the index.
+    index.Clear();
+    ut.CompareInt((int)index.Size(), 0);
+    ut.CompareInt((int)index.Query(query_rects[2]).size(), 0);
+}
@@ -31,15 +31,34 @@
 
 #include "testing.h"
 
+#include "benchmark_base64.h"
+#include "benchmark_hash.h"
+#include "benchmark_latex.h"
+#include "benchmark_parameter_list.h"
+#include "benchmark_property.h"
+#include "benchmark_utility.h"
 #include "test_base64.h"
+#include "test_compile_cache.h"
 #include "test_file_system.h"
 #include "test_framework.h"
+#include "test_hash.h"
+#include "test_hidden_locked.h"
+#include "test_item_registry.h"
 #include "test_latex.h"
+#include "test_links.h"
+#include "test_parallel.h"
 #include "test_parameter_list.h"
+#include "test_payload.h"
+#include "test_pdf_info.h"
+#include "test_pdf_verifier.h"
+#include "test_property.h"
+#include "test_spatial_index.h"
 #include "test_string_functions.h"
 #include "test_utlity.h"
 #include "testing_utlity.h"
 
+#include "l2a_global.h"
+
 
 /**
  *
@@ -51,6 +70,17 @@ void L2A::TEST::TestingMain(const bool print_status)
 
     // Call the individual testing functions.
     L2A::TEST::TestParameterList(ut);
+    L2A::TEST::TestProperty(ut);
+    L2A::TEST::TestSpatialIndex(ut);
+    L2A::TEST::TestHiddenLocked(ut);
+    L2A::TEST::TestItemRegistry(ut);
+    L2A::TEST::TestLinks(ut);
+    L2A::TEST::TestCompileCache(ut);
+    L2A::TEST::TestParallel(ut);
+    L2A::TEST::TestHash(ut);
+    L2A::TEST::TestPayload(ut);
+    L2A::TEST::TestPdfVerifier(ut);
+    L2A::TEST::TestPdfInfo(ut);
     L2A::TEST::TestStringFunctions(ut);
     L2A::TEST::TestFileSystem(ut);
     L2A::TEST::TestUtilityFunctions(ut);
@@ -76,3 +106,35 @@ void L2A::TEST::TestFramework(const bool print_status)
     // Print the testing summary. For now this is deactivated.
     ut.PrintTestSummary(print_status);
 }
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkMain(const bool print_status)
+{
+    // Create the benchmark object.
+    L2A::TEST::UTIL::Benchmark bm;
+
+    // Set the global testing flag, this will prevent unwanted message windows to pop up.
+    L2A::GlobalMutable().is_testing_ = true;
+
+    try
+    {
+        // Call the individual benchmark functions.
+        L2A::TEST::BenchmarkBase64(bm);
+        L2A::TEST::BenchmarkHash(bm);
+        L2A::TEST::BenchmarkLatex(bm);
+        L2A::TEST::BenchmarkParameterList(bm);
+        L2A::TEST::BenchmarkProperty(bm);
+    }
+    catch (...)
+    {
+        sAIUser->MessageAlert(ai::UnicodeString("Error in benchmarks!"));
+    }
+
+    // Deactivate the global testing mode.
+    L2A::GlobalMutable().is_testing_ = false;
+
+    // Write the benchmark results.
+    bm.PrintBenchmarkSummary(print_status);
+}
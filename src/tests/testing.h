@@ -43,6 +43,11 @@ namespace L2A
          * \brief Test the functionality of the complete LaTeX2AI toolbox.
          */
         void TestFramework(const bool print_status = true);
+
+        /**
+         * \brief This function will call all benchmarks. The results are written to the application data directory.
+         */
+        void BenchmarkMain(const bool print_status = true);
     }  // namespace TEST
 }  // namespace L2A
 
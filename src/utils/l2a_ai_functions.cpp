@@ -40,9 +40,11 @@
 #include "l2a_global.h"
 #include "l2a_item.h"
 #include "l2a_names.h"
+#include "l2a_plugin.h"
 #include "l2a_property.h"
 #include "l2a_string_functions.h"
 #include "l2a_suites.h"
+#include "l2a_trace.h"
 #include "l2a_utils.h"
 
 
@@ -134,6 +136,8 @@ void L2A::AI::SetPlacedItemPath(AIArtHandle& placed_item, const ai::FilePath& pa
  */
 void L2A::AI::RelinkPlacedItem(AIArtHandle& placed_item, const ai::FilePath& path)
 {
+    l2a_trace_scope("RelinkPlacedItem");
+
     AIErr error;
 
     // Request for creating a placed item.
@@ -184,6 +188,9 @@ void L2A::AI::SetName(const AIArtHandle& item, const ai::UnicodeString& name)
     ASErr error = kNoErr;
     error = sAIArt->SetArtName(item, name);
     l2a_check_ai_error(error);
+
+    // The name decides if the item is a LaTeX2AI item.
+    L2A::GlobalPluginMutable().GetItemRegistry().InvalidateItem(item);
 }
 
 /**
@@ -385,16 +392,8 @@ void L2A::AI::GetItems(std::vector<AIArtHandle>& items, SelectionState selected,
  */
 void L2A::AI::GetDocumentItems(std::vector<AIArtHandle>& l2a_items, SelectionState selected)
 {
-    // Clear the input vector.
-    l2a_items.clear();
-
-    // Get the art items in the document.
-    std::vector<AIArtHandle> art_items;
-    GetItems(art_items, selected, kPlacedArt);
-
-    // Loop over placed art items and check if they are LaTeX2AI items
-    for (const auto& item : art_items)
-        if (IsL2AItem(item)) l2a_items.push_back(item);
+    // The registry of the plugin only checks placed items that were not checked before.
+    L2A::GlobalPluginMutable().GetItemRegistry().GetItems(l2a_items, selected);
 }
 
 /**
@@ -963,29 +962,8 @@ void L2A::AI::GetArtParents(const AIArtHandle& art_item, std::vector<AIArtHandle
  */
 void L2A::AI::GetIsHiddenLocked(const AIArtHandle& art_item, bool& is_hidden, bool& is_locked)
 {
-    // Get all parents of the art item.
-    std::vector<AIArtHandle> parents;
-    GetArtParents(art_item, parents);
-
-    // Check if any of the parents are locked / hidden
-    ai::int32 attributes;
-    AIErr error = sAIArt->GetArtUserAttr(art_item, kArtLocked | kArtHidden, &attributes);
-    l2a_check_ai_error(error);
-    if (attributes & kArtLocked)
-        is_locked = true;
-    else
-        is_locked = false;
-    if (attributes & kArtHidden)
-        is_hidden = true;
-    else
-        is_hidden = false;
-    for (const auto& parent : parents)
-    {
-        error = sAIArt->GetArtUserAttr(parent, kArtLocked | kArtHidden, &attributes);
-        l2a_check_ai_error(error);
-        if (attributes & kArtLocked) is_locked = true;
-        if (attributes & kArtHidden) is_hidden = true;
-    }
+    // The state of the parents is cached in the plugin, so each group and layer is only evaluated once.
+    L2A::GlobalPluginMutable().GetHiddenLockedCache().GetIsHiddenLocked(art_item, is_hidden, is_locked);
 }
 
 /**
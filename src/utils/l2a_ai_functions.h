@@ -307,7 +307,8 @@ namespace L2A
          * @params art_item(in) Art item.
          * @params is_hidden(out) If the item or any of the parents are hidden.
          * @params is_locked(out) If the item or any of the parents are locked.
-         * layer.
+         *
+         * The state of the parents is taken from the HiddenLockedCache of the plugin.
          */
         void GetIsHiddenLocked(const AIArtHandle& art_item, bool& is_hidden, bool& is_locked);
 
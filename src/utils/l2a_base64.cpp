@@ -0,0 +1,516 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Base64 encoding and decoding with vectorized kernels.
+ *
+ * The vectorized kernels follow the algorithms by Wojciech Mula and Daniel Lemire, "Faster Base64 Encoding and
+ * Decoding Using AVX2 Instructions", ACM Transactions on the Web 12(3), 2018.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_base64.h"
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define L2A_BASE64_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define L2A_BASE64_TARGET(instruction_set)
+#else
+#define L2A_BASE64_TARGET(instruction_set) __attribute__((target(instruction_set)))
+#endif
+#endif
+
+
+namespace
+{
+    //! Base64 alphabet.
+    constexpr char base64_alphabet_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    //! Special values in the decoding table.
+    constexpr unsigned char decode_invalid_ = 0xff;
+    constexpr unsigned char decode_whitespace_ = 0xfe;
+    constexpr unsigned char decode_padding_ = 0xfd;
+
+    /**
+     * \brief Table that maps each character to its sextet or to one of the special values.
+     */
+    const std::array<unsigned char, 256>& DecodeTable()
+    {
+        static const std::array<unsigned char, 256> table = []()
+        {
+            std::array<unsigned char, 256> table;
+            table.fill(decode_invalid_);
+            for (unsigned char i = 0; i < 64; i++) table[(unsigned char)base64_alphabet_[i]] = i;
+            for (const char whitespace : {' ', '\t', '\n', '\r'}) table[(unsigned char)whitespace] = decode_whitespace_;
+            table['='] = decode_padding_;
+            return table;
+        }();
+        return table;
+    }
+
+    /**
+     * \brief Encode all complete groups of three bytes.
+     * @return Number of encoded bytes.
+     */
+    size_t EncodeScalar(const unsigned char* input, const size_t size, char* output)
+    {
+        const size_t n_groups = size / 3;
+        for (size_t i = 0; i < n_groups; i++)
+        {
+            const unsigned int bits = (input[0] << 16) | (input[1] << 8) | input[2];
+            output[0] = base64_alphabet_[(bits >> 18) & 0x3f];
+            output[1] = base64_alphabet_[(bits >> 12) & 0x3f];
+            output[2] = base64_alphabet_[(bits >> 6) & 0x3f];
+            output[3] = base64_alphabet_[bits & 0x3f];
+            input += 3;
+            output += 4;
+        }
+        return n_groups * 3;
+    }
+
+    /**
+     * \brief Decode groups of four characters until the end of the input or the first character that is not part of
+     * the alphabet.
+     * @return Number of decoded characters.
+     */
+    size_t DecodeScalar(const char* input, const size_t size, unsigned char* output)
+    {
+        const auto& table = DecodeTable();
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            const unsigned int a = table[(unsigned char)input[i]];
+            const unsigned int b = table[(unsigned char)input[i + 1]];
+            const unsigned int c = table[(unsigned char)input[i + 2]];
+            const unsigned int d = table[(unsigned char)input[i + 3]];
+            if ((a | b | c | d) >= 64) break;
+            const unsigned int bits = (a << 18) | (b << 12) | (c << 6) | d;
+            output[0] = (unsigned char)(bits >> 16);
+            output[1] = (unsigned char)(bits >> 8);
+            output[2] = (unsigned char)bits;
+            output += 3;
+        }
+        return i;
+    }
+
+#ifdef L2A_BASE64_X86
+    /**
+     * \brief Convert 16 sextets to the base64 characters.
+     */
+    L2A_BASE64_TARGET("ssse3") inline __m128i SextetsToCharactersSSSE3(const __m128i indices)
+    {
+        // Map the sextets to an offset index: 0 for [0, 25], 1 for [26, 51], 2 to 11 for [52, 61], 12 for 62 and 13
+        // for 63.
+        __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+        const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        result = _mm_shuffle_epi8(shift_lut, result);
+        return _mm_add_epi8(result, indices);
+    }
+
+    /**
+     * \brief Encode blocks of 12 bytes, as long as 16 bytes can be loaded.
+     * @return Number of encoded bytes.
+     */
+    L2A_BASE64_TARGET("ssse3") size_t EncodeSSSE3(const unsigned char* input, const size_t size, char* output)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 12)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i*)(input + i));
+            in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+            const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+            const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+            const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+            const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+            _mm_storeu_si128((__m128i*)output, SextetsToCharactersSSSE3(_mm_or_si128(t1, t3)));
+            output += 16;
+        }
+        return i;
+    }
+
+    /**
+     * \brief Decode blocks of 16 characters until the end of the input or the first block with a character that is
+     * not part of the alphabet.
+     * @return Number of decoded characters.
+     */
+    L2A_BASE64_TARGET("ssse3") size_t DecodeSSSE3(const char* input, const size_t size, unsigned char* output)
+    {
+        const __m128i lut_lo = _mm_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+        const __m128i lut_hi = _mm_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i mask_nibble = _mm_set1_epi8(0x0f);
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i*)(input + i));
+            const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask_nibble);
+            const __m128i lo_nibbles = _mm_and_si128(in, mask_nibble);
+            const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+            const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+            if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) break;
+
+            // Convert the characters to sextets and pack them.
+            const __m128i eq_2f = _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2f));
+            in = _mm_add_epi8(in, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles)));
+            const __m128i merged = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+            __m128i out = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+            out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+            alignas(16) unsigned char buffer[16];
+            _mm_store_si128((__m128i*)buffer, out);
+            std::memcpy(output, buffer, 12);
+            output += 12;
+        }
+        return i;
+    }
+
+    /**
+     * \brief Encode blocks of 24 bytes, as long as 28 bytes can be loaded.
+     * @return Number of encoded bytes.
+     */
+    L2A_BASE64_TARGET("avx2") size_t EncodeAVX2(const unsigned char* input, const size_t size, char* output)
+    {
+        const __m256i shift_lut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+            '/' - 63, 'A', 0, 0);
+        const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3,
+            5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+        size_t i = 0;
+        for (; i + 28 <= size; i += 24)
+        {
+            // Each 128 bit lane contains 12 input bytes.
+            __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(input + i))),
+                _mm_loadu_si128((const __m128i*)(input + i + 12)), 1);
+            in = _mm256_shuffle_epi8(in, shuffle);
+            const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+            const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+            const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+            const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(t1, t3);
+
+            __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+            result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+            result = _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, result), indices);
+            _mm256_storeu_si256((__m256i*)output, result);
+            output += 32;
+        }
+        return i;
+    }
+
+    /**
+     * \brief Decode blocks of 32 characters until the end of the input or the first block with a character that is
+     * not part of the alphabet.
+     * @return Number of decoded characters.
+     */
+    L2A_BASE64_TARGET("avx2") size_t DecodeAVX2(const char* input, const size_t size, unsigned char* output)
+    {
+        const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13,
+            0x1a, 0x1b, 0x1b, 0x1b, 0x1a, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b,
+            0x1b, 0x1b, 0x1a);
+        const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x10);
+        const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19,
+            4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+            4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i mask_nibble = _mm256_set1_epi8(0x0f);
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i in = _mm256_loadu_si256((const __m256i*)(input + i));
+            const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_nibble);
+            const __m256i lo_nibbles = _mm256_and_si256(in, mask_nibble);
+            const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+            const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+            if (!_mm256_testz_si256(lo, hi)) break;
+
+            // Convert the characters to sextets and pack them.
+            const __m256i eq_2f = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(0x2f));
+            in = _mm256_add_epi8(in, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+            const __m256i merged = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+            __m256i out = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            out = _mm256_shuffle_epi8(out, pack);
+            out = _mm256_permutevar8x32_epi32(out, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+            alignas(32) unsigned char buffer[32];
+            _mm256_store_si256((__m256i*)buffer, out);
+            std::memcpy(output, buffer, 24);
+            output += 24;
+        }
+        return i;
+    }
+
+    /**
+     * \brief Check which instruction sets are supported by the CPU and the operating system.
+     */
+    std::pair<bool, bool> CPUSupportsSSSE3AVX2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        const int n_ids = info[0];
+        __cpuid(info, 1);
+        const bool ssse3 = (info[2] & (1 << 9)) != 0;
+        const bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        bool avx2 = false;
+        if (n_ids >= 7 && os_avx)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        return {ssse3, avx2};
+#else
+        __builtin_cpu_init();
+        return {__builtin_cpu_supports("ssse3") != 0, __builtin_cpu_supports("avx2") != 0};
+#endif
+    }
+#endif
+
+    /**
+     * \brief Encode all complete groups of three bytes with the given kernel.
+     * @return Number of encoded bytes.
+     */
+    size_t EncodeBulk(const L2A::UTIL::Base64Kernel kernel, const unsigned char* input, const size_t size, char* output)
+    {
+        size_t n_done = 0;
+#ifdef L2A_BASE64_X86
+        if (kernel == L2A::UTIL::Base64Kernel::avx2)
+            n_done = EncodeAVX2(input, size, output);
+        else if (kernel == L2A::UTIL::Base64Kernel::ssse3)
+            n_done = EncodeSSSE3(input, size, output);
+#endif
+        return n_done + EncodeScalar(input + n_done, size - n_done, output + n_done / 3 * 4);
+    }
+
+    /**
+     * \brief Decode groups of four characters with the given kernel, until the end of the input or the first character
+     * that is not part of the alphabet.
+     * @return Number of decoded characters.
+     */
+    size_t DecodeBulk(const L2A::UTIL::Base64Kernel kernel, const char* input, const size_t size, unsigned char* output)
+    {
+        size_t n_done = 0;
+#ifdef L2A_BASE64_X86
+        if (kernel == L2A::UTIL::Base64Kernel::avx2)
+            n_done = DecodeAVX2(input, size, output);
+        else if (kernel == L2A::UTIL::Base64Kernel::ssse3)
+            n_done = DecodeSSSE3(input, size, output);
+#endif
+        return n_done + DecodeScalar(input + n_done, size - n_done, output + n_done / 4 * 3);
+    }
+
+    //! Size of the chunks for the stream functions (multiple of 3 and 4).
+    constexpr size_t stream_chunk_size_ = 3 * 4 * 16384;
+}  // namespace
+
+
+/**
+ *
+ */
+std::vector<L2A::UTIL::Base64Kernel> L2A::UTIL::Base64AvailableKernels()
+{
+    std::vector<Base64Kernel> kernels = {Base64Kernel::scalar};
+#ifdef L2A_BASE64_X86
+    static const std::pair<bool, bool> cpu_support = CPUSupportsSSSE3AVX2();
+    if (cpu_support.first) kernels.push_back(Base64Kernel::ssse3);
+    if (cpu_support.second) kernels.push_back(Base64Kernel::avx2);
+#endif
+    return kernels;
+}
+
+/**
+ *
+ */
+L2A::UTIL::Base64Kernel L2A::UTIL::Base64BestKernel()
+{
+    static const Base64Kernel best_kernel = Base64AvailableKernels().back();
+    return best_kernel;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::Base64Encoder::Append(const char* data, size_t size, std::string& output)
+{
+    const unsigned char* input = (const unsigned char*)data;
+
+    // Complete the group from the last chunk.
+    if (n_remainder_ > 0)
+    {
+        while (n_remainder_ < 3 && size > 0)
+        {
+            remainder_[n_remainder_++] = *input++;
+            size--;
+        }
+        if (n_remainder_ < 3) return;
+        const size_t old_size = output.size();
+        output.resize(old_size + 4);
+        EncodeScalar(remainder_, 3, &output[old_size]);
+        n_remainder_ = 0;
+    }
+
+    const size_t old_size = output.size();
+    output.resize(old_size + size / 3 * 4);
+    const size_t n_done = EncodeBulk(kernel_, input, size, &output[old_size]);
+    for (size_t i = n_done; i < size; i++) remainder_[n_remainder_++] = input[i];
+}
+
+/**
+ *
+ */
+void L2A::UTIL::Base64Encoder::Finish(std::string& output)
+{
+    if (n_remainder_ > 0)
+    {
+        const unsigned int bits = (remainder_[0] << 16) | (n_remainder_ > 1 ? remainder_[1] << 8 : 0);
+        output.push_back(base64_alphabet_[(bits >> 18) & 0x3f]);
+        output.push_back(base64_alphabet_[(bits >> 12) & 0x3f]);
+        if (n_remainder_ > 1) output.push_back(base64_alphabet_[(bits >> 6) & 0x3f]);
+    }
+    n_remainder_ = 0;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::Base64Decoder::Append(const char* data, size_t size, std::string& output)
+{
+    const auto& table = DecodeTable();
+    const size_t old_size = output.size();
+    output.resize(old_size + size / 4 * 3 + 3);
+    unsigned char* out = (unsigned char*)&output[old_size];
+
+    size_t i = 0;
+    while (i < size)
+    {
+        // Decode as much as possible with the bulk kernel, it stops at whitespace and padding characters.
+        if (n_sextets_ == 0 && !padding_)
+        {
+            const size_t n_done = DecodeBulk(kernel_, data + i, size - i, out);
+            out += n_done / 4 * 3;
+            i += n_done;
+            if (i == size) break;
+        }
+
+        const unsigned char value = table[(unsigned char)data[i++]];
+        if (value < 64)
+        {
+            if (padding_) return false;
+            bits_ = (bits_ << 6) | value;
+            if (++n_sextets_ == 4)
+            {
+                *out++ = (unsigned char)(bits_ >> 16);
+                *out++ = (unsigned char)(bits_ >> 8);
+                *out++ = (unsigned char)bits_;
+                n_sextets_ = 0;
+                bits_ = 0;
+            }
+        }
+        else if (value == decode_padding_)
+            padding_ = true;
+        else if (value != decode_whitespace_)
+            return false;
+    }
+
+    output.resize(out - (unsigned char*)output.data());
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::Base64Decoder::Finish(std::string& output)
+{
+    const unsigned int n_sextets = n_sextets_;
+    const unsigned int bits = bits_;
+    n_sextets_ = 0;
+    bits_ = 0;
+    padding_ = false;
+
+    if (n_sextets == 2)
+        output.push_back((char)(bits >> 4));
+    else if (n_sextets == 3)
+    {
+        output.push_back((char)(bits >> 10));
+        output.push_back((char)(bits >> 2));
+    }
+    return n_sextets != 1;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::Base64EncodeStream(std::istream& input, std::string& encoded, const Base64Kernel kernel)
+{
+    Base64Encoder encoder(kernel);
+    std::vector<char> buffer(stream_chunk_size_);
+    while (input)
+    {
+        input.read(buffer.data(), buffer.size());
+        encoder.Append(buffer.data(), (size_t)input.gcount(), encoded);
+    }
+    encoder.Finish(encoded);
+    return input.eof() && !input.bad();
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::Base64DecodeStream(const char* encoded, size_t size, std::ostream& output, const Base64Kernel kernel)
+{
+    Base64Decoder decoder(kernel);
+    std::string buffer;
+    buffer.reserve(stream_chunk_size_ / 4 * 3 + 3);
+    for (size_t i = 0; i < size; i += stream_chunk_size_)
+    {
+        buffer.clear();
+        const size_t chunk_size = size - i < stream_chunk_size_ ? size - i : stream_chunk_size_;
+        if (!decoder.Append(encoded + i, chunk_size, buffer)) return false;
+        output.write(buffer.data(), buffer.size());
+    }
+    buffer.clear();
+    if (!decoder.Finish(buffer)) return false;
+    output.write(buffer.data(), buffer.size());
+    return !output.fail();
+}
@@ -0,0 +1,172 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Base64 encoding and decoding with vectorized kernels.
+ */
+
+#ifndef UTIL_BASE64_H_
+#define UTIL_BASE64_H_
+
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Implementation that is used for the bulk of the data.
+         */
+        enum class Base64Kernel
+        {
+            scalar,
+            ssse3,
+            avx2
+        };
+
+        /**
+         * \brief Get all kernels that are supported by the current CPU.
+         */
+        std::vector<Base64Kernel> Base64AvailableKernels();
+
+        /**
+         * \brief Get the fastest kernel that is supported by the current CPU.
+         */
+        Base64Kernel Base64BestKernel();
+
+        /**
+         * \brief Streaming base64 encoder.
+         *
+         * The standard alphabet is used and no padding characters are added, this is the same format as the one
+         * created by the tpl/base64 library used in previous versions. The encoder only uses std types, so it can be
+         * used outside of the plugin thread.
+         */
+        class Base64Encoder
+        {
+           public:
+            /**
+             * \brief Constructor.
+             */
+            explicit Base64Encoder(const Base64Kernel kernel = Base64BestKernel())
+                : kernel_(kernel), n_remainder_(0), remainder_{0, 0, 0}
+            {
+            }
+
+            /**
+             * \brief Encode the next chunk of data and append the encoded characters to output.
+             */
+            void Append(const char* data, size_t size, std::string& output);
+
+            /**
+             * \brief Encode the remaining bytes of the last chunk. The encoder can be used for a new stream afterwards.
+             */
+            void Finish(std::string& output);
+
+            /**
+             * \brief Get the length of the encoded string for a given number of bytes.
+             */
+            static size_t EncodedLength(const size_t size)
+            {
+                return (size / 3) * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+            }
+
+           private:
+            //! Kernel used for the bulk of the data.
+            Base64Kernel kernel_;
+
+            //! Number of bytes that are left over from the last chunk.
+            size_t n_remainder_;
+
+            //! Bytes that are left over from the last chunk.
+            unsigned char remainder_[3];
+        };
+
+        /**
+         * \brief Streaming base64 decoder.
+         *
+         * Whitespace characters are skipped and padding characters at the end of the data are accepted. The decoder
+         * only uses std types, so it can be used outside of the plugin thread.
+         */
+        class Base64Decoder
+        {
+           public:
+            /**
+             * \brief Constructor.
+             */
+            explicit Base64Decoder(const Base64Kernel kernel = Base64BestKernel())
+                : kernel_(kernel), n_sextets_(0), bits_(0), padding_(false)
+            {
+            }
+
+            /**
+             * \brief Decode the next chunk of encoded characters and append the decoded bytes to output.
+             * @return False if the chunk contains invalid characters.
+             */
+            bool Append(const char* data, size_t size, std::string& output);
+
+            /**
+             * \brief Decode the remaining characters of the last chunk. The decoder can be used for a new stream
+             * afterwards.
+             * @return False if the encoded data was truncated.
+             */
+            bool Finish(std::string& output);
+
+           private:
+            //! Kernel used for the bulk of the data.
+            Base64Kernel kernel_;
+
+            //! Number of sextets in the current group of four characters.
+            unsigned int n_sextets_;
+
+            //! Bits of the current group of four characters.
+            unsigned int bits_;
+
+            //! Flag if a padding character was found.
+            bool padding_;
+        };
+
+        /**
+         * \brief Encode the contents of an input stream.
+         * @return False if the stream could not be read.
+         */
+        bool Base64EncodeStream(
+            std::istream& input, std::string& encoded, const Base64Kernel kernel = Base64BestKernel());
+
+        /**
+         * \brief Decode a base64 string and write the decoded data to an output stream. The data is decoded in chunks,
+         * so the decoded data is never stored in memory as a whole.
+         * @return False if the data is not valid or the stream could not be written.
+         */
+        bool Base64DecodeStream(const char* encoded, size_t size, std::ostream& output,
+            const Base64Kernel kernel = Base64BestKernel());
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,321 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief User level cache for compiled LaTeX2AI items, shared between documents and Illustrator instances.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_compile_cache.h"
+
+#include "l2a_file_system.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#ifndef WIN_ENV
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+    //! Name of the index file in the cache directory.
+    constexpr char index_name_[] = "LaTeX2AI_compile_cache.txt";
+
+    //! Name of the lock file in the cache directory.
+    constexpr char lock_name_[] = "LaTeX2AI_compile_cache.lock";
+
+    //! First line of the index file, the number is the version of the cache format.
+    constexpr char index_header_[] = "LaTeX2AI_compile_cache 1";
+
+    //! Extension of the cached pdf files and of files that are currently written.
+    constexpr char pdf_extension_[] = ".pdf";
+    constexpr char temporary_extension_[] = ".tmp";
+
+    /**
+     * \brief Check if a key can be used as file name in the cache directory.
+     */
+    bool IsValidKey(const std::string& key)
+    {
+        if (key.empty() || key.size() > 128) return false;
+        for (const char c : key)
+            if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '-'))
+                return false;
+        return true;
+    }
+
+    /**
+     * \brief Size of a file, or 0 if it can not be obtained.
+     */
+    std::uintmax_t FileSizeOrZero(const std::filesystem::path& path)
+    {
+        std::error_code error_code;
+        const std::uintmax_t size = std::filesystem::file_size(path, error_code);
+        return error_code ? 0 : size;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+L2A::UTIL::FileLock::FileLock(const std::filesystem::path& lock_file) : is_locked_(false)
+{
+#ifdef WIN_ENV
+    handle_ = CreateFileW(lock_file.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle_ == INVALID_HANDLE_VALUE) return;
+    OVERLAPPED overlapped = {};
+    is_locked_ = LockFileEx(handle_, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) != 0;
+#else
+    file_descriptor_ = open(lock_file.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file_descriptor_ < 0) return;
+    is_locked_ = flock(file_descriptor_, LOCK_EX) == 0;
+#endif
+}
+
+/**
+ *
+ */
+L2A::UTIL::FileLock::~FileLock()
+{
+#ifdef WIN_ENV
+    if (handle_ == INVALID_HANDLE_VALUE) return;
+    if (is_locked_)
+    {
+        OVERLAPPED overlapped = {};
+        UnlockFileEx(handle_, 0, MAXDWORD, MAXDWORD, &overlapped);
+    }
+    CloseHandle(handle_);
+#else
+    // Closing the file releases the lock.
+    if (file_descriptor_ >= 0) close(file_descriptor_);
+#endif
+}
+
+/**
+ *
+ */
+L2A::UTIL::CompileCache::CompileCache(const ai::FilePath& directory, const std::uintmax_t max_size)
+    : directory_(L2A::UTIL::FilePathAiToStd(directory)), max_size_(max_size)
+{
+    std::error_code error_code;
+    std::filesystem::create_directories(directory_, error_code);
+}
+
+/**
+ *
+ */
+std::vector<bool> L2A::UTIL::CompileCache::Lookup(
+    const std::vector<std::string>& keys, const std::vector<ai::FilePath>& targets)
+{
+    std::vector<bool> is_found(keys.size(), false);
+    FileLock lock(directory_ / lock_name_);
+    if (!lock.IsLocked()) return is_found;
+
+    // The pdf files are the actual entries, so a file that is missing in the index, e.g., because an insert was
+    // interrupted, is still found and added to the index again.
+    Index index = ReadIndex();
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (IsValidKey(keys[i]))
+        {
+            const std::filesystem::path entry_path = GetEntryPath(keys[i]);
+            std::error_code error_code;
+            is_found[i] = std::filesystem::copy_file(entry_path, L2A::UTIL::FilePathAiToStd(targets[i]),
+                std::filesystem::copy_options::overwrite_existing, error_code);
+            if (is_found[i])
+                index.entries_[keys[i]] = Entry{FileSizeOrZero(entry_path), ++index.access_counter_};
+            else
+                index.entries_.erase(keys[i]);
+        }
+
+        if (is_found[i])
+            index.statistics_.hits_++;
+        else
+            index.statistics_.misses_++;
+    }
+    WriteIndex(index);
+
+    return is_found;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::CompileCache::Insert(const std::vector<std::string>& keys, const std::vector<ai::FilePath>& pdf_files)
+{
+    FileLock lock(directory_ / lock_name_);
+    if (!lock.IsLocked()) return;
+
+    Index index = ReadIndex();
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (!IsValidKey(keys[i])) continue;
+
+        // Other instances only see the entry after it is renamed to its final name.
+        const std::filesystem::path entry_path = GetEntryPath(keys[i]);
+        const std::filesystem::path temporary_path = directory_ / (keys[i] + temporary_extension_);
+        std::error_code error_code;
+        if (!std::filesystem::copy_file(L2A::UTIL::FilePathAiToStd(pdf_files[i]), temporary_path,
+                std::filesystem::copy_options::overwrite_existing, error_code))
+        {
+            std::filesystem::remove(temporary_path, error_code);
+            continue;
+        }
+        std::filesystem::rename(temporary_path, entry_path, error_code);
+        if (error_code)
+        {
+            std::filesystem::remove(temporary_path, error_code);
+            continue;
+        }
+        index.entries_[keys[i]] = Entry{FileSizeOrZero(entry_path), ++index.access_counter_};
+    }
+    EnforceSizeLimit(index);
+    WriteIndex(index);
+}
+
+/**
+ *
+ */
+L2A::UTIL::CompileCacheStatistics L2A::UTIL::CompileCache::GetStatistics() const
+{
+    FileLock lock(directory_ / lock_name_);
+    if (!lock.IsLocked()) return CompileCacheStatistics();
+
+    const Index index = ReadIndex();
+    CompileCacheStatistics statistics = index.statistics_;
+    statistics.n_entries_ = index.entries_.size();
+    for (const auto& [key, entry] : index.entries_) statistics.size_ += entry.size_;
+    return statistics;
+}
+
+/**
+ *
+ */
+L2A::UTIL::CompileCache::Index L2A::UTIL::CompileCache::ReadIndex() const
+{
+    Index index;
+    bool is_valid = false;
+    {
+        std::ifstream input_stream(directory_ / index_name_, std::ifstream::binary);
+        std::string line;
+        if (input_stream && std::getline(input_stream, line) && line == index_header_ &&
+            std::getline(input_stream, line))
+        {
+            std::istringstream statistics_stream(line);
+            is_valid = bool(statistics_stream >> index.access_counter_ >> index.statistics_.hits_ >>
+                            index.statistics_.misses_ >> index.statistics_.evictions_);
+            while (is_valid && std::getline(input_stream, line))
+            {
+                std::istringstream entry_stream(line);
+                std::string key;
+                Entry entry;
+                is_valid = bool(entry_stream >> key >> entry.size_ >> entry.last_access_) && IsValidKey(key);
+                if (is_valid) index.entries_[key] = entry;
+            }
+        }
+    }
+    if (is_valid) return index;
+
+    // Rebuild the index from the files in the cache directory. Temporary files are left overs of interrupted inserts.
+    index = Index();
+    std::error_code error_code;
+    for (const auto& directory_entry : std::filesystem::directory_iterator(directory_, error_code))
+    {
+        const std::filesystem::path& path = directory_entry.path();
+        const std::string key = path.stem().string();
+        if (path.extension() == pdf_extension_ && IsValidKey(key))
+            index.entries_[key] = Entry{FileSizeOrZero(path), 0};
+        else if (path.extension() == temporary_extension_)
+            std::filesystem::remove(path, error_code);
+    }
+    return index;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::CompileCache::WriteIndex(const Index& index) const
+{
+    std::ostringstream index_stream;
+    index_stream << index_header_ << "\n";
+    index_stream << index.access_counter_ << " " << index.statistics_.hits_ << " " << index.statistics_.misses_ << " "
+                 << index.statistics_.evictions_ << "\n";
+    for (const auto& [key, entry] : index.entries_)
+        index_stream << key << " " << entry.size_ << " " << entry.last_access_ << "\n";
+
+    // Replace the index in one step, so it is complete even if writing it is interrupted.
+    const std::filesystem::path temporary_path = directory_ / (std::string(index_name_) + temporary_extension_);
+    {
+        std::ofstream output_stream(temporary_path, std::ofstream::binary | std::ofstream::trunc);
+        if (!output_stream) return;
+        const std::string index_string = index_stream.str();
+        output_stream.write(index_string.data(), index_string.size());
+        if (!output_stream) return;
+    }
+    std::error_code error_code;
+    std::filesystem::rename(temporary_path, directory_ / index_name_, error_code);
+}
+
+/**
+ *
+ */
+void L2A::UTIL::CompileCache::EnforceSizeLimit(Index& index) const
+{
+    std::uintmax_t size = 0;
+    for (const auto& [key, entry] : index.entries_) size += entry.size_;
+    if (size <= max_size_) return;
+
+    std::vector<std::pair<std::uint64_t, std::string>> access_order;
+    access_order.reserve(index.entries_.size());
+    for (const auto& [key, entry] : index.entries_) access_order.emplace_back(entry.last_access_, key);
+    std::sort(access_order.begin(), access_order.end());
+
+    for (const auto& [last_access, key] : access_order)
+    {
+        if (size <= max_size_) break;
+        std::error_code error_code;
+        std::filesystem::remove(GetEntryPath(key), error_code);
+        size -= index.entries_[key].size_;
+        index.entries_.erase(key);
+        index.statistics_.evictions_++;
+    }
+}
+
+/**
+ *
+ */
+std::filesystem::path L2A::UTIL::CompileCache::GetEntryPath(const std::string& key) const
+{
+    return directory_ / (key + pdf_extension_);
+}
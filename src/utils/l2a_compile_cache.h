@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief User level cache for compiled LaTeX2AI items, shared between documents and Illustrator instances.
+ */
+
+#ifndef UTIL_COMPILE_CACHE_H_
+#define UTIL_COMPILE_CACHE_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Exclusive lock on a file, which is released when the object is destroyed. The lock is held by the
+         * process, i.e., it synchronizes different Illustrator instances, not threads of one instance.
+         */
+        class FileLock
+        {
+           public:
+            /**
+             * \brief Constructor, this blocks until the lock is obtained. The lock file is created if it does not
+             * exist.
+             */
+            explicit FileLock(const std::filesystem::path& lock_file);
+
+            /**
+             * \brief Destructor, the lock is released.
+             */
+            ~FileLock();
+
+            FileLock(const FileLock&) = delete;
+            FileLock& operator=(const FileLock&) = delete;
+
+            /**
+             * \brief Check if the lock was obtained.
+             */
+            bool IsLocked() const { return is_locked_; }
+
+           private:
+#ifdef WIN_ENV
+            //! Handle of the lock file.
+            HANDLE handle_;
+#else
+            //! File descriptor of the lock file.
+            int file_descriptor_;
+#endif
+
+            //! Flag if the lock was obtained.
+            bool is_locked_;
+        };
+
+        /**
+         * \brief Statistics of the compile cache. They are stored in the cache, i.e., they accumulate over all
+         * documents, sessions and Illustrator instances.
+         */
+        struct CompileCacheStatistics
+        {
+            //! Number of items that were found in the cache.
+            std::uint64_t hits_ = 0;
+
+            //! Number of items that were not found in the cache.
+            std::uint64_t misses_ = 0;
+
+            //! Number of entries that were removed to stay within the size limit.
+            std::uint64_t evictions_ = 0;
+
+            //! Current number of entries in the cache.
+            std::uint64_t n_entries_ = 0;
+
+            //! Current size of the cached pdf files in bytes.
+            std::uintmax_t size_ = 0;
+        };
+
+        /**
+         * \brief Cache that maps compile keys to the pdf files of single items.
+         *
+         * Each entry is a pdf file named by its key in the cache directory. The index file stores the size and the
+         * last access of each entry as well as the statistics, the least recently used entries are removed if the
+         * size limit is exceeded. All accesses to the cache directory are done while holding the lock file, new
+         * files are written to a temporary file and renamed, so a cancelled insert never leaves a partial entry.
+         *
+         * Failing file operations are not reported as errors, the cache then behaves as if the entry was not there.
+         */
+        class CompileCache
+        {
+           public:
+            /**
+             * \brief Constructor.
+             * @param directory Directory of the cache, it is created if it does not exist.
+             * @param max_size Maximum size of the cached pdf files in bytes.
+             */
+            CompileCache(const ai::FilePath& directory, const std::uintmax_t max_size);
+
+            /**
+             * \brief Copy the cached pdf files for the given keys to the target files. The entries that are found are
+             * marked as used.
+             * @return Flag for each key if it was found and copied.
+             */
+            std::vector<bool> Lookup(const std::vector<std::string>& keys, const std::vector<ai::FilePath>& targets);
+
+            /**
+             * \brief Add pdf files to the cache, existing entries for the keys are replaced. Afterwards, the least
+             * recently used entries are removed until the cache is within its size limit.
+             */
+            void Insert(const std::vector<std::string>& keys, const std::vector<ai::FilePath>& pdf_files);
+
+            /**
+             * \brief Get the statistics of the cache.
+             */
+            CompileCacheStatistics GetStatistics() const;
+
+           private:
+            /**
+             * \brief Entry in the index of the cache.
+             */
+            struct Entry
+            {
+                //! Size of the pdf file in bytes.
+                std::uintmax_t size_;
+
+                //! Value of the access counter when the entry was last used.
+                std::uint64_t last_access_;
+            };
+
+            /**
+             * \brief Index of the cache.
+             */
+            struct Index
+            {
+                //! Counter that is incremented for each access, it defines the order of the last accesses.
+                std::uint64_t access_counter_ = 0;
+
+                //! Statistics, the number of entries and the size are calculated from the entries.
+                CompileCacheStatistics statistics_;
+
+                //! Entries of the cache, the key is the compile key.
+                std::map<std::string, Entry> entries_;
+            };
+
+            /**
+             * \brief Read the index. If it does not exist or can not be read, it is rebuilt from the pdf files in the
+             * cache directory (the statistics are reset in this case). Has to be called while holding the lock.
+             */
+            Index ReadIndex() const;
+
+            /**
+             * \brief Write the index. Has to be called while holding the lock.
+             */
+            void WriteIndex(const Index& index) const;
+
+            /**
+             * \brief Remove the least recently used entries until the cache is within its size limit.
+             */
+            void EnforceSizeLimit(Index& index) const;
+
+            /**
+             * \brief Path of the cached pdf file for a key.
+             */
+            std::filesystem::path GetEntryPath(const std::string& key) const;
+
+            //! Directory of the cache.
+            std::filesystem::path directory_;
+
+            //! Maximum size of the cached pdf files in bytes.
+            std::uintmax_t max_size_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -31,15 +31,17 @@
 
 #include "l2a_file_system.h"
 
-#include "base64.h"
-
+#include "l2a_base64.h"
 #include "l2a_error.h"
 #include "l2a_names.h"
+#include "l2a_parallel.h"
 #include "l2a_string_functions.h"
 #include "l2a_suites.h"
+#include "l2a_trace.h"
 
 #include <array>
 #include <regex>
+#include <set>
 
 // File encoding.
 #include <codecvt>
@@ -206,6 +208,21 @@ ai::UnicodeString L2A::UTIL::ReadFileUTF8(const ai::FilePath& path)
     return L2A::UTIL::StringStdToAi(buffer.str());
 }
 
+/**
+ *
+ */
+std::string L2A::UTIL::ReadFileBinary(const ai::FilePath& path)
+{
+    std::ifstream input_stream(FilePathAiToStd(path), std::ifstream::binary);
+    if (!input_stream) l2a_error("The file '" + path.GetFullPath() + "' could not be opened!");
+
+    input_stream.seekg(0, input_stream.end);
+    std::string data((size_t)input_stream.tellg(), 0);
+    input_stream.seekg(0, input_stream.beg);
+    if (!input_stream.read(&data[0], data.size())) l2a_error("Error in reading the file '" + path.GetFullPath() + "'");
+    return data;
+}
+
 /**
  *
  */
@@ -377,27 +394,18 @@ bool L2A::UTIL::IsEqualFile(const ai::FilePath& path_a, const ai::FilePath& path
  */
 std::string L2A::UTIL::encode_file_base64(const ai::FilePath& path)
 {
-    // https://www.cplusplus.com/reference/istream/istream/read/
-
     std::ifstream input_stream(FilePathAiToStd(path), std::ifstream::binary);
     if (!input_stream) l2a_error("Error in loading file");
 
-    // Get length of the file.
+    // Reserve the encoded size, so the file can be encoded in chunks without reallocations.
     input_stream.seekg(0, input_stream.end);
-    unsigned int length = (unsigned int)input_stream.tellg();
+    const size_t length = (size_t)input_stream.tellg();
     input_stream.seekg(0, input_stream.beg);
+    std::string encoded;
+    encoded.reserve(L2A::UTIL::Base64Encoder::EncodedLength(length));
 
-    // Storage for data.
-    std::vector<char> buffer_vector(length);
-    char* buffer = buffer_vector.data();
-
-    // Read data as a block.
-    input_stream.read(buffer, length);
-    if (!input_stream) l2a_error("Error in reading file");
-    input_stream.close();
-
-    // Encode file data.
-    return base64::encode(buffer, length);
+    if (!L2A::UTIL::Base64EncodeStream(input_stream, encoded)) l2a_error("Error in reading file");
+    return encoded;
 }
 
 /*
@@ -405,8 +413,48 @@ std::string L2A::UTIL::encode_file_base64(const ai::FilePath& path)
  */
 void L2A::UTIL::decode_file_base64(const ai::FilePath& path, const ai::UnicodeString& encoded_string)
 {
-    auto char_vector = base64::decode(L2A::UTIL::StringAiToStd(encoded_string));
+    const std::string encoded_string_std = L2A::UTIL::StringAiToStd(encoded_string);
     std::ofstream output_stream(FilePathAiToStd(path), std::ofstream::binary);
-    output_stream.write(char_vector.data(), char_vector.size());
-    output_stream.close();
+    if (!L2A::UTIL::Base64DecodeStream(encoded_string_std.data(), encoded_string_std.size(), output_stream))
+        l2a_error("Error in decoding the file " + path.GetFullPath());
+}
+
+/**
+ *
+ */
+void L2A::UTIL::decode_files(const std::vector<EncodedFile>& encoded_files)
+{
+    l2a_trace_scope("decode_files");
+
+    // Each file is only written once.
+    std::vector<const EncodedFile*> unique_files;
+    std::set<std::filesystem::path> paths;
+    for (const auto& encoded_file : encoded_files)
+        if (paths.insert(encoded_file.path_).second) unique_files.push_back(&encoded_file);
+
+    // The worker threads only use std types, errors are reported after all files are processed.
+    std::vector<char> write_ok(unique_files.size(), 0);
+    L2A::UTIL::ParallelFor(unique_files.size(),
+        [&](size_t i)
+        {
+            const L2A::UTIL::SharedString& encoded_string = unique_files[i]->encoded_string_;
+            std::ofstream output_stream(unique_files[i]->path_, std::ofstream::binary);
+            if (unique_files[i]->encoding_ == L2A::UTIL::PayloadEncoding::base64)
+                write_ok[i] =
+                    L2A::UTIL::Base64DecodeStream(encoded_string.data(), encoded_string.size(), output_stream);
+            else
+            {
+                std::string decoded;
+                write_ok[i] = L2A::UTIL::DecodePayload(
+                    unique_files[i]->encoding_, encoded_string.data(), encoded_string.size(), decoded);
+                output_stream.write(decoded.data(), decoded.size());
+            }
+            output_stream.close();
+            write_ok[i] = write_ok[i] && !output_stream.fail();
+        });
+
+    for (size_t i = 0; i < unique_files.size(); i++)
+        if (!write_ok[i])
+            l2a_error(ai::UnicodeString("Could not decode the file ") +
+                      L2A::UTIL::StringStdToAi(unique_files[i]->path_.u8string()));
 }
@@ -32,7 +32,11 @@
 
 #include "IllustratorSDK.h"
 
+#include "l2a_payload.h"
+#include "l2a_shared_string.h"
+
 #include <filesystem>
+#include <vector>
 
 namespace L2A
 {
@@ -94,6 +98,11 @@ namespace L2A
          */
         ai::UnicodeString ReadFileUTF8(const ai::FilePath& path);
 
+        /**
+         * \brief Read the contents of a binary file.
+         */
+        std::string ReadFileBinary(const ai::FilePath& path);
+
         /**
          * \brief Create a directory if it does not exist yet.
          */
@@ -171,6 +180,28 @@ namespace L2A
          * \brief Write a base64 encoded string to a file.
          */
         void decode_file_base64(const ai::FilePath& path, const ai::UnicodeString& encoded_string);
+
+        /**
+         * \brief An encoded file that should be written to disk. Only std types are used, so the data can be
+         * processed outside of the plugin thread.
+         */
+        struct EncodedFile
+        {
+            //! Path of the file.
+            std::filesystem::path path_;
+
+            //! Encoded contents of the file.
+            L2A::UTIL::SharedString encoded_string_;
+
+            //! Encoding of the contents.
+            L2A::UTIL::PayloadEncoding encoding_ = L2A::UTIL::PayloadEncoding::base64;
+        };
+
+        /**
+         * \brief Decode and write multiple encoded files in parallel. If multiple entries have the same path, the file
+         * is only written once.
+         */
+        void decode_files(const std::vector<EncodedFile>& encoded_files);
     }  // namespace UTIL
 }  // namespace L2A
 
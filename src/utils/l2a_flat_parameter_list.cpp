@@ -0,0 +1,249 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Flat read-only representation of a parameter list.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_flat_parameter_list.h"
+
+#include "tinyxml2.h"
+
+#include "l2a_error.h"
+#include "l2a_parameter_list.h"
+#include "l2a_string_functions.h"
+
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+
+/**
+ *
+ */
+L2A::UTIL::FlatParameterList::Document::~Document() {}
+
+/**
+ *
+ */
+L2A::UTIL::FlatParameterList::FlatParameterList(const std::string& xml_string) : node_(0)
+{
+    SetFromXML(xml_string.c_str(), xml_string.size());
+}
+
+/**
+ *
+ */
+L2A::UTIL::FlatParameterList::FlatParameterList(const ai::UnicodeString& xml_string) : node_(0)
+{
+    const std::string xml_string_std = L2A::UTIL::StringAiToStd(xml_string);
+    SetFromXML(xml_string_std.c_str(), xml_string_std.size());
+}
+
+/**
+ *
+ */
+void L2A::UTIL::FlatParameterList::SetFromXML(const char* xml_string, const size_t size)
+{
+    auto document = std::make_shared<Document>();
+    document->xml_document_ = std::make_unique<tinyxml2::XMLDocument>();
+    tinyxml2::XMLError xml_error = document->xml_document_->Parse(xml_string, size);
+    if (tinyxml2::XML_SUCCESS != xml_error)
+        l2a_error("XML could not be parsed.\nThe string was:\n\n" +
+                  L2A::UTIL::StringStdToAi(std::string(xml_string, size)));
+
+    // All strings returned by the xml document point into its buffer, they stay valid as long as the document exists.
+    const auto intern_key = [&document](const char* name)
+    {
+        const std::string_view key(name);
+        const auto [key_index, is_new] = document->key_indices_.emplace(key, (std::uint32_t)document->keys_.size());
+        if (is_new) document->keys_.push_back(key);
+        return key_index->second;
+    };
+
+    // The nodes are added breadth first, so the sub lists of each node are stored contiguously.
+    const tinyxml2::XMLElement* xml_root = document->xml_document_->RootElement();
+    std::vector<const tinyxml2::XMLElement*> xml_elements = {xml_root};
+    document->nodes_.push_back(Node{intern_key(xml_root->Name()), 0, 0, 0, 0, std::string_view(), false});
+    std::vector<std::pair<std::uint32_t, const tinyxml2::XMLElement*>> children;
+    for (size_t i_node = 0; i_node < xml_elements.size(); i_node++)
+    {
+        const tinyxml2::XMLElement* xml_element = xml_elements[i_node];
+
+        // Add the sub lists sorted by their key.
+        children.clear();
+        for (const tinyxml2::XMLElement* child = xml_element->FirstChildElement(); child != nullptr;
+             child = child->NextSiblingElement())
+            children.emplace_back(intern_key(child->Name()), child);
+        std::sort(children.begin(), children.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        for (size_t i_child = 1; i_child < children.size(); i_child++)
+            if (children[i_child].first == children[i_child - 1].first)
+                l2a_error("Key \"" + L2A::UTIL::StringStdToAi(children[i_child].second->Name()) +
+                          "\" already exists in sub list map!");
+        document->nodes_[i_node].first_child_ = (std::uint32_t)document->nodes_.size();
+        document->nodes_[i_node].n_children_ = (std::uint32_t)children.size();
+        for (const auto& [key, child] : children)
+        {
+            xml_elements.push_back(child);
+            document->nodes_.push_back(Node{key, 0, 0, 0, 0, std::string_view(), false});
+        }
+
+        // Add the options sorted by their key. The xml parser does not allow duplicate attributes.
+        const auto first_attribute = document->attributes_.size();
+        for (const tinyxml2::XMLAttribute* attr = xml_element->FirstAttribute(); attr != nullptr; attr = attr->Next())
+            document->attributes_.push_back(Attribute{intern_key(attr->Name()), std::string_view(attr->Value())});
+        std::sort(document->attributes_.begin() + first_attribute, document->attributes_.end(),
+            [](const Attribute& lhs, const Attribute& rhs) { return lhs.key_ < rhs.key_; });
+        document->nodes_[i_node].first_attribute_ = (std::uint32_t)first_attribute;
+        document->nodes_[i_node].n_attributes_ = (std::uint32_t)(document->attributes_.size() - first_attribute);
+
+        // Set main option.
+        const char* main_option = xml_element->GetText();
+        if (main_option != nullptr)
+        {
+            if (!children.empty()) l2a_error("Main option can not be set if size if sub lists is not 0!");
+            document->nodes_[i_node].main_option_ = std::string_view(main_option);
+            document->nodes_[i_node].main_option_set_ = true;
+        }
+    }
+
+    document_ = std::move(document);
+}
+
+/**
+ *
+ */
+L2A::UTIL::FlatParameterList L2A::UTIL::FlatParameterList::GetSubList(const std::string_view& key) const
+{
+    const std::uint32_t sub_list = FindSubList(key);
+    if (sub_list == not_found_)
+    {
+        std::string error_string = "Key \"" + std::string(key) + "\" not found in sub list map.\nExisting keys:";
+        const Node& node = GetNode();
+        for (std::uint32_t i = node.first_child_; i < node.first_child_ + node.n_children_; i++)
+            error_string += "\n    " + std::string(document_->keys_[document_->nodes_[i].key_]);
+        l2a_error(L2A::UTIL::StringStdToAi(error_string));
+    }
+    return FlatParameterList(document_, sub_list);
+}
+
+/**
+ *
+ */
+std::string_view L2A::UTIL::FlatParameterList::GetStringOption(const std::string_view& key) const
+{
+    const std::uint32_t option = FindOption(key);
+    if (option == not_found_)
+    {
+        std::string error_string = "Key \"" + std::string(key) + "\" not found in option map.\nExisting keys:";
+        const Node& node = GetNode();
+        for (std::uint32_t i = node.first_attribute_; i < node.first_attribute_ + node.n_attributes_; i++)
+            error_string += "\n    " + std::string(document_->keys_[document_->attributes_[i].key_]);
+        l2a_error(L2A::UTIL::StringStdToAi(error_string));
+    }
+    return document_->attributes_[option].value_;
+}
+
+/**
+ *
+ */
+int L2A::UTIL::FlatParameterList::GetIntOption(const std::string_view& key) const
+{
+    const std::string_view value = GetStringOption(key);
+    int return_value;
+    const auto result = std::from_chars(value.data(), value.data() + value.size(), return_value);
+    if (result.ec != std::errc() || result.ptr != value.data() + value.size())
+        l2a_error("Integer could not be converted to string!");
+    return return_value;
+}
+
+/**
+ *
+ */
+std::string_view L2A::UTIL::FlatParameterList::GetMainOption() const
+{
+    if (!GetMainOptionSet()) l2a_error("Main option is not set!");
+    return GetNode().main_option_;
+}
+
+/**
+ *
+ */
+L2A::UTIL::ParameterList L2A::UTIL::FlatParameterList::ToParameterList() const
+{
+    L2A::UTIL::ParameterList parameter_list;
+    const Node& node = GetNode();
+    for (std::uint32_t i = node.first_child_; i < node.first_child_ + node.n_children_; i++)
+        parameter_list.SetSubList(L2A::UTIL::StringStdToAi(std::string(document_->keys_[document_->nodes_[i].key_])),
+            FlatParameterList(document_, i).ToParameterList(), true);
+    for (std::uint32_t i = node.first_attribute_; i < node.first_attribute_ + node.n_attributes_; i++)
+    {
+        const Attribute& attribute = document_->attributes_[i];
+        parameter_list.SetOption(L2A::UTIL::StringStdToAi(std::string(document_->keys_[attribute.key_])),
+            L2A::UTIL::StringStdToAi(std::string(attribute.value_)), true);
+    }
+    if (node.main_option_set_)
+        parameter_list.SetMainOption(L2A::UTIL::StringStdToAi(std::string(node.main_option_)));
+    return parameter_list;
+}
+
+/**
+ *
+ */
+std::uint32_t L2A::UTIL::FlatParameterList::FindSubList(const std::string_view& key) const
+{
+    const auto key_index = document_->key_indices_.find(key);
+    if (key_index == document_->key_indices_.end()) return not_found_;
+
+    const Node& node = GetNode();
+    const auto begin = document_->nodes_.begin() + node.first_child_;
+    const auto end = begin + node.n_children_;
+    const auto sub_list = std::lower_bound(
+        begin, end, key_index->second, [](const Node& lhs, const std::uint32_t rhs) { return lhs.key_ < rhs; });
+    if (sub_list == end || sub_list->key_ != key_index->second) return not_found_;
+    return (std::uint32_t)(sub_list - document_->nodes_.begin());
+}
+
+/**
+ *
+ */
+std::uint32_t L2A::UTIL::FlatParameterList::FindOption(const std::string_view& key) const
+{
+    const auto key_index = document_->key_indices_.find(key);
+    if (key_index == document_->key_indices_.end()) return not_found_;
+
+    const Node& node = GetNode();
+    const auto begin = document_->attributes_.begin() + node.first_attribute_;
+    const auto end = begin + node.n_attributes_;
+    const auto option = std::lower_bound(begin, end, key_index->second,
+        [](const Attribute& lhs, const std::uint32_t rhs) { return lhs.key_ < rhs; });
+    if (option == end || option->key_ != key_index->second) return not_found_;
+    return (std::uint32_t)(option - document_->attributes_.begin());
+}
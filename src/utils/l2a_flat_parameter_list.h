@@ -0,0 +1,237 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Flat read-only representation of a parameter list.
+ */
+
+#ifndef UTIL_FLAT_PARAMETER_LIST_H_
+#define UTIL_FLAT_PARAMETER_LIST_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+// Forward declaration.
+namespace tinyxml2
+{
+    class XMLDocument;
+}  // namespace tinyxml2
+namespace L2A
+{
+    namespace UTIL
+    {
+        class ParameterList;
+    }
+}  // namespace L2A
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Read-only parameter list that is created from a XML string.
+         *
+         * Contrary to ParameterList, the nodes and options of the whole document are stored in contiguous vectors
+         * that are owned by one document object. The keys are interned per document and the option values are views
+         * into the parsed XML buffer, so no strings are copied or converted to UTF-16. Each FlatParameterList object
+         * refers to one node in the document, sub lists share the document with their parent. The returned views are
+         * valid as long as any list of the document exists.
+         *
+         * The query functions have the same names and behavior as the ones of ParameterList, but use UTF-8 strings.
+         */
+        class FlatParameterList
+        {
+           public:
+            /**
+             * \brief Create from XML string.
+             */
+            explicit FlatParameterList(const std::string& xml_string);
+
+            /**
+             * \brief Create from XML string.
+             */
+            explicit FlatParameterList(const ai::UnicodeString& xml_string);
+
+            /**
+             * \brief Get number of sublists.
+             */
+            size_t GetNumberOfSubList() const { return GetNode().n_children_; }
+
+            /**
+             * \brief Get a sub list of this parameter list.
+             */
+            FlatParameterList GetSubList(const std::string_view& key) const;
+
+            /**
+             * \brief Check if a sublist with a certain key exists.
+             */
+            bool SubListExists(const std::string_view& key) const { return FindSubList(key) != not_found_; }
+
+            /**
+             * \brief Get number of options.
+             */
+            size_t GetNumberOfOptions() const { return GetNode().n_attributes_; }
+
+            /**
+             * \brief Check if an option exists in this list.
+             */
+            bool OptionExists(const std::string_view& key) const { return FindOption(key) != not_found_; }
+
+            /**
+             * \brief Get string option.
+             */
+            std::string_view GetStringOption(const std::string_view& key) const;
+
+            /**
+             * \brief Get integer option.
+             */
+            int GetIntOption(const std::string_view& key) const;
+
+            /**
+             * \brief Get main option.
+             */
+            std::string_view GetMainOption() const;
+
+            /**
+             * \brief Check if main option is set.
+             */
+            bool GetMainOptionSet() const { return GetNode().main_option_set_; }
+
+            /**
+             * \brief Get the name of the XML element of this list.
+             */
+            std::string_view GetName() const { return document_->keys_[GetNode().key_]; }
+
+            /**
+             * \brief Create a ParameterList with the same contents.
+             */
+            ParameterList ToParameterList() const;
+
+           private:
+            //! Index for entries that do not exist.
+            static constexpr std::uint32_t not_found_ = 0xffffffff;
+
+            /**
+             * \brief A node in the document, i.e., a parameter list. The sub lists and options of a node are stored
+             * contiguously and sorted by their key index.
+             */
+            struct Node
+            {
+                //! Index of the key.
+                std::uint32_t key_;
+
+                //! Sub lists of this node.
+                std::uint32_t first_child_;
+                std::uint32_t n_children_;
+
+                //! Options of this node.
+                std::uint32_t first_attribute_;
+                std::uint32_t n_attributes_;
+
+                //! Main option.
+                std::string_view main_option_;
+                bool main_option_set_;
+            };
+
+            /**
+             * \brief An option in the document.
+             */
+            struct Attribute
+            {
+                //! Index of the key.
+                std::uint32_t key_;
+
+                //! Value of the option.
+                std::string_view value_;
+            };
+
+            /**
+             * \brief Storage for all nodes, options and keys of a XML document.
+             */
+            struct Document
+            {
+                //! Parsed XML document, all strings point to the buffer of this document.
+                std::unique_ptr<tinyxml2::XMLDocument> xml_document_;
+
+                //! Interned keys.
+                std::vector<std::string_view> keys_;
+                std::unordered_map<std::string_view, std::uint32_t> key_indices_;
+
+                //! All nodes, the first one is the root node.
+                std::vector<Node> nodes_;
+
+                //! All options.
+                std::vector<Attribute> attributes_;
+
+                /**
+                 * \brief Destructor, has to be defined where tinyxml2 is known.
+                 */
+                ~Document();
+            };
+
+            /**
+             * \brief Create a list that refers to a node in an existing document.
+             */
+            FlatParameterList(const std::shared_ptr<const Document>& document, const std::uint32_t node)
+                : document_(document), node_(node)
+            {
+            }
+
+            /**
+             * \brief Parse the XML string and fill the document.
+             */
+            void SetFromXML(const char* xml_string, const size_t size);
+
+            /**
+             * \brief Get the node of this list.
+             */
+            const Node& GetNode() const { return document_->nodes_[node_]; }
+
+            /**
+             * \brief Get the index of a sub list node or an option, not_found_ is returned if the key does not exist.
+             */
+            std::uint32_t FindSubList(const std::string_view& key) const;
+            std::uint32_t FindOption(const std::string_view& key) const;
+
+            //! Document that contains this list.
+            std::shared_ptr<const Document> document_;
+
+            //! Index of the node of this list.
+            std::uint32_t node_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
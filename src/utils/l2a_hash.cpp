@@ -0,0 +1,372 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Fast non-cryptographic hash for the pdf file contents.
+ *
+ * This is an implementation of the 64 bit variant of XXH3 by Yann Collet (https://github.com/Cyan4973/xxHash). Only
+ * the unseeded hash with the default secret is implemented. The accumulation loop for long inputs uses SSE2 on x86
+ * processors.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_hash.h"
+
+#include "l2a_base64.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define L2A_HASH_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+namespace
+{
+    //! Primes used by XXH3.
+    constexpr std::uint64_t prime32_1_ = 0x9E3779B1ULL;
+    constexpr std::uint64_t prime32_2_ = 0x85EBCA77ULL;
+    constexpr std::uint64_t prime32_3_ = 0xC2B2AE3DULL;
+    constexpr std::uint64_t prime64_1_ = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t prime64_2_ = 0xC2B2AE3D27D4EB4FULL;
+    constexpr std::uint64_t prime64_3_ = 0x165667B19E3779F9ULL;
+    constexpr std::uint64_t prime64_4_ = 0x85EBCA77C2B2AE63ULL;
+    constexpr std::uint64_t prime64_5_ = 0x27D4EB2F165667C5ULL;
+    constexpr std::uint64_t prime_mx1_ = 0x165667919E3779F9ULL;
+    constexpr std::uint64_t prime_mx2_ = 0x9FB21C651E98DF25ULL;
+
+    //! Default secret of XXH3.
+    constexpr size_t secret_size_ = 192;
+    alignas(64) constexpr unsigned char secret_[secret_size_] = {
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+        0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+        0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+        0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+        0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+        0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+        0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+        0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+        0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e};
+
+    //! Length of a stripe and number of stripes per block for long inputs.
+    constexpr size_t stripe_length_ = 64;
+    constexpr size_t stripes_per_block_ = (secret_size_ - stripe_length_) / 8;
+    constexpr size_t block_length_ = stripe_length_ * stripes_per_block_;
+
+    /**
+     * \brief Read little endian values (all supported platforms are little endian).
+     */
+    inline std::uint32_t Read32(const unsigned char* data)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    inline std::uint64_t Read64(const unsigned char* data)
+    {
+        std::uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    /**
+     * \brief Bit operations.
+     */
+    inline std::uint64_t Rotl64(const std::uint64_t x, const int r) { return (x << r) | (x >> (64 - r)); }
+    inline std::uint64_t XorShift64(const std::uint64_t x, const int shift) { return x ^ (x >> shift); }
+    inline std::uint32_t Swap32(const std::uint32_t x)
+    {
+        return ((x << 24) & 0xff000000) | ((x << 8) & 0x00ff0000) | ((x >> 8) & 0x0000ff00) | ((x >> 24) & 0x000000ff);
+    }
+    inline std::uint64_t Swap64(const std::uint64_t x)
+    {
+        return ((std::uint64_t)Swap32((std::uint32_t)x) << 32) | (std::uint64_t)Swap32((std::uint32_t)(x >> 32));
+    }
+
+    /**
+     * \brief Multiply two 64 bit values to a 128 bit value and fold the result with xor.
+     */
+    inline std::uint64_t Mul128Fold64(const std::uint64_t lhs, const std::uint64_t rhs)
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 product = (unsigned __int128)lhs * (unsigned __int128)rhs;
+        return (std::uint64_t)product ^ (std::uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        std::uint64_t high;
+        const std::uint64_t low = _umul128(lhs, rhs, &high);
+        return low ^ high;
+#else
+        const std::uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+        const std::uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+        const std::uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+        const std::uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+        const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+        const std::uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+        const std::uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+        return lower ^ upper;
+#endif
+    }
+
+    /**
+     * \brief Final mixing steps.
+     */
+    inline std::uint64_t XXH64Avalanche(std::uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= prime64_2_;
+        hash ^= hash >> 29;
+        hash *= prime64_3_;
+        hash ^= hash >> 32;
+        return hash;
+    }
+    inline std::uint64_t XXH3Avalanche(std::uint64_t hash)
+    {
+        hash = XorShift64(hash, 37);
+        hash *= prime_mx1_;
+        return XorShift64(hash, 32);
+    }
+    inline std::uint64_t RRMXMX(std::uint64_t hash, const std::uint64_t length)
+    {
+        hash ^= Rotl64(hash, 49) ^ Rotl64(hash, 24);
+        hash *= prime_mx2_;
+        hash ^= (hash >> 35) + length;
+        hash *= prime_mx2_;
+        return XorShift64(hash, 28);
+    }
+
+    /**
+     * \brief Mix 16 bytes of input with 16 bytes of the secret.
+     */
+    inline std::uint64_t Mix16B(const unsigned char* input, const unsigned char* secret)
+    {
+        return Mul128Fold64(Read64(input) ^ Read64(secret), Read64(input + 8) ^ Read64(secret + 8));
+    }
+
+    /**
+     * \brief Hash for inputs with up to 16 bytes.
+     */
+    std::uint64_t HashLength0To16(const unsigned char* input, const size_t length)
+    {
+        if (length > 8)
+        {
+            const std::uint64_t input_lo = Read64(input) ^ (Read64(secret_ + 24) ^ Read64(secret_ + 32));
+            const std::uint64_t input_hi = Read64(input + length - 8) ^ (Read64(secret_ + 40) ^ Read64(secret_ + 48));
+            const std::uint64_t acc = length + Swap64(input_lo) + input_hi + Mul128Fold64(input_lo, input_hi);
+            return XXH3Avalanche(acc);
+        }
+        else if (length >= 4)
+        {
+            const std::uint64_t input_64 = Read32(input + length - 4) + ((std::uint64_t)Read32(input) << 32);
+            return RRMXMX(input_64 ^ (Read64(secret_ + 8) ^ Read64(secret_ + 16)), length);
+        }
+        else if (length > 0)
+        {
+            const std::uint32_t combined = ((std::uint32_t)input[0] << 16) | ((std::uint32_t)input[length >> 1] << 24) |
+                                           (std::uint32_t)input[length - 1] | ((std::uint32_t)length << 8);
+            return XXH64Avalanche((std::uint64_t)combined ^ (std::uint64_t)(Read32(secret_) ^ Read32(secret_ + 4)));
+        }
+        return XXH64Avalanche(Read64(secret_ + 56) ^ Read64(secret_ + 64));
+    }
+
+    /**
+     * \brief Hash for inputs with 17 to 128 bytes.
+     */
+    std::uint64_t HashLength17To128(const unsigned char* input, const size_t length)
+    {
+        std::uint64_t acc = length * prime64_1_;
+        if (length > 32)
+        {
+            if (length > 64)
+            {
+                if (length > 96)
+                {
+                    acc += Mix16B(input + 48, secret_ + 96);
+                    acc += Mix16B(input + length - 64, secret_ + 112);
+                }
+                acc += Mix16B(input + 32, secret_ + 64);
+                acc += Mix16B(input + length - 48, secret_ + 80);
+            }
+            acc += Mix16B(input + 16, secret_ + 32);
+            acc += Mix16B(input + length - 32, secret_ + 48);
+        }
+        acc += Mix16B(input, secret_);
+        acc += Mix16B(input + length - 16, secret_ + 16);
+        return XXH3Avalanche(acc);
+    }
+
+    /**
+     * \brief Hash for inputs with 129 to 240 bytes.
+     */
+    std::uint64_t HashLength129To240(const unsigned char* input, const size_t length)
+    {
+        std::uint64_t acc = length * prime64_1_;
+        for (size_t i = 0; i < 8; i++) acc += Mix16B(input + 16 * i, secret_ + 16 * i);
+        acc = XXH3Avalanche(acc);
+
+        std::uint64_t acc_end = Mix16B(input + length - 16, secret_ + 136 - 17);
+        const size_t n_rounds = length / 16;
+        for (size_t i = 8; i < n_rounds; i++) acc_end += Mix16B(input + 16 * i, secret_ + 16 * (i - 8) + 3);
+        return XXH3Avalanche(acc + acc_end);
+    }
+
+    /**
+     * \brief Accumulate a stripe of 64 bytes.
+     */
+    inline void Accumulate512(std::uint64_t* acc, const unsigned char* input, const unsigned char* secret)
+    {
+#ifdef L2A_HASH_SSE2
+        __m128i* const acc_vec = (__m128i*)acc;
+        for (size_t i = 0; i < 4; i++)
+        {
+            const __m128i data = _mm_loadu_si128((const __m128i*)input + i);
+            const __m128i key = _mm_loadu_si128((const __m128i*)secret + i);
+            const __m128i data_key = _mm_xor_si128(data, key);
+            const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i product = _mm_mul_epu32(data_key, data_key_hi);
+            const __m128i data_swap = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            acc_vec[i] = _mm_add_epi64(product, _mm_add_epi64(acc_vec[i], data_swap));
+        }
+#else
+        for (size_t i = 0; i < 8; i++)
+        {
+            const std::uint64_t data = Read64(input + 8 * i);
+            const std::uint64_t data_key = data ^ Read64(secret + 8 * i);
+            acc[i ^ 1] += data;
+            acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+        }
+#endif
+    }
+
+    /**
+     * \brief Scramble the accumulators after each block.
+     */
+    inline void ScrambleAccumulators(std::uint64_t* acc, const unsigned char* secret)
+    {
+#ifdef L2A_HASH_SSE2
+        __m128i* const acc_vec = (__m128i*)acc;
+        const __m128i prime = _mm_set1_epi32((int)prime32_1_);
+        for (size_t i = 0; i < 4; i++)
+        {
+            const __m128i shifted = _mm_xor_si128(acc_vec[i], _mm_srli_epi64(acc_vec[i], 47));
+            const __m128i data_key = _mm_xor_si128(shifted, _mm_loadu_si128((const __m128i*)secret + i));
+            const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i product_lo = _mm_mul_epu32(data_key, prime);
+            const __m128i product_hi = _mm_mul_epu32(data_key_hi, prime);
+            acc_vec[i] = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+        }
+#else
+        for (size_t i = 0; i < 8; i++)
+        {
+            std::uint64_t value = XorShift64(acc[i], 47);
+            value ^= Read64(secret + 8 * i);
+            acc[i] = value * prime32_1_;
+        }
+#endif
+    }
+
+    /**
+     * \brief Hash for inputs with more than 240 bytes.
+     */
+    std::uint64_t HashLong(const unsigned char* input, const size_t length)
+    {
+        alignas(16) std::uint64_t acc[8] = {
+            prime32_3_, prime64_1_, prime64_2_, prime64_3_, prime64_4_, prime32_2_, prime64_5_, prime32_1_};
+
+        // Full blocks.
+        const size_t n_blocks = (length - 1) / block_length_;
+        for (size_t i_block = 0; i_block < n_blocks; i_block++)
+        {
+            const unsigned char* block = input + i_block * block_length_;
+            for (size_t i_stripe = 0; i_stripe < stripes_per_block_; i_stripe++)
+                Accumulate512(acc, block + i_stripe * stripe_length_, secret_ + i_stripe * 8);
+            ScrambleAccumulators(acc, secret_ + secret_size_ - stripe_length_);
+        }
+
+        // Last partial block and last stripe.
+        const unsigned char* block = input + n_blocks * block_length_;
+        const size_t n_stripes = ((length - 1) - n_blocks * block_length_) / stripe_length_;
+        for (size_t i_stripe = 0; i_stripe < n_stripes; i_stripe++)
+            Accumulate512(acc, block + i_stripe * stripe_length_, secret_ + i_stripe * 8);
+        Accumulate512(acc, input + length - stripe_length_, secret_ + secret_size_ - stripe_length_ - 7);
+
+        // Merge the accumulators.
+        std::uint64_t result = length * prime64_1_;
+        for (size_t i = 0; i < 4; i++)
+            result += Mul128Fold64(
+                acc[2 * i] ^ Read64(secret_ + 11 + 16 * i), acc[2 * i + 1] ^ Read64(secret_ + 19 + 16 * i));
+        return XXH3Avalanche(result);
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+std::uint64_t L2A::UTIL::XXH3Hash64(const char* data, const size_t size)
+{
+    const unsigned char* input = (const unsigned char*)data;
+    if (size <= 16)
+        return HashLength0To16(input, size);
+    else if (size <= 128)
+        return HashLength17To128(input, size);
+    else if (size <= 240)
+        return HashLength129To240(input, size);
+    else
+        return HashLong(input, size);
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::XXH3HashString(const char* data, const size_t size)
+{
+    std::stringstream buffer;
+    buffer << std::hex << std::setfill('0') << std::setw(16) << XXH3Hash64(data, size);
+    return buffer.str();
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::XXH3HashBase64(const char* encoded, const size_t size)
+{
+    std::string decoded;
+    decoded.reserve(size / 4 * 3 + 3);
+    L2A::UTIL::Base64Decoder decoder;
+    if (!decoder.Append(encoded, size, decoded) || !decoder.Finish(decoded)) return "";
+    return XXH3HashString(decoded.data(), decoded.size());
+}
@@ -0,0 +1,62 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Fast non-cryptographic hash for the pdf file contents.
+ */
+
+#ifndef UTIL_HASH_H_
+#define UTIL_HASH_H_
+
+
+#include <cstdint>
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief 64 bit XXH3 hash of the data (seed 0 and default secret), this gives the same result as XXH3_64bits
+         * from the xxHash library. The function only uses std types, so it can be used outside of the plugin thread.
+         */
+        std::uint64_t XXH3Hash64(const char* data, const size_t size);
+
+        /**
+         * \brief 64 bit XXH3 hash of the data as hexadecimal string with 16 digits.
+         */
+        std::string XXH3HashString(const char* data, const size_t size);
+
+        /**
+         * \brief 64 bit XXH3 hash of the decoded bytes of base64 encoded data as hexadecimal string with 16 digits.
+         * @return Empty string if the data is not valid base64.
+         */
+        std::string XXH3HashBase64(const char* encoded, const size_t size);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
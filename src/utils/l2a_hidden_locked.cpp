@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Cache for the inherited hidden and locked state of art items.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_hidden_locked.h"
+
+#include "l2a_ai_functions.h"
+#include "l2a_error.h"
+#include "l2a_suites.h"
+
+#include <vector>
+
+
+/**
+ *
+ */
+L2A::AI::HiddenLockedCache::HiddenLockedCache()
+    : HiddenLockedCache(
+          [](const AIArtHandle& art_item)
+          {
+              AIArtHandle parent;
+              if (L2A::AI::GetArtParent(art_item, parent))
+                  return parent;
+              else
+                  return AIArtHandle(nullptr);
+          },
+          [](const AIArtHandle& art_item)
+          {
+              ai::int32 attributes;
+              AIErr error = sAIArt->GetArtUserAttr(art_item, kArtLocked | kArtHidden, &attributes);
+              l2a_check_ai_error(error);
+              return std::make_pair((attributes & kArtHidden) != 0, (attributes & kArtLocked) != 0);
+          })
+{
+}
+
+/**
+ *
+ */
+L2A::AI::HiddenLockedCache::HiddenLockedCache(const ParentFunction& get_parent, const AttributeFunction& get_attributes)
+    : get_parent_(get_parent), get_attributes_(get_attributes)
+{
+}
+
+/**
+ *
+ */
+void L2A::AI::HiddenLockedCache::GetIsHiddenLocked(const AIArtHandle& art_item, bool& is_hidden, bool& is_locked)
+{
+    // The state of the item itself is not cached, since it can change without a change of the group structure.
+    const auto [item_hidden, item_locked] = get_attributes_(art_item);
+    const auto [parent_hidden, parent_locked] = GetParentState(art_item);
+    is_hidden = item_hidden || parent_hidden;
+    is_locked = item_locked || parent_locked;
+}
+
+/**
+ *
+ */
+std::pair<bool, bool> L2A::AI::HiddenLockedCache::GetParentState(const AIArtHandle& art_item)
+{
+    // Walk up the parents until a group is found that is already in the cache.
+    std::pair<bool, bool> state = {false, false};
+    std::vector<AIArtHandle> new_groups;
+    for (AIArtHandle parent = get_parent_(art_item); parent != nullptr; parent = get_parent_(parent))
+    {
+        auto cached_state = group_states_.find(parent);
+        if (cached_state != group_states_.end())
+        {
+            state = cached_state->second;
+            break;
+        }
+        new_groups.push_back(parent);
+    }
+
+    // Add the new groups to the cache, starting with the top most one.
+    for (auto group = new_groups.rbegin(); group != new_groups.rend(); group++)
+    {
+        const auto [group_hidden, group_locked] = get_attributes_(*group);
+        state.first = state.first || group_hidden;
+        state.second = state.second || group_locked;
+        group_states_[*group] = state;
+    }
+    return state;
+}
@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Cache for the inherited hidden and locked state of art items.
+ */
+
+#ifndef UTIL_HIDDEN_LOCKED_H_
+#define UTIL_HIDDEN_LOCKED_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <functional>
+#include <map>
+#include <utility>
+
+
+namespace L2A
+{
+    namespace AI
+    {
+        /**
+         * \brief Cache for the hidden and locked state of art items, including the state inherited from the parents.
+         *
+         * The combined state of each group (and layer) is only evaluated once and then stored, so the parent chain of
+         * an item is only walked up to the first group that is already in the cache. The cache has to be invalidated
+         * if the layer or group structure of the document changes.
+         */
+        class HiddenLockedCache
+        {
+           public:
+            //! Function that returns the parent of an art item, or nullptr if the art item has no parent.
+            using ParentFunction = std::function<AIArtHandle(const AIArtHandle&)>;
+
+            //! Function that returns the own hidden and locked attributes of an art item, without the parents.
+            using AttributeFunction = std::function<std::pair<bool, bool>(const AIArtHandle&)>;
+
+            /**
+             * \brief Default constructor, the state is taken from the current Illustrator document.
+             */
+            HiddenLockedCache();
+
+            /**
+             * \brief Constructor with custom functions to access the art tree.
+             */
+            HiddenLockedCache(const ParentFunction& get_parent, const AttributeFunction& get_attributes);
+
+            /**
+             * \brief Check if a item is locked and or hidden, including the parent locked / hidden settings.
+             * @params art_item(in) Art item.
+             * @params is_hidden(out) If the item or any of the parents are hidden.
+             * @params is_locked(out) If the item or any of the parents are locked.
+             */
+            void GetIsHiddenLocked(const AIArtHandle& art_item, bool& is_hidden, bool& is_locked);
+
+            /**
+             * \brief Remove all cached group states.
+             */
+            void Invalidate() { group_states_.clear(); }
+
+            /**
+             * \brief Get the number of groups in the cache.
+             */
+            size_t GetNumberOfCachedGroups() const { return group_states_.size(); }
+
+           private:
+            /**
+             * \brief Get the combined hidden and locked state of all parents of an art item.
+             */
+            std::pair<bool, bool> GetParentState(const AIArtHandle& art_item);
+
+           private:
+            //! Function to get the parent of an art item.
+            ParentFunction get_parent_;
+
+            //! Function to get the attributes of an art item.
+            AttributeFunction get_attributes_;
+
+            //! Combined hidden and locked state of the groups, including the state of their parents.
+            std::map<AIArtHandle, std::pair<bool, bool>> group_states_;
+        };
+    }  // namespace AI
+}  // namespace L2A
+
+#endif
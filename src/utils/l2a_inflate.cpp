@@ -0,0 +1,308 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Decompression of zlib streams, e.g., the FlateDecode streams in pdf files.
+ *
+ * This is a compact implementation of the deflate format (RFC 1951), the Huffman codes are decoded bit by bit with
+ * the canonical code counts, similar to puff.c by Mark Adler (https://github.com/madler/zlib). This is not the
+ * fastest way to inflate data, but the streams we decode (cross reference and object streams) are small.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_inflate.h"
+
+#include <cstdint>
+#include <utility>
+
+
+namespace
+{
+    //! Maximum number of bits in a code.
+    constexpr int max_bits_ = 15;
+
+    //! Number of literal / length and distance codes.
+    constexpr int n_length_codes_ = 288;
+    constexpr int n_distance_codes_ = 30;
+
+    //! Base values and extra bits for the length and distance codes.
+    constexpr std::uint16_t length_base_[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51,
+        59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    constexpr std::uint8_t length_extra_[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    constexpr std::uint16_t distance_base_[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+        513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    constexpr std::uint8_t distance_extra_[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    /**
+     * \brief Read the input bit by bit, starting with the least significant bit of each byte.
+     */
+    struct BitReader
+    {
+        const unsigned char* data_;
+        size_t size_;
+        size_t pos_ = 0;
+        std::uint32_t bit_buffer_ = 0;
+        int n_bits_ = 0;
+        bool out_of_data_ = false;
+
+        /**
+         * \brief Read the given number of bits. If the input ends, zero bits are returned and the error flag is set.
+         */
+        int Bits(const int n)
+        {
+            std::uint32_t value = bit_buffer_;
+            while (n_bits_ < n)
+            {
+                if (pos_ == size_)
+                {
+                    out_of_data_ = true;
+                    return 0;
+                }
+                value |= (std::uint32_t)data_[pos_++] << n_bits_;
+                n_bits_ += 8;
+            }
+            bit_buffer_ = value >> n;
+            n_bits_ -= n;
+            return (int)(value & ((1u << n) - 1));
+        }
+    };
+
+    /**
+     * \brief Canonical Huffman code, given by the number of codes for each length and the symbols ordered by code.
+     */
+    struct Huffman
+    {
+        std::uint16_t count_[max_bits_ + 1];
+        std::uint16_t symbol_[n_length_codes_];
+    };
+
+    /**
+     * \brief Create the Huffman code from the code length of each symbol.
+     * @return False if the code is over-subscribed.
+     */
+    bool BuildHuffman(Huffman& huffman, const std::uint8_t* lengths, const int n_symbols)
+    {
+        for (auto& count : huffman.count_) count = 0;
+        for (int i = 0; i < n_symbols; i++) huffman.count_[lengths[i]]++;
+        if (huffman.count_[0] == n_symbols) return true;
+
+        int left = 1;
+        for (int length = 1; length <= max_bits_; length++)
+        {
+            left = 2 * left - huffman.count_[length];
+            if (left < 0) return false;
+        }
+
+        std::uint16_t offsets[max_bits_ + 1];
+        offsets[1] = 0;
+        for (int length = 1; length < max_bits_; length++)
+            offsets[length + 1] = offsets[length] + huffman.count_[length];
+        for (int i = 0; i < n_symbols; i++)
+            if (lengths[i] != 0) huffman.symbol_[offsets[lengths[i]]++] = (std::uint16_t)i;
+        return true;
+    }
+
+    /**
+     * \brief Decode the next symbol.
+     * @return The symbol or -1 if the input is not a valid code.
+     */
+    int DecodeSymbol(BitReader& reader, const Huffman& huffman)
+    {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int length = 1; length <= max_bits_; length++)
+        {
+            code |= reader.Bits(1);
+            const int count = huffman.count_[length];
+            if (code - count < first) return reader.out_of_data_ ? -1 : huffman.symbol_[index + (code - first)];
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    /**
+     * \brief Decode the symbols of a compressed block until the end of block symbol.
+     */
+    bool InflateCodes(BitReader& reader, const Huffman& length_code, const Huffman& distance_code, std::string& output,
+        const size_t output_begin)
+    {
+        while (true)
+        {
+            int symbol = DecodeSymbol(reader, length_code);
+            if (symbol < 0) return false;
+            if (symbol < 256)
+                output.push_back((char)symbol);
+            else if (symbol == 256)
+                return true;
+            else
+            {
+                // Copy a match from the previous output.
+                symbol -= 257;
+                if (symbol >= 29) return false;
+                const size_t length = length_base_[symbol] + reader.Bits(length_extra_[symbol]);
+                symbol = DecodeSymbol(reader, distance_code);
+                if (symbol < 0 || symbol >= n_distance_codes_) return false;
+                const size_t distance = distance_base_[symbol] + reader.Bits(distance_extra_[symbol]);
+                if (reader.out_of_data_ || distance > output.size() - output_begin) return false;
+                const size_t match = output.size() - distance;
+                for (size_t i = 0; i < length; i++) output.push_back(output[match + i]);
+            }
+        }
+    }
+
+    /**
+     * \brief Read the code lengths of a block with dynamic Huffman codes.
+     */
+    bool ReadDynamicCodes(BitReader& reader, Huffman& length_code, Huffman& distance_code)
+    {
+        static constexpr std::uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        const int n_length = reader.Bits(5) + 257;
+        const int n_distance = reader.Bits(5) + 1;
+        const int n_code = reader.Bits(4) + 4;
+        if (n_length > 286 || n_distance > n_distance_codes_) return false;
+
+        // Code for the code lengths.
+        std::uint8_t lengths[n_length_codes_ + n_distance_codes_] = {};
+        for (int i = 0; i < n_code; i++) lengths[order[i]] = (std::uint8_t)reader.Bits(3);
+        Huffman code_length_code;
+        if (!BuildHuffman(code_length_code, lengths, 19)) return false;
+
+        // Code lengths of the literal / length and distance codes, they are run length encoded.
+        for (int i = 0; i < 19; i++) lengths[i] = 0;
+        int index = 0;
+        while (index < n_length + n_distance)
+        {
+            const int symbol = DecodeSymbol(reader, code_length_code);
+            if (symbol < 0) return false;
+            if (symbol < 16)
+            {
+                lengths[index++] = (std::uint8_t)symbol;
+                continue;
+            }
+
+            std::uint8_t repeated_length = 0;
+            int repeat;
+            if (symbol == 16)
+            {
+                if (index == 0) return false;
+                repeated_length = lengths[index - 1];
+                repeat = 3 + reader.Bits(2);
+            }
+            else if (symbol == 17)
+                repeat = 3 + reader.Bits(3);
+            else
+                repeat = 11 + reader.Bits(7);
+            if (index + repeat > n_length + n_distance) return false;
+            while (repeat-- > 0) lengths[index++] = repeated_length;
+        }
+
+        // The end of block code is required.
+        if (lengths[256] == 0) return false;
+        return BuildHuffman(length_code, lengths, n_length) &&
+               BuildHuffman(distance_code, lengths + n_length, n_distance);
+    }
+
+    /**
+     * \brief Create the fixed Huffman codes.
+     */
+    void BuildFixedCodes(Huffman& length_code, Huffman& distance_code)
+    {
+        std::uint8_t lengths[n_length_codes_];
+        for (int i = 0; i < 144; i++) lengths[i] = 8;
+        for (int i = 144; i < 256; i++) lengths[i] = 9;
+        for (int i = 256; i < 280; i++) lengths[i] = 7;
+        for (int i = 280; i < n_length_codes_; i++) lengths[i] = 8;
+        BuildHuffman(length_code, lengths, n_length_codes_);
+        for (int i = 0; i < n_distance_codes_; i++) lengths[i] = 5;
+        BuildHuffman(distance_code, lengths, n_distance_codes_);
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+bool L2A::UTIL::DecompressZlib(const char* data, const size_t size, std::string& output)
+{
+    // Header with the compression method deflate, the window size and no preset dictionary.
+    if (size < 2) return false;
+    const auto cmf = (unsigned char)data[0];
+    const auto flg = (unsigned char)data[1];
+    if ((cmf & 0x0f) != 8 || (cmf >> 4) > 7 || (256 * cmf + flg) % 31 != 0 || (flg & 0x20) != 0) return false;
+
+    BitReader reader{(const unsigned char*)data + 2, size - 2};
+    const size_t output_begin = output.size();
+    bool is_last_block = false;
+    while (!is_last_block)
+    {
+        is_last_block = reader.Bits(1) == 1;
+        const int block_type = reader.Bits(2);
+        if (reader.out_of_data_) return false;
+
+        if (block_type == 0)
+        {
+            // Stored block, it starts at the next byte.
+            reader.bit_buffer_ = 0;
+            reader.n_bits_ = 0;
+            if (reader.size_ - reader.pos_ < 4) return false;
+            const unsigned char* header = reader.data_ + reader.pos_;
+            const size_t length = header[0] | (header[1] << 8);
+            if ((length ^ (header[2] | (header[3] << 8))) != 0xffff) return false;
+            reader.pos_ += 4;
+            if (reader.size_ - reader.pos_ < length) return false;
+            output.append((const char*)reader.data_ + reader.pos_, length);
+            reader.pos_ += length;
+        }
+        else if (block_type == 1)
+        {
+            static const auto fixed_codes = []()
+            {
+                std::pair<Huffman, Huffman> codes;
+                BuildFixedCodes(codes.first, codes.second);
+                return codes;
+            }();
+            if (!InflateCodes(reader, fixed_codes.first, fixed_codes.second, output, output_begin)) return false;
+        }
+        else if (block_type == 2)
+        {
+            Huffman length_code;
+            Huffman distance_code;
+            if (!ReadDynamicCodes(reader, length_code, distance_code) ||
+                !InflateCodes(reader, length_code, distance_code, output, output_begin))
+                return false;
+        }
+        else
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,53 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Decompression of zlib streams, e.g., the FlateDecode streams in pdf files.
+ */
+
+#ifndef UTIL_INFLATE_H_
+#define UTIL_INFLATE_H_
+
+
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Decompress data in the zlib format (RFC 1950), i.e., a deflate stream (RFC 1951) with a two byte
+         * header. The function only uses std types, so it can be used outside of the plugin thread.
+         *
+         * The checksum at the end of the stream is not checked, as some pdf writers do not write it correctly.
+         * @param output The decompressed data is appended to this string.
+         * @return False if the data is not valid.
+         */
+        bool DecompressZlib(const char* data, const size_t size, std::string& output);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
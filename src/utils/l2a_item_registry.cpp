@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Registry of the LaTeX2AI items in the current document.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_item_registry.h"
+
+
+/**
+ *
+ */
+L2A::AI::ItemRegistry::ItemRegistry()
+    : ItemRegistry([](std::vector<AIArtHandle>& placed_items, SelectionState selected)
+          { L2A::AI::GetItems(placed_items, selected, kPlacedArt); },
+          [](const AIArtHandle& placed_item) { return L2A::AI::IsL2AItem(placed_item); })
+{
+}
+
+/**
+ *
+ */
+L2A::AI::ItemRegistry::ItemRegistry(
+    const GetPlacedItemsFunction& get_placed_items, const IsL2AItemFunction& is_l2a_item)
+    : get_placed_items_(get_placed_items), is_l2a_item_function_(is_l2a_item)
+{
+}
+
+/**
+ *
+ */
+void L2A::AI::ItemRegistry::GetItems(std::vector<AIArtHandle>& l2a_items, SelectionState selected)
+{
+    // Clear the input vector.
+    l2a_items.clear();
+
+    // Get the placed items in the document.
+    std::vector<AIArtHandle> placed_items;
+    get_placed_items_(placed_items, selected);
+
+    // If all items are requested, the results for items that are no longer in the document are dropped.
+    std::map<AIArtHandle, bool> new_is_l2a_item;
+    std::map<AIArtHandle, bool>& stored_is_l2a_item = selected == SelectionState::all ? new_is_l2a_item : is_l2a_item_;
+
+    // Only check the items that are not already in the registry.
+    for (const auto& placed_item : placed_items)
+    {
+        bool is_l2a_item;
+        auto stored_item = is_l2a_item_.find(placed_item);
+        if (stored_item != is_l2a_item_.end())
+            is_l2a_item = stored_item->second;
+        else
+            is_l2a_item = is_l2a_item_function_(placed_item);
+        stored_is_l2a_item[placed_item] = is_l2a_item;
+
+        if (is_l2a_item) l2a_items.push_back(placed_item);
+    }
+
+    if (selected == SelectionState::all) is_l2a_item_.swap(new_is_l2a_item);
+}
@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Registry of the LaTeX2AI items in the current document.
+ */
+
+#ifndef UTIL_ITEM_REGISTRY_H_
+#define UTIL_ITEM_REGISTRY_H_
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_ai_functions.h"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace AI
+    {
+        /**
+         * \brief Registry that stores which placed items in the document are LaTeX2AI items.
+         *
+         * Checking if a placed item is a LaTeX2AI item requires the name of the item. The result of this check is
+         * stored for each art handle, so only new placed items have to be checked. The placed items themselves are
+         * taken from Illustrator for each query, therefore, a query for the selected items only has to look at the
+         * selected placed items.
+         */
+        class ItemRegistry
+        {
+           public:
+            //! Function that returns the placed items in the document with the given selection state.
+            using GetPlacedItemsFunction = std::function<void(std::vector<AIArtHandle>&, SelectionState)>;
+
+            //! Function that checks if a placed item is a LaTeX2AI item.
+            using IsL2AItemFunction = std::function<bool(const AIArtHandle&)>;
+
+            /**
+             * \brief Default constructor, the items are taken from the current Illustrator document.
+             */
+            ItemRegistry();
+
+            /**
+             * \brief Constructor with custom functions to access the document.
+             */
+            ItemRegistry(const GetPlacedItemsFunction& get_placed_items, const IsL2AItemFunction& is_l2a_item);
+
+            /**
+             * \brief Get the LaTeX2AI items in the document.
+             * @param items(out) Vector that will be cleared and filled up with the found items.
+             * @param selected(in) Which selection state should be searched.
+             */
+            void GetItems(std::vector<AIArtHandle>& l2a_items, SelectionState selected);
+
+            /**
+             * \brief Remove all stored results, e.g., if the names of items changed or the document changed.
+             */
+            void Invalidate() { is_l2a_item_.clear(); }
+
+            /**
+             * \brief Remove the stored result for a single item.
+             */
+            void InvalidateItem(const AIArtHandle& placed_item) { is_l2a_item_.erase(placed_item); }
+
+            /**
+             * \brief Get the number of placed items with a stored result.
+             */
+            size_t GetNumberOfRegisteredItems() const { return is_l2a_item_.size(); }
+
+           private:
+            //! Function to get the placed items.
+            GetPlacedItemsFunction get_placed_items_;
+
+            //! Function to check if a placed item is a LaTeX2AI item.
+            IsL2AItemFunction is_l2a_item_function_;
+
+            //! Stored results for the placed items.
+            std::map<AIArtHandle, bool> is_l2a_item_;
+        };
+    }  // namespace AI
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,364 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to manage the pdf files in the links directory.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_links.h"
+
+#include "l2a_file_system.h"
+#include "l2a_hash.h"
+#include "l2a_names.h"
+#include "l2a_parameter_list.h"
+#include "l2a_string_functions.h"
+#include "l2a_trace.h"
+
+#include <unordered_map>
+
+
+/**
+ *
+ */
+L2A::UTIL::LinksLock::LinksLock(const ai::FilePath& links_directory)
+    : FileLock(L2A::UTIL::FilePathAiToStd(links_directory) / L2A::NAMES::links_lock_name_)
+{
+}
+
+/**
+ *
+ */
+L2A::UTIL::LinksManifest L2A::UTIL::ReadLinksManifest(const ai::FilePath& links_directory)
+{
+    LinksManifest manifest;
+
+    ai::FilePath manifest_path = links_directory;
+    manifest_path.AddComponent(ai::UnicodeString(L2A::NAMES::links_manifest_name_));
+    if (!L2A::UTIL::IsFile(manifest_path)) return manifest;
+
+    // An invalid manifest is ignored, it will be overwritten with the next cleanup.
+    const ai::UnicodeString xml_string = L2A::UTIL::ReadFileUTF8(manifest_path);
+    if (!L2A::UTIL::IsValidXML(xml_string)) return manifest;
+    L2A::UTIL::ParameterList manifest_list(xml_string);
+    if (!manifest_list.OptionExists(ai::UnicodeString("links_time"))) return manifest;
+
+    manifest.links_time_ = manifest_list.GetStringOption(ai::UnicodeString("links_time"));
+    for (int i = 0; manifest_list.SubListExists(ai::UnicodeString("document_") + L2A::UTIL::IntegerToString(i)); i++)
+    {
+        const auto document_list =
+            manifest_list.GetSubList(ai::UnicodeString("document_") + L2A::UTIL::IntegerToString(i));
+        const std::string document_name =
+            L2A::UTIL::StringAiToStd(document_list->GetStringOption(ai::UnicodeString("name")));
+        std::set<std::string>& files = manifest.document_files_[document_name];
+        if (document_list->GetMainOptionSet())
+        {
+            for (const auto& file : L2A::UTIL::SplitString(document_list->GetMainOption(), ai::UnicodeString("\n")))
+                if (!file.empty()) files.insert(L2A::UTIL::StringAiToStd(file));
+        }
+    }
+    for (int i = 0; manifest_list.SubListExists(ai::UnicodeString("file_") + L2A::UTIL::IntegerToString(i)); i++)
+    {
+        const auto file_list = manifest_list.GetSubList(ai::UnicodeString("file_") + L2A::UTIL::IntegerToString(i));
+        LinkFileState& state =
+            manifest.file_states_[L2A::UTIL::StringAiToStd(file_list->GetStringOption(ai::UnicodeString("name")))];
+        state.size_ = std::stoull(L2A::UTIL::StringAiToStd(file_list->GetStringOption(ai::UnicodeString("size"))));
+        state.time_ = file_list->GetStringOption(ai::UnicodeString("time"));
+        state.hash_ = L2A::UTIL::StringAiToStd(file_list->GetStringOption(ai::UnicodeString("hash")));
+    }
+    return manifest;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::WriteLinksManifest(const ai::FilePath& links_directory, LinksManifest& manifest)
+{
+    ai::FilePath manifest_path = links_directory;
+    manifest_path.AddComponent(ai::UnicodeString(L2A::NAMES::links_manifest_name_));
+
+    // Creating the manifest changes the write time of the directory, overwriting an existing one does not. Therefore,
+    // the manifest has to exist before the time is stored.
+    if (!L2A::UTIL::IsFile(manifest_path)) L2A::UTIL::WriteFileUTF8(manifest_path, ai::UnicodeString(""));
+    manifest.links_time_ = GetLastWriteTimeString(links_directory);
+
+    L2A::UTIL::ParameterList manifest_list;
+    manifest_list.SetOption(ai::UnicodeString("links_time"), manifest.links_time_);
+    int i = 0;
+    for (const auto& [document_name, files] : manifest.document_files_)
+    {
+        std::string files_string;
+        for (const auto& file : files) files_string += file + "\n";
+
+        std::shared_ptr<L2A::UTIL::ParameterList> document_list =
+            manifest_list.SetSubList(ai::UnicodeString("document_") + L2A::UTIL::IntegerToString(i++));
+        document_list->SetOption(ai::UnicodeString("name"), L2A::UTIL::StringStdToAi(document_name));
+        document_list->SetMainOption(L2A::UTIL::StringStdToAi(files_string));
+    }
+    i = 0;
+    for (const auto& [file_name, state] : manifest.file_states_)
+    {
+        std::shared_ptr<L2A::UTIL::ParameterList> file_list =
+            manifest_list.SetSubList(ai::UnicodeString("file_") + L2A::UTIL::IntegerToString(i++));
+        file_list->SetOption(ai::UnicodeString("name"), L2A::UTIL::StringStdToAi(file_name));
+        file_list->SetOption(ai::UnicodeString("size"), L2A::UTIL::StringStdToAi(std::to_string(state.size_)));
+        file_list->SetOption(ai::UnicodeString("time"), state.time_);
+        file_list->SetOption(ai::UnicodeString("hash"), L2A::UTIL::StringStdToAi(state.hash_));
+    }
+    L2A::UTIL::WriteFileUTF8(manifest_path, manifest_list.ToXMLString(ai::UnicodeString("LaTeX2AI_links")), true);
+    manifest.modified_ = false;
+}
+
+/**
+ *
+ */
+ai::UnicodeString L2A::UTIL::GetLastWriteTimeString(const ai::FilePath& path)
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(L2A::UTIL::FilePathAiToStd(path), ec);
+    if (ec.value() != 0) return ai::UnicodeString("");
+    return L2A::UTIL::StringStdToAi(std::to_string(time.time_since_epoch().count()));
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::IsLinkFileValid(const ai::FilePath& pdf_path, const std::string& hash, LinksManifest& manifest)
+{
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(L2A::UTIL::FilePathAiToStd(pdf_path), ec);
+    if (ec.value() != 0) return false;
+
+    // If the file did not change since its hash was calculated, the file does not have to be read.
+    const auto state = manifest.file_states_.find(L2A::UTIL::StringAiToStd(pdf_path.GetFileName()));
+    if (state != manifest.file_states_.end() && state->second.size_ == size &&
+        state->second.time_ == GetLastWriteTimeString(pdf_path))
+        return state->second.hash_ == hash;
+
+    l2a_trace_scope("IsLinkFileValid::hash");
+    const std::string pdf_data = L2A::UTIL::ReadFileBinary(pdf_path);
+    const std::string file_hash = L2A::UTIL::XXH3HashString(pdf_data.data(), pdf_data.size());
+    SetLinkFileState(pdf_path, file_hash, manifest);
+    return file_hash == hash;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::SetLinkFileState(const ai::FilePath& pdf_path, const std::string& hash, LinksManifest& manifest)
+{
+    std::error_code ec;
+    LinkFileState& state = manifest.file_states_[L2A::UTIL::StringAiToStd(pdf_path.GetFileName())];
+    state.size_ = std::filesystem::file_size(L2A::UTIL::FilePathAiToStd(pdf_path), ec);
+    state.time_ = GetLastWriteTimeString(pdf_path);
+    state.hash_ = hash;
+    manifest.modified_ = true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::IsSharedLinkFile(const std::string& file_name)
+{
+    const std::string pre_fix = L2A::NAMES::pdf_link_pre_fix_;
+    const std::string extension = ".pdf";
+    const size_t hash_length = 16;
+    if (file_name.size() != pre_fix.size() + hash_length + extension.size()) return false;
+    if (file_name.compare(0, pre_fix.size(), pre_fix) != 0) return false;
+    if (file_name.compare(pre_fix.size() + hash_length, extension.size(), extension) != 0) return false;
+    for (size_t i = pre_fix.size(); i < pre_fix.size() + hash_length; i++)
+    {
+        const char character = file_name[i];
+        if (!((character >= '0' && character <= '9') || (character >= 'a' && character <= 'f'))) return false;
+    }
+    return true;
+}
+
+/**
+ *
+ */
+std::map<std::string, unsigned int> L2A::UTIL::CountLinkReferences(const LinksManifest& manifest)
+{
+    std::map<std::string, unsigned int> references;
+    for (const auto& [document_name, files] : manifest.document_files_)
+        for (const auto& file : files) references[file]++;
+    return references;
+}
+
+/**
+ *
+ */
+std::map<std::string, std::set<std::string>> L2A::UTIL::AssignLinkFiles(const std::vector<std::string>& pdf_files,
+    const std::string& document_name, const std::set<std::string>& used_files,
+    const std::vector<std::string>& other_documents)
+{
+    const auto to_lower = [](std::string string)
+    {
+        for (auto& character : string)
+            if (character >= 'A' && character <= 'Z') character = character - 'A' + 'a';
+        return string;
+    };
+
+    // Hash map of the lower case document names.
+    std::unordered_map<std::string, std::string> other_documents_lower;
+    for (const auto& other_document : other_documents) other_documents_lower[to_lower(other_document)] = other_document;
+
+    const std::string post_fix = L2A::NAMES::pdf_item_post_fix_;
+    std::map<std::string, std::set<std::string>> document_files;
+    for (const auto& pdf_file : pdf_files)
+    {
+        std::string owner = "";
+        if (used_files.find(pdf_file) != used_files.end())
+            owner = document_name;
+        else
+        {
+            // The file belongs to another document, if the part in front of one of the post fixes is the name of the
+            // document. If this is the case for multiple documents, the longest name is used.
+            const std::string pdf_file_lower = to_lower(pdf_file);
+            for (size_t pos = pdf_file_lower.find(to_lower(post_fix)); pos != std::string::npos;
+                 pos = pdf_file_lower.find(to_lower(post_fix), pos + 1))
+            {
+                auto other_document = other_documents_lower.find(pdf_file_lower.substr(0, pos));
+                if (other_document != other_documents_lower.end()) owner = other_document->second;
+            }
+        }
+        document_files[owner].insert(pdf_file);
+    }
+    return document_files;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::AddLinkReferences(
+    const ai::FilePath& document_path, const std::vector<ai::FilePath>& pdf_files, LinksManifest& manifest)
+{
+    std::set<std::string>& document_files =
+        manifest.document_files_[L2A::UTIL::StringAiToStd(document_path.GetFileNameNoExt())];
+    for (const auto& pdf_file : pdf_files)
+        if (document_files.insert(L2A::UTIL::StringAiToStd(pdf_file.GetFileName())).second) manifest.modified_ = true;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::CleanUpLinksDirectory(
+    const ai::FilePath& document_path, const std::vector<ai::FilePath>& used_pdf_files, LinksManifest& manifest)
+{
+    l2a_trace_scope("CleanUpLinksDirectory");
+
+    ai::FilePath links_directory = document_path.GetParent();
+    links_directory.AddComponent(ai::UnicodeString(L2A::NAMES::pdf_file_directory_));
+    if (!L2A::UTIL::IsDirectory(links_directory)) return;
+
+    const std::string document_name = L2A::UTIL::StringAiToStd(document_path.GetFileNameNoExt());
+    std::set<std::string> used_files;
+    for (const auto& used_file : used_pdf_files) used_files.insert(L2A::UTIL::StringAiToStd(used_file.GetFileName()));
+
+    // Nothing has to be deleted if neither the links directory nor the files of this document changed since the last
+    // cleanup.
+    const auto manifest_files = manifest.document_files_.find(document_name);
+    if (!manifest.links_time_.empty() && manifest.links_time_ == GetLastWriteTimeString(links_directory) &&
+        manifest_files != manifest.document_files_.end() && manifest_files->second == used_files)
+    {
+        if (manifest.modified_) WriteLinksManifest(links_directory, manifest);
+        return;
+    }
+
+    // Get all pdf files, the shared ones and the ones of previous versions.
+    ai::UnicodeString pattern = ai::UnicodeString(".*") + L2A::NAMES::pdf_link_pre_fix_ + ".*\\.pdf$";
+    std::vector<std::string> pdf_files;
+    for (const auto& pdf_path : L2A::UTIL::FindFilesInFolder(links_directory, pattern))
+        pdf_files.push_back(L2A::UTIL::StringAiToStd(pdf_path.GetFileName()));
+
+    // Get all documents parallel to the current document.
+    pattern = ai::UnicodeString(".*\\.ai$");
+    std::set<std::string> other_documents;
+    for (const auto& ai_file : L2A::UTIL::FindFilesInFolder(document_path.GetParent(), pattern))
+        if (!(document_path == ai_file))
+            other_documents.insert(L2A::UTIL::StringAiToStd(ai_file.GetFileNameNoExt()));
+
+    // Update the references of the current document, documents that no longer exist release their references.
+    manifest.document_files_[document_name] = used_files;
+    for (auto document = manifest.document_files_.begin(); document != manifest.document_files_.end();)
+    {
+        if (document->first != document_name && other_documents.find(document->first) == other_documents.end())
+            document = manifest.document_files_.erase(document);
+        else
+            ++document;
+    }
+
+    // Documents that are not in the manifest can use shared files, e.g., if they were copied into the folder. Their
+    // links are only known after they are saved, so unreferenced shared files are kept until then. Files of previous
+    // versions that are not referenced can belong to these documents, this is checked with the name of the file.
+    std::vector<std::string> untracked_documents;
+    for (const auto& other_document : other_documents)
+        if (manifest.document_files_.find(other_document) == manifest.document_files_.end())
+            untracked_documents.push_back(other_document);
+    const std::map<std::string, unsigned int> references = CountLinkReferences(manifest);
+    std::vector<std::string> unused_files;
+    std::vector<std::string> legacy_files;
+    std::set<std::string> existing_files;
+    for (const auto& pdf_file : pdf_files)
+    {
+        if (references.find(pdf_file) != references.end())
+            existing_files.insert(pdf_file);
+        else if (!IsSharedLinkFile(pdf_file))
+            legacy_files.push_back(pdf_file);
+        else if (untracked_documents.empty())
+            unused_files.push_back(pdf_file);
+        else
+            existing_files.insert(pdf_file);
+    }
+    for (const auto& [owner, files] : AssignLinkFiles(legacy_files, document_name, {}, untracked_documents))
+    {
+        if (owner.empty())
+            unused_files.insert(unused_files.end(), files.begin(), files.end());
+        else
+        {
+            manifest.document_files_[owner] = files;
+            existing_files.insert(files.begin(), files.end());
+        }
+    }
+
+    // Delete the files that are not referenced by any document.
+    for (const auto& unused_file : unused_files)
+    {
+        ai::FilePath unused_path = links_directory;
+        unused_path.AddComponent(L2A::UTIL::StringStdToAi(unused_file));
+        L2A::UTIL::RemoveFile(unused_path);
+    }
+
+    // Store the current state of the directory. States of files that no longer exist are removed.
+    for (auto state = manifest.file_states_.begin(); state != manifest.file_states_.end();)
+    {
+        if (existing_files.find(state->first) == existing_files.end())
+            state = manifest.file_states_.erase(state);
+        else
+            ++state;
+    }
+    WriteLinksManifest(links_directory, manifest);
+}
@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to manage the pdf files in the links directory.
+ */
+
+#ifndef UTIL_LINKS_H_
+#define UTIL_LINKS_H_
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_compile_cache.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief State of a pdf file in the links directory when its hash was last calculated.
+         */
+        struct LinkFileState
+        {
+            //! Size of the file in bytes.
+            std::uintmax_t size_ = 0;
+
+            //! Last write time of the file.
+            ai::UnicodeString time_;
+
+            //! Hash of the encoded file contents (same hash as stored in the property).
+            std::string hash_;
+        };
+
+        /**
+         * \brief Manifest of the links directory. It stores which pdf files are referenced by each document and the
+         * hashes of the pdf files.
+         *
+         * The pdf files are content addressed, i.e., items with the same pdf file share one file in the links
+         * directory, also across the documents in the folder. The reference count of a file is the number of
+         * documents that reference it.
+         */
+        struct LinksManifest
+        {
+            //! Last write time of the links directory when the manifest was written.
+            ai::UnicodeString links_time_;
+
+            //! Names of the pdf files referenced by each document. The key is the document name without the file
+            //! extension.
+            std::map<std::string, std::set<std::string>> document_files_;
+
+            //! States of the pdf files in the links directory.
+            std::map<std::string, LinkFileState> file_states_;
+
+            //! Flag if the manifest was modified since it was read.
+            bool modified_ = false;
+        };
+
+        /**
+         * \brief Lock of a links directory. The manifest and the pdf files are shared by all documents in the folder,
+         * also by documents that are opened in other Illustrator instances. The lock has to be held around each
+         * read-modify-write of the manifest and around the cleanup of the directory. The directory has to exist.
+         */
+        class LinksLock : public FileLock
+        {
+           public:
+            /**
+             * \brief Constructor, this blocks until the lock is obtained.
+             */
+            explicit LinksLock(const ai::FilePath& links_directory);
+        };
+
+        /**
+         * \brief Read the manifest of a links directory. If no valid manifest exists, an empty one is returned.
+         */
+        LinksManifest ReadLinksManifest(const ai::FilePath& links_directory);
+
+        /**
+         * \brief Write the manifest of a links directory. The last write time of the directory is set in the
+         * manifest.
+         */
+        void WriteLinksManifest(const ai::FilePath& links_directory, LinksManifest& manifest);
+
+        /**
+         * \brief Get the last write time of a file or directory as a string. An empty string is returned if the time
+         * can not be obtained.
+         */
+        ai::UnicodeString GetLastWriteTimeString(const ai::FilePath& path);
+
+        /**
+         * \brief Check if a pdf file in the links directory exists and has the given hash. If the size and write time
+         * of the file match the state stored in the manifest, the file is not read.
+         * @param pdf_path Path to the pdf file.
+         * @param hash Expected hash of the encoded file contents.
+         * @param manifest Manifest of the links directory, the state of the file is updated if it was read.
+         */
+        bool IsLinkFileValid(const ai::FilePath& pdf_path, const std::string& hash, LinksManifest& manifest);
+
+        /**
+         * \brief Store the current state of a pdf file in the manifest, e.g., after it was written.
+         */
+        void SetLinkFileState(const ai::FilePath& pdf_path, const std::string& hash, LinksManifest& manifest);
+
+        /**
+         * \brief Check if a file in the links directory is a shared pdf file, i.e., its name is the prefix followed by
+         * the hash of the pdf file.
+         */
+        bool IsSharedLinkFile(const std::string& file_name);
+
+        /**
+         * \brief Count the references to the pdf files, i.e., the number of documents that use each file.
+         */
+        std::map<std::string, unsigned int> CountLinkReferences(const LinksManifest& manifest);
+
+        /**
+         * \brief Assign the pdf files in the links directory to the documents they belong to. This is done with the
+         * name of the file, and is only required for files of previous versions that are not shared.
+         * @param pdf_files Names of the pdf files in the links directory.
+         * @param document_name Name of the current document.
+         * @param used_files Names of the pdf files used by the current document.
+         * @param other_documents Names of the other Illustrator documents in the folder (without the file extension).
+         * The names are compared case insensitive (for ASCII characters).
+         * @return Files for each document. Files that do not belong to any document are returned with an empty key.
+         */
+        std::map<std::string, std::set<std::string>> AssignLinkFiles(const std::vector<std::string>& pdf_files,
+            const std::string& document_name, const std::set<std::string>& used_files,
+            const std::vector<std::string>& other_documents);
+
+        /**
+         * \brief Add references of a document to pdf files in the links directory. This has to be done when pdf files
+         * are written for new or changed items. Otherwise the references of the document are only updated when it is
+         * saved, and the cleanup of another document in the folder could delete the files of unsaved items.
+         * @param document_path Path to the document.
+         * @param pdf_files Pdf files used by the document, existing references of the document are kept.
+         * @param manifest Manifest of the links directory, it is marked as modified if a reference was added.
+         */
+        void AddLinkReferences(
+            const ai::FilePath& document_path, const std::vector<ai::FilePath>& pdf_files, LinksManifest& manifest);
+
+        /**
+         * \brief Update the references of the current document and delete all pdf files in the links directory that
+         * are no longer referenced.
+         *
+         * Documents that no longer exist in the folder release their references. Files of previous versions are
+         * kept, if their name belongs to an Illustrator document in the folder that is not yet in the manifest.
+         *
+         * If the links directory did not change since the last call and the current document still uses the same
+         * files, the directory is not scanned again.
+         *
+         * Illustrator documents in the folder that are not in the manifest, e.g., documents that were copied into the
+         * folder, can use shared pdf files. Therefore, unreferenced shared pdf files are only deleted if all
+         * documents in the folder are in the manifest.
+         *
+         * The caller has to hold the LinksLock of the directory, since the manifest was read before.
+         *
+         * @param document_path Path to the current document.
+         * @param used_pdf_files Pdf files used by the current document.
+         * @param manifest Manifest of the links directory, it is written if anything changed.
+         */
+        void CleanUpLinksDirectory(const ai::FilePath& document_path, const std::vector<ai::FilePath>& used_pdf_files,
+            LinksManifest& manifest);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
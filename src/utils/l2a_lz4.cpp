@@ -0,0 +1,226 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Fast compression of binary data.
+ *
+ * This is an implementation of the LZ4 block format by Yann Collet (https://github.com/lz4/lz4), i.e., the output can
+ * be decompressed with the reference implementation and vice versa. The compressor is a greedy single pass matcher
+ * with a hash table of the last positions of 4 byte sequences, similar to the fast mode of the reference
+ * implementation.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_lz4.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    //! The last match has to start at least this number of bytes before the end of the data.
+    constexpr size_t match_limit_ = 12;
+
+    //! The last bytes of the data are always literals.
+    constexpr size_t last_literals_ = 5;
+
+    //! Minimum length of a match.
+    constexpr size_t min_match_ = 4;
+
+    //! Maximum offset of a match.
+    constexpr size_t max_offset_ = 65535;
+
+    //! Number of bits of the hash table size.
+    constexpr int hash_bits_ = 14;
+
+    /**
+     * \brief Read 4 bytes.
+     */
+    std::uint32_t Read32(const unsigned char* data)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    /**
+     * \brief Hash of the 4 bytes at a position.
+     */
+    std::uint32_t Hash4(const unsigned char* data) { return (Read32(data) * 2654435761u) >> (32 - hash_bits_); }
+
+    /**
+     * \brief Append a length that does not fit into the token.
+     */
+    void AppendLength(size_t length, std::string& output)
+    {
+        while (length >= 255)
+        {
+            output.push_back((char)255);
+            length -= 255;
+        }
+        output.push_back((char)length);
+    }
+
+    /**
+     * \brief Append a sequence of literals followed by a match. The match is omitted for the last sequence.
+     */
+    void AppendSequence(const unsigned char* literals, const size_t n_literals, const size_t offset,
+        const size_t match_length, std::string& output)
+    {
+        const size_t literal_token = n_literals < 15 ? n_literals : 15;
+        const size_t match_token = offset == 0 ? 0 : (match_length - min_match_ < 15 ? match_length - min_match_ : 15);
+        output.push_back((char)((literal_token << 4) | match_token));
+        if (literal_token == 15) AppendLength(n_literals - 15, output);
+        output.append((const char*)literals, n_literals);
+        if (offset == 0) return;
+        output.push_back((char)(offset & 0xff));
+        output.push_back((char)(offset >> 8));
+        if (match_token == 15) AppendLength(match_length - min_match_ - 15, output);
+    }
+
+    /**
+     * \brief Read a length that does not fit into the token.
+     */
+    bool ReadLength(const unsigned char*& position, const unsigned char* end, size_t& length)
+    {
+        unsigned char byte;
+        do
+        {
+            if (position >= end) return false;
+            byte = *position++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+void L2A::UTIL::CompressLZ4(const char* data, const size_t size, std::string& output)
+{
+    const unsigned char* input = (const unsigned char*)data;
+    output.reserve(output.size() + size + size / 255 + 16);
+
+    size_t anchor = 0;
+    if (size > match_limit_)
+    {
+        // Positions are stored with an offset of 1, so 0 marks an empty entry.
+        std::vector<std::uint32_t> hash_table((size_t)1 << hash_bits_, 0);
+        const size_t match_end = size - match_limit_;
+        const size_t copy_end = size - last_literals_;
+        size_t position = 0;
+        size_t n_misses = 0;
+        while (position < match_end)
+        {
+            const std::uint32_t hash = Hash4(input + position);
+            const size_t candidate = hash_table[hash];
+            hash_table[hash] = (std::uint32_t)(position + 1);
+            if (candidate == 0 || position + 1 - candidate > max_offset_ ||
+                Read32(input + candidate - 1) != Read32(input + position))
+            {
+                // Skip faster through data that does not compress.
+                position += 1 + (n_misses++ >> 6);
+                continue;
+            }
+            n_misses = 0;
+
+            // Extend the match backwards into the literals and forwards as long as possible.
+            size_t match = candidate - 1;
+            while (position > anchor && match > 0 && input[position - 1] == input[match - 1])
+            {
+                position--;
+                match--;
+            }
+            size_t match_length = min_match_;
+            while (position + match_length < copy_end && input[position + match_length] == input[match + match_length])
+                match_length++;
+
+            AppendSequence(input + anchor, position - anchor, position - match, match_length, output);
+            position += match_length;
+            anchor = position;
+            if (position < match_end) hash_table[Hash4(input + position - 2)] = (std::uint32_t)(position - 1);
+        }
+    }
+
+    AppendSequence(input + anchor, size - anchor, 0, 0, output);
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::DecompressLZ4(const char* data, const size_t size, const size_t decompressed_size, std::string& output)
+{
+    const unsigned char* position = (const unsigned char*)data;
+    const unsigned char* end = position + size;
+    const size_t output_begin = output.size();
+    output.resize(output_begin + decompressed_size);
+    char* out = &output[0] + output_begin;
+    size_t out_position = 0;
+
+    while (position < end)
+    {
+        const unsigned char token = *position++;
+
+        // Literals.
+        size_t n_literals = token >> 4;
+        if (n_literals == 15 && !ReadLength(position, end, n_literals)) break;
+        if (n_literals > (size_t)(end - position) || n_literals > decompressed_size - out_position) break;
+        std::memcpy(out + out_position, position, n_literals);
+        position += n_literals;
+        out_position += n_literals;
+
+        // The last sequence only contains literals.
+        if (position == end)
+        {
+            if (out_position != decompressed_size) break;
+            return true;
+        }
+
+        // Match, it can overlap with the output that is written, therefore it is copied byte by byte if the offset is
+        // small.
+        if (end - position < 2) break;
+        const size_t offset = position[0] | (position[1] << 8);
+        position += 2;
+        size_t match_length = token & 15;
+        if (match_length == 15 && !ReadLength(position, end, match_length)) break;
+        match_length += min_match_;
+        if (offset == 0 || offset > out_position || match_length > decompressed_size - out_position) break;
+        const char* match = out + out_position - offset;
+        if (offset >= match_length)
+            std::memcpy(out + out_position, match, match_length);
+        else
+            for (size_t i = 0; i < match_length; i++) out[out_position + i] = match[i];
+        out_position += match_length;
+    }
+
+    output.resize(output_begin);
+    return false;
+}
@@ -0,0 +1,58 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Fast compression of binary data.
+ */
+
+#ifndef UTIL_LZ4_H_
+#define UTIL_LZ4_H_
+
+
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Compress the data in the LZ4 block format. The function only uses std types, so it can be used
+         * outside of the plugin thread.
+         * @param output The compressed data is appended to this string.
+         */
+        void CompressLZ4(const char* data, const size_t size, std::string& output);
+
+        /**
+         * \brief Decompress data in the LZ4 block format.
+         * @param decompressed_size Size of the uncompressed data, this has to be stored next to the compressed data.
+         * @param output The decompressed data is appended to this string.
+         * @return False if the data is not valid or does not have the given size.
+         */
+        bool DecompressLZ4(const char* data, const size_t size, const size_t decompressed_size, std::string& output);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Read-only memory mapping of a file.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_mapped_file.h"
+
+#ifndef WIN_ENV
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ *
+ */
+L2A::UTIL::MappedFile::MappedFile(const std::filesystem::path& path) : data_(nullptr), size_(0), is_open_(false)
+{
+#ifdef WIN_ENV
+    mapping_handle_ = nullptr;
+    file_handle_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle_ == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle_, &file_size)) return;
+
+    // Empty files can not be mapped.
+    const size_t size = (size_t)file_size.QuadPart;
+    if (size == 0)
+    {
+        is_open_ = true;
+        return;
+    }
+    mapping_handle_ = CreateFileMappingW(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle_ == nullptr) return;
+    data_ = (const char*)MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0);
+#else
+    file_descriptor_ = open(path.c_str(), O_RDONLY);
+    if (file_descriptor_ < 0) return;
+    struct stat file_status;
+    if (fstat(file_descriptor_, &file_status) != 0) return;
+
+    // Empty files can not be mapped.
+    const size_t size = (size_t)file_status.st_size;
+    if (size == 0)
+    {
+        is_open_ = true;
+        return;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+    if (data == MAP_FAILED) return;
+    data_ = (const char*)data;
+#endif
+    if (data_ == nullptr) return;
+    size_ = size;
+    is_open_ = true;
+}
+
+/**
+ *
+ */
+L2A::UTIL::MappedFile::~MappedFile()
+{
+#ifdef WIN_ENV
+    if (data_ != nullptr) UnmapViewOfFile(data_);
+    if (mapping_handle_ != nullptr) CloseHandle(mapping_handle_);
+    if (file_handle_ != INVALID_HANDLE_VALUE) CloseHandle(file_handle_);
+#else
+    if (data_ != nullptr) munmap((void*)data_, size_);
+    if (file_descriptor_ >= 0) close(file_descriptor_);
+#endif
+}
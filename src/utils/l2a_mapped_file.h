@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Read-only memory mapping of a file.
+ */
+
+#ifndef UTIL_MAPPED_FILE_H_
+#define UTIL_MAPPED_FILE_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <filesystem>
+#include <string_view>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Map a file into memory for reading, the mapping is removed when the object is destroyed. Only std
+         * types are used in the interface, so the class can be used outside of the plugin thread.
+         *
+         * The contents are read by the operating system when they are accessed, so parsers that only look at parts of
+         * a file (e.g. the end of a pdf file) do not have to read the whole file.
+         */
+        class MappedFile
+        {
+           public:
+            /**
+             * \brief Constructor, the file is mapped. If this fails, the object is not open.
+             */
+            explicit MappedFile(const std::filesystem::path& path);
+
+            /**
+             * \brief Destructor, the mapping is removed.
+             */
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * \brief Check if the file could be mapped.
+             */
+            bool IsOpen() const { return is_open_; }
+
+            /**
+             * \brief Get a view of the contents of the file. The view is only valid as long as this object exists.
+             */
+            std::string_view View() const { return std::string_view(data_, size_); }
+
+           private:
+#ifdef WIN_ENV
+            //! Handles of the file and the mapping.
+            HANDLE file_handle_;
+            HANDLE mapping_handle_;
+#else
+            //! File descriptor of the file.
+            int file_descriptor_;
+#endif
+
+            //! Mapped contents of the file.
+            const char* data_;
+            size_t size_;
+
+            //! Flag if the file was mapped.
+            bool is_open_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,83 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Functions to execute independent tasks in parallel.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_parallel.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ *
+ */
+void L2A::UTIL::ParallelFor(const size_t n_tasks, const std::function<void(size_t)>& task, unsigned int n_threads)
+{
+    if (n_threads == 0) n_threads = std::thread::hardware_concurrency();
+    if (n_threads > n_tasks) n_threads = (unsigned int)n_tasks;
+    if (n_threads <= 1)
+    {
+        for (size_t i = 0; i < n_tasks; i++) task(i);
+        return;
+    }
+
+    // Each thread takes the next open task until all tasks are taken.
+    std::atomic<size_t> next_task(0);
+    std::exception_ptr exception = nullptr;
+    std::mutex exception_mutex;
+    const auto worker = [&]()
+    {
+        for (size_t i = next_task++; i < n_tasks; i = next_task++)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (exception == nullptr) exception = std::current_exception();
+                next_task = n_tasks;
+            }
+        }
+    };
+
+    // The calling thread also works on the tasks.
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < n_threads; i++) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    if (exception != nullptr) std::rethrow_exception(exception);
+}
@@ -0,0 +1,58 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Functions to execute independent tasks in parallel.
+ */
+
+#ifndef UTIL_PARALLEL_H_
+#define UTIL_PARALLEL_H_
+
+
+#include <functional>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Execute a task for each index in [0, n_tasks) on a set of worker threads. The function returns after
+         * all tasks are finished.
+         *
+         * The tasks are executed on other threads than the plugin thread, therefore they must not call any functions of
+         * the Illustrator SDK (this also includes ai::UnicodeString and ai::FilePath). If a task throws an exception,
+         * the remaining tasks are skipped and the first exception is rethrown on the calling thread.
+         *
+         * @param n_tasks Number of tasks.
+         * @param task Function that is called with the index of each task.
+         * @param n_threads Maximum number of threads (including the calling thread). If this is 0, the number of
+         * hardware threads is used.
+         */
+        void ParallelFor(const size_t n_tasks, const std::function<void(size_t)>& task, unsigned int n_threads = 0);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
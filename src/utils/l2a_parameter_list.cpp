@@ -35,6 +35,8 @@
 
 #include "l2a_error.h"
 #include "l2a_string_functions.h"
+#include "l2a_xml_reader.h"
+#include "l2a_xml_writer.h"
 
 
 /**
@@ -60,6 +62,36 @@ L2A::UTIL::ParameterList::ParameterList(const tinyxml2::XMLElement* xml_element)
     SetFromXML(xml_element);
 }
 
+/**
+ *
+ */
+L2A::UTIL::ParameterList::ParameterList(L2A::UTIL::XMLReader& reader) : UTIL::ParameterList()
+{
+    // As in SetFromXML, the main option is only set if the text is the first child of the element.
+    bool is_first_child = true;
+    for (auto event = reader.Next(); event != L2A::UTIL::XMLReader::Event::end_element; event = reader.Next())
+    {
+        if (event == L2A::UTIL::XMLReader::Event::attribute)
+        {
+            SetOption(L2A::UTIL::StringStdToAi(std::string(reader.GetName())),
+                L2A::UTIL::StringStdToAi(std::string(reader.GetValue())), true);
+        }
+        else if (event == L2A::UTIL::XMLReader::Event::start_element)
+        {
+            const auto name = L2A::UTIL::StringStdToAi(std::string(reader.GetName()));
+            SetSubList(name, std::make_shared<ParameterList>(reader), true);
+            is_first_child = false;
+        }
+        else if (event == L2A::UTIL::XMLReader::Event::text)
+        {
+            if (is_first_child) SetMainOption(L2A::UTIL::StringStdToAi(std::string(reader.GetValue())));
+            is_first_child = false;
+        }
+        else
+            l2a_error("Unexpected end of the XML document.");
+    }
+}
+
 /**
  *
  */
@@ -239,18 +271,20 @@ ai::UnicodeString L2A::UTIL::ParameterList::GetMainOption() const
  */
 ai::UnicodeString L2A::UTIL::ParameterList::ToXMLString(const ai::UnicodeString& root_name) const
 {
-    // We need to populate an xml object with all data in this parameter list.
-    tinyxml2::XMLDocument xml_doc;
-    tinyxml2::XMLElement* root_element = xml_doc.NewElement(L2A::UTIL::StringAiToStd(root_name).c_str());
-    xml_doc.InsertFirstChild(root_element);
-
-    // Fill in the contents of the parameter lists.
-    ToXML(&xml_doc, root_element);
+    return L2A::UTIL::StringStdToAi(ToXMLStringUTF8(root_name));
+}
 
-    // Return the string from the xml file.
-    tinyxml2::XMLPrinter printer;
-    xml_doc.Accept(&printer);
-    return L2A::UTIL::StringStdToAi(printer.CStr());
+/**
+ *
+ */
+std::string L2A::UTIL::ParameterList::ToXMLStringUTF8(const ai::UnicodeString& root_name) const
+{
+    // The XML is written directly into the pre-sized output string.
+    std::string xml_string;
+    xml_string.reserve(XMLSizeEstimate(root_name, 0));
+    L2A::UTIL::XMLWriter writer(xml_string);
+    ToXML(writer, root_name);
+    return xml_string;
 }
 
 /**
@@ -322,28 +356,37 @@ bool L2A::UTIL::ParameterList::operator==(const L2A::UTIL::ParameterList& other)
 /**
  *
  */
-void L2A::UTIL::ParameterList::ToXML(tinyxml2::XMLDocument* xml_doc, tinyxml2::XMLElement* this_xml_element) const
+void L2A::UTIL::ParameterList::ToXML(L2A::UTIL::XMLWriter& writer, const ai::UnicodeString& name) const
 {
-    // Loop overchild elements and create them.
-    for (auto const& sub_list_it : sub_lists_)
-    {
-        tinyxml2::XMLElement* xml_sub_list = xml_doc->NewElement(L2A::UTIL::StringAiToStd(sub_list_it.first).c_str());
-        sub_list_it.second->ToXML(xml_doc, xml_sub_list);
-        this_xml_element->InsertEndChild(xml_sub_list);
-    }
+    writer.OpenElement(L2A::UTIL::StringAiToStd(name));
 
     // Loop over parameters.
     for (auto const& parameters_it : options_map_)
-    {
-        this_xml_element->SetAttribute(L2A::UTIL::StringAiToStd(parameters_it.first).c_str(),
-            L2A::UTIL::StringAiToStd(parameters_it.second).c_str());
-    }
+        writer.PushAttribute(
+            L2A::UTIL::StringAiToStd(parameters_it.first), L2A::UTIL::StringAiToStd(parameters_it.second));
 
-    if (main_option_set_)
-    {
-        // Set main option.
-        this_xml_element->SetText(L2A::UTIL::StringAiToStd(main_option_).c_str());
-    }
+    // Loop over child elements.
+    for (auto const& sub_list_it : sub_lists_) sub_list_it.second->ToXML(writer, sub_list_it.first);
+
+    // Set main option.
+    if (main_option_set_) writer.PushText(L2A::UTIL::StringAiToStd(main_option_));
+
+    writer.CloseElement();
+}
+
+/**
+ *
+ */
+size_t L2A::UTIL::ParameterList::XMLSizeEstimate(const ai::UnicodeString& name, const size_t depth) const
+{
+    // Indentation, start and end tag.
+    size_t size = 4 * depth + 2 * name.length() + 6;
+    for (auto const& parameters_it : options_map_)
+        size += parameters_it.first.length() + parameters_it.second.length() + 4;
+    for (auto const& sub_list_it : sub_lists_)
+        size += sub_list_it.second->XMLSizeEstimate(sub_list_it.first, depth + 1);
+    if (main_option_set_) size += main_option_.length();
+    return size;
 }
 
 /**
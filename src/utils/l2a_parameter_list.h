@@ -33,12 +33,12 @@
 #include "IllustratorSDK.h"
 
 #include <map>
+#include <string>
 
 
 // Forward declaration.
 namespace tinyxml2
 {
-    class XMLDocument;
     class XMLElement;
 }  // namespace tinyxml2
 
@@ -47,6 +47,10 @@ namespace L2A
 {
     namespace UTIL
     {
+        // Forward declaration.
+        class XMLReader;
+        class XMLWriter;
+
         /**
          * \brief Class to manage parameters. Each object can have multiple parameters stored with keys and one main
          * parameter. Also each object can have several sub lists stored with keys.
@@ -74,6 +78,12 @@ namespace L2A
              */
             ParameterList(const tinyxml2::XMLElement* xml_element);
 
+            /**
+             * \brief Constructor from the current element of a XML reader, i.e., directly after its start_element
+             * event. The reader is advanced to the end of the element.
+             */
+            explicit ParameterList(XMLReader& reader);
+
             /**
              * \brief Destructor.
              */
@@ -195,6 +205,12 @@ namespace L2A
              */
             ai::UnicodeString ToXMLString(const ai::UnicodeString& root_name) const;
 
+            /**
+             * \brief Return a UTF-8 encoded XML string representing all options in this object. This is the same
+             * string as returned by ToXMLString without the conversion to the Illustrator string type.
+             */
+            std::string ToXMLStringUTF8(const ai::UnicodeString& root_name) const;
+
             /**
              * \brief Check if an option exists in this list.
              */
@@ -231,9 +247,15 @@ namespace L2A
             void SetFromXML(const tinyxml2::XMLElement* xml_element);
 
             /**
-             * \brief Convert this parameter list and all its children to a xml document.
+             * \brief Write this parameter list and all its children as element with the given name.
+             */
+            void ToXML(XMLWriter& writer, const ai::UnicodeString& name) const;
+
+            /**
+             * \brief Estimate the size of the XML string of this parameter list and all its children. This is exact
+             * for ASCII strings without characters that have to be escaped.
              */
-            void ToXML(tinyxml2::XMLDocument* xml_doc, tinyxml2::XMLElement* this_xml_element) const;
+            size_t XMLSizeEstimate(const ai::UnicodeString& name, const size_t depth) const;
 
             //! Sublists with options.
             std::map<ai::UnicodeString, std::shared_ptr<ParameterList>> sub_lists_;
@@ -0,0 +1,214 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Text encodings for binary payloads that are stored in item notes.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_payload.h"
+
+#include "l2a_base64.h"
+#include "l2a_lz4.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+
+namespace
+{
+    //! Magic bytes at the beginning of a compact payload.
+    constexpr char compact_magic_[] = "L2AP";
+
+    //! Current version of the compact payload format.
+    constexpr unsigned char compact_version_ = 1;
+
+    //! Size of the header of a compact payload.
+    constexpr size_t compact_header_size_ = 16;
+
+    //! Codecs for the payload data.
+    constexpr unsigned char codec_stored_ = 0;
+    constexpr unsigned char codec_lz4_ = 1;
+
+    //! LZ4 can not compress data by more than this factor.
+    constexpr size_t lz4_max_ratio_ = 255;
+
+    //! Base85 alphabet, these are the printable ASCII characters without &<>"' and the backslash.
+    constexpr char base85_alphabet_[] =
+        "!#$%()*+,-./0123456789:;=?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[]^_`abcdefghijklmnopqrstuvwxyz{";
+
+    //! Values in the decode table for characters that are skipped or invalid.
+    constexpr int base85_whitespace_ = -1;
+    constexpr int base85_invalid_ = -2;
+
+    /**
+     * \brief Create the table to decode base85 characters.
+     */
+    std::array<int, 256> Base85DecodeTable()
+    {
+        std::array<int, 256> table;
+        table.fill(base85_invalid_);
+        for (int i = 0; i < 85; i++) table[(unsigned char)base85_alphabet_[i]] = i;
+        for (const char character : {' ', '\n', '\r', '\t'}) table[(unsigned char)character] = base85_whitespace_;
+        return table;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+std::string L2A::UTIL::EncodePayload(const PayloadEncoding encoding, const char* data, const size_t size)
+{
+    std::string encoded;
+    if (encoding == PayloadEncoding::base64)
+    {
+        encoded.reserve(Base64Encoder::EncodedLength(size));
+        Base64Encoder encoder;
+        encoder.Append(data, size, encoded);
+        encoder.Finish(encoded);
+        return encoded;
+    }
+
+    // Compressed pdf streams do not compress much further, the data is stored if compression does not help.
+    std::string binary(compact_header_size_, '\0');
+    std::memcpy(&binary[0], compact_magic_, 4);
+    binary[4] = (char)compact_version_;
+    for (size_t i = 0; i < 8; i++) binary[8 + i] = (char)(((std::uint64_t)size >> (8 * i)) & 0xff);
+    CompressLZ4(data, size, binary);
+    if (binary.size() - compact_header_size_ < size)
+        binary[5] = (char)codec_lz4_;
+    else
+    {
+        binary.resize(compact_header_size_);
+        binary.append(data, size);
+        binary[5] = (char)codec_stored_;
+    }
+
+    encoded.reserve(Base85EncodedLength(binary.size()));
+    Base85Encode(binary.data(), binary.size(), encoded);
+    return encoded;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::DecodePayload(
+    const PayloadEncoding encoding, const char* encoded, const size_t size, std::string& output)
+{
+    if (encoding == PayloadEncoding::base64)
+    {
+        Base64Decoder decoder;
+        return decoder.Append(encoded, size, output) && decoder.Finish(output);
+    }
+
+    std::string binary;
+    binary.reserve(size / 5 * 4 + 4);
+    if (!Base85Decode(encoded, size, binary)) return false;
+    if (binary.size() < compact_header_size_ || std::memcmp(binary.data(), compact_magic_, 4) != 0) return false;
+    if ((unsigned char)binary[4] > compact_version_) return false;
+
+    std::uint64_t payload_size = 0;
+    for (size_t i = 0; i < 8; i++) payload_size |= (std::uint64_t)(unsigned char)binary[8 + i] << (8 * i);
+    const char* data = binary.data() + compact_header_size_;
+    const size_t data_size = binary.size() - compact_header_size_;
+    switch ((unsigned char)binary[5])
+    {
+        case codec_stored_:
+            if (payload_size != data_size) return false;
+            output.append(data, data_size);
+            return true;
+        case codec_lz4_:
+            // Check the size before it is allocated, so corrupted headers are rejected.
+            if (payload_size > lz4_max_ratio_ * data_size) return false;
+            return DecompressLZ4(data, data_size, (size_t)payload_size, output);
+        default:
+            return false;
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::Base85Encode(const char* data, const size_t size, std::string& output)
+{
+    const unsigned char* input = (const unsigned char*)data;
+    const size_t output_begin = output.size();
+    output.resize(output_begin + Base85EncodedLength(size));
+    char* out = &output[0] + output_begin;
+
+    for (size_t i = 0; i < size; i += 4)
+    {
+        // The last group is padded with zeros.
+        const size_t n_bytes = size - i < 4 ? size - i : 4;
+        std::uint32_t value = 0;
+        for (size_t j = 0; j < 4; j++) value = (value << 8) | (j < n_bytes ? input[i + j] : 0);
+
+        char digits[5];
+        for (int j = 4; j >= 0; j--)
+        {
+            digits[j] = base85_alphabet_[value % 85];
+            value /= 85;
+        }
+        std::memcpy(out, digits, n_bytes + 1);
+        out += n_bytes + 1;
+    }
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::Base85Decode(const char* data, const size_t size, std::string& output)
+{
+    static const std::array<int, 256> decode_table = Base85DecodeTable();
+
+    std::uint64_t value = 0;
+    size_t n_digits = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        const int digit = decode_table[(unsigned char)data[i]];
+        if (digit == base85_whitespace_) continue;
+        if (digit == base85_invalid_) return false;
+        value = value * 85 + digit;
+        if (++n_digits == 5)
+        {
+            if (value > 0xffffffffu) return false;
+            for (int shift = 24; shift >= 0; shift -= 8) output.push_back((char)((value >> shift) & 0xff));
+            value = 0;
+            n_digits = 0;
+        }
+    }
+
+    // The last group is padded with the largest digit, a single remaining digit can not be valid.
+    if (n_digits == 0) return true;
+    if (n_digits == 1) return false;
+    for (size_t j = n_digits; j < 5; j++) value = value * 85 + 84;
+    if (value > 0xffffffffu) return false;
+    for (size_t j = 0; j < n_digits - 1; j++) output.push_back((char)((value >> (24 - 8 * j)) & 0xff));
+    return true;
+}
@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Text encodings for binary payloads that are stored in item notes.
+ */
+
+#ifndef UTIL_PAYLOAD_H_
+#define UTIL_PAYLOAD_H_
+
+
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Text encoding of a binary payload.
+         */
+        enum class PayloadEncoding
+        {
+            //! Base64 text of the payload, used by previous versions.
+            base64,
+            //! Versioned header and LZ4 compressed payload, encoded with base85.
+            compact
+        };
+
+        /**
+         * \brief Encode a binary payload as text.
+         *
+         * The compact encoding consists of a 16 byte header ("L2AP", format version, codec, two reserved bytes and
+         * the payload size as 64 bit little endian integer) followed by the payload, which is compressed with LZ4 if
+         * this reduces its size. The result is encoded with base85. The function only uses std types, so it can be
+         * used outside of the plugin thread.
+         */
+        std::string EncodePayload(const PayloadEncoding encoding, const char* data, const size_t size);
+
+        /**
+         * \brief Decode a payload that was encoded with EncodePayload.
+         * @param output The decoded payload is appended to this string.
+         * @return False if the encoded payload is not valid.
+         */
+        bool DecodePayload(const PayloadEncoding encoding, const char* encoded, const size_t size, std::string& output);
+
+        /**
+         * \brief Encode data with base85, i.e., 4 bytes are encoded with 5 characters. The alphabet does not contain
+         * characters that have to be escaped in XML (&<>"') or the backslash. Trailing bytes are encoded with one
+         * character more than the number of bytes.
+         * @param output The encoded characters are appended to this string.
+         */
+        void Base85Encode(const char* data, const size_t size, std::string& output);
+
+        /**
+         * \brief Decode base85 data, whitespace characters are skipped.
+         * @param output The decoded bytes are appended to this string.
+         * @return False if the data contains invalid characters or is truncated.
+         */
+        bool Base85Decode(const char* data, const size_t size, std::string& output);
+
+        /**
+         * \brief Get the length of the base85 encoded string for a given number of bytes.
+         */
+        inline size_t Base85EncodedLength(const size_t size)
+        {
+            return (size / 4) * 5 + (size % 4 == 0 ? 0 : size % 4 + 1);
+        }
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,1089 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+
+/**
+ * \brief Read the page boxes and other metadata of pdf files without Illustrator or Ghostscript.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_pdf_info.h"
+
+#include "l2a_inflate.h"
+#include "l2a_mapped_file.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+
+
+namespace
+{
+    //! Maximal nesting depth of pdf objects and of object lookups, deeper structures are treated as corrupt.
+    constexpr unsigned int max_depth_ = 64;
+
+    /**
+     * \brief Object in the pdf syntax. Streams are dictionaries with the position of the stream data in the file.
+     */
+    struct PdfObject
+    {
+        enum class Type
+        {
+            null,
+            boolean,
+            number,
+            string,
+            name,
+            array,
+            dictionary,
+            reference,
+            stream
+        };
+
+        Type type_ = Type::null;
+
+        //! Value of booleans and numbers.
+        double number_ = 0.0;
+
+        //! Value of strings and names.
+        std::string string_;
+
+        //! Elements of arrays and values of dictionaries.
+        std::vector<PdfObject> values_;
+
+        //! Keys of dictionaries.
+        std::vector<std::string> keys_;
+
+        //! Referenced object number.
+        std::uint32_t reference_ = 0;
+
+        //! Offset of the stream data in the file.
+        size_t stream_begin_ = 0;
+
+        /**
+         * \brief Return the value for a key of a dictionary or stream, or nullptr if it does not exist.
+         */
+        const PdfObject* Get(const std::string_view& key) const
+        {
+            for (size_t i = 0; i < keys_.size(); i++)
+                if (keys_[i] == key) return &values_[i];
+            return nullptr;
+        }
+
+        /**
+         * \brief Check if the object is a dictionary or stream.
+         */
+        bool IsDictionary() const { return type_ == Type::dictionary || type_ == Type::stream; }
+
+        /**
+         * \brief Check if the object is a non negative integer.
+         */
+        bool IsIndex() const { return type_ == Type::number && number_ >= 0.0 && number_ == (std::uint64_t)number_; }
+    };
+
+    /**
+     * \brief Check if a character is a white space in the pdf syntax.
+     */
+    bool IsPdfWhiteSpace(const char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\0';
+    }
+
+    /**
+     * \brief Check if a character is a delimiter or white space in the pdf syntax, i.e., it ends names and keywords.
+     */
+    bool IsPdfDelimiter(const char c)
+    {
+        return IsPdfWhiteSpace(c) || c == '(' || c == ')' || c == '<' || c == '>' || c == '[' || c == ']' ||
+               c == '{' || c == '}' || c == '/' || c == '%';
+    }
+
+    /**
+     * \brief Return the value of a hexadecimal digit or -1 if the character is not one.
+     */
+    int HexValue(const char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    /**
+     * \brief Advance the position past white spaces and comments.
+     */
+    void SkipWhiteSpace(const std::string_view& data, size_t& pos)
+    {
+        while (pos < data.size())
+        {
+            if (data[pos] == '%')
+                while (pos < data.size() && data[pos] != '\n' && data[pos] != '\r') pos++;
+            else if (IsPdfWhiteSpace(data[pos]))
+                pos++;
+            else
+                break;
+        }
+    }
+
+    /**
+     * \brief Check if the keyword is at the position and advance the position past it.
+     */
+    bool ReadKeyword(const std::string_view& data, size_t& pos, const std::string_view& keyword)
+    {
+        if (data.compare(pos, keyword.size(), keyword) != 0) return false;
+        if (pos + keyword.size() < data.size() && !IsPdfDelimiter(data[pos + keyword.size()])) return false;
+        pos += keyword.size();
+        return true;
+    }
+
+    /**
+     * \brief Read a non negative integer at the position and advance the position past it.
+     */
+    bool ReadInteger(const std::string_view& data, size_t& pos, std::uint64_t& value)
+    {
+        const size_t start = pos;
+        value = 0;
+        while (pos < data.size() && data[pos] >= '0' && data[pos] <= '9')
+        {
+            if (value > 1000000000000000) return false;
+            value = 10 * value + (std::uint64_t)(data[pos] - '0');
+            pos++;
+        }
+        return pos > start;
+    }
+
+    /**
+     * \brief Read a number, the pdf syntax has no exponents. Own implementation, as the std functions depend on the
+     * locale.
+     */
+    bool ReadNumber(const std::string_view& data, size_t& pos, double& value, bool& is_integer)
+    {
+        const size_t start = pos;
+        double sign = 1.0;
+        if (pos < data.size() && (data[pos] == '+' || data[pos] == '-')) sign = data[pos++] == '-' ? -1.0 : 1.0;
+
+        value = 0.0;
+        is_integer = true;
+        bool has_digits = false;
+        double factor = 1.0;
+        for (; pos < data.size(); pos++)
+        {
+            if (data[pos] >= '0' && data[pos] <= '9')
+            {
+                if (is_integer)
+                    value = 10.0 * value + (data[pos] - '0');
+                else
+                    value += (factor *= 0.1) * (data[pos] - '0');
+                has_digits = true;
+            }
+            else if (data[pos] == '.' && is_integer)
+                is_integer = false;
+            else
+                break;
+        }
+        value *= sign;
+        if (!has_digits) pos = start;
+        return has_digits;
+    }
+
+    /**
+     * \brief Read a literal string, the position is at the opening parenthesis.
+     */
+    bool ReadLiteralString(const std::string_view& data, size_t& pos, std::string& value)
+    {
+        unsigned int n_open = 1;
+        for (pos++; pos < data.size(); pos++)
+        {
+            const char c = data[pos];
+            if (c == '(')
+                n_open++;
+            else if (c == ')' && --n_open == 0)
+            {
+                pos++;
+                return true;
+            }
+            else if (c == '\\' && pos + 1 < data.size())
+            {
+                const char escaped = data[++pos];
+                if (escaped >= '0' && escaped <= '7')
+                {
+                    // Octal character code with up to three digits.
+                    unsigned int code = 0;
+                    for (unsigned int i = 0; i < 3 && pos < data.size() && data[pos] >= '0' && data[pos] <= '7'; i++)
+                        code = 8 * code + (data[pos++] - '0');
+                    value.push_back((char)code);
+                    pos--;
+                    continue;
+                }
+                switch (escaped)
+                {
+                    case 'n':
+                        value.push_back('\n');
+                        break;
+                    case 'r':
+                        value.push_back('\r');
+                        break;
+                    case 't':
+                        value.push_back('\t');
+                        break;
+                    case 'b':
+                        value.push_back('\b');
+                        break;
+                    case 'f':
+                        value.push_back('\f');
+                        break;
+                    case '\r':
+                        // Line continuation.
+                        if (pos + 1 < data.size() && data[pos + 1] == '\n') pos++;
+                        break;
+                    case '\n':
+                        break;
+                    default:
+                        value.push_back(escaped);
+                }
+                continue;
+            }
+            value.push_back(c);
+        }
+        return false;
+    }
+
+    /**
+     * \brief Read a hexadecimal string, the position is at the opening angle bracket.
+     */
+    bool ReadHexString(const std::string_view& data, size_t& pos, std::string& value)
+    {
+        int high = -1;
+        for (pos++; pos < data.size(); pos++)
+        {
+            if (data[pos] == '>')
+            {
+                // A missing last digit is zero.
+                if (high >= 0) value.push_back((char)(high << 4));
+                pos++;
+                return true;
+            }
+            if (IsPdfWhiteSpace(data[pos])) continue;
+            const int digit = HexValue(data[pos]);
+            if (digit < 0) return false;
+            if (high < 0)
+                high = digit;
+            else
+            {
+                value.push_back((char)((high << 4) | digit));
+                high = -1;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * \brief Read a name, the position is at the slash.
+     */
+    bool ReadName(const std::string_view& data, size_t& pos, std::string& value)
+    {
+        for (pos++; pos < data.size() && !IsPdfDelimiter(data[pos]); pos++)
+        {
+            if (data[pos] == '#' && pos + 2 < data.size() && HexValue(data[pos + 1]) >= 0 &&
+                HexValue(data[pos + 2]) >= 0)
+            {
+                value.push_back((char)((HexValue(data[pos + 1]) << 4) | HexValue(data[pos + 2])));
+                pos += 2;
+            }
+            else
+                value.push_back(data[pos]);
+        }
+        return true;
+    }
+
+    /**
+     * \brief Read a direct object and advance the position past it.
+     */
+    bool ReadObject(const std::string_view& data, size_t& pos, PdfObject& object, const unsigned int depth = 0)
+    {
+        if (depth > max_depth_) return false;
+        SkipWhiteSpace(data, pos);
+        if (pos >= data.size()) return false;
+
+        object = PdfObject();
+        const char c = data[pos];
+        if (c == '/')
+        {
+            object.type_ = PdfObject::Type::name;
+            return ReadName(data, pos, object.string_);
+        }
+        else if (c == '(')
+        {
+            object.type_ = PdfObject::Type::string;
+            return ReadLiteralString(data, pos, object.string_);
+        }
+        else if (c == '<' && pos + 1 < data.size() && data[pos + 1] == '<')
+        {
+            object.type_ = PdfObject::Type::dictionary;
+            pos += 2;
+            while (true)
+            {
+                SkipWhiteSpace(data, pos);
+                if (data.compare(pos, 2, ">>") == 0)
+                {
+                    pos += 2;
+                    return true;
+                }
+                if (pos >= data.size() || data[pos] != '/') return false;
+                object.keys_.emplace_back();
+                ReadName(data, pos, object.keys_.back());
+                object.values_.emplace_back();
+                if (!ReadObject(data, pos, object.values_.back(), depth + 1)) return false;
+            }
+        }
+        else if (c == '<')
+        {
+            object.type_ = PdfObject::Type::string;
+            return ReadHexString(data, pos, object.string_);
+        }
+        else if (c == '[')
+        {
+            object.type_ = PdfObject::Type::array;
+            pos++;
+            while (true)
+            {
+                SkipWhiteSpace(data, pos);
+                if (pos < data.size() && data[pos] == ']')
+                {
+                    pos++;
+                    return true;
+                }
+                object.values_.emplace_back();
+                if (!ReadObject(data, pos, object.values_.back(), depth + 1)) return false;
+            }
+        }
+        else if ((c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.')
+        {
+            bool is_integer;
+            object.type_ = PdfObject::Type::number;
+            if (!ReadNumber(data, pos, object.number_, is_integer)) return false;
+
+            // An integer followed by another integer and "R" is a reference.
+            if (is_integer && c != '+' && c != '-')
+            {
+                size_t reference_pos = pos;
+                std::uint64_t generation;
+                SkipWhiteSpace(data, reference_pos);
+                if (ReadInteger(data, reference_pos, generation))
+                {
+                    SkipWhiteSpace(data, reference_pos);
+                    if (ReadKeyword(data, reference_pos, "R") && object.number_ < 4294967296.0)
+                    {
+                        object.type_ = PdfObject::Type::reference;
+                        object.reference_ = (std::uint32_t)object.number_;
+                        pos = reference_pos;
+                    }
+                }
+            }
+            return true;
+        }
+        else if (ReadKeyword(data, pos, "true"))
+        {
+            object.type_ = PdfObject::Type::boolean;
+            object.number_ = 1.0;
+            return true;
+        }
+        else if (ReadKeyword(data, pos, "false"))
+        {
+            object.type_ = PdfObject::Type::boolean;
+            return true;
+        }
+        else if (ReadKeyword(data, pos, "null"))
+            return true;
+        return false;
+    }
+
+    /**
+     * \brief Undo the PNG predictors (10 to 15) of a decoded stream. Each row starts with a byte for the filter type.
+     */
+    bool UndoPngPredictor(std::string& data, const size_t colors, const size_t bits_per_component, const size_t columns)
+    {
+        const size_t bytes_per_pixel = std::max((size_t)1, (colors * bits_per_component + 7) / 8);
+        const size_t row_size = (colors * bits_per_component * columns + 7) / 8;
+        if (row_size == 0 || data.size() % (row_size + 1) != 0) return false;
+
+        std::string result(data.size() / (row_size + 1) * row_size, '\0');
+        const unsigned char* row_data = (const unsigned char*)data.data();
+        unsigned char* row = (unsigned char*)result.data();
+        const unsigned char* previous_row = nullptr;
+        for (size_t i_row = 0; i_row < result.size() / row_size; i_row++)
+        {
+            const unsigned char filter = *row_data++;
+            for (size_t i = 0; i < row_size; i++)
+            {
+                const int left = i >= bytes_per_pixel ? row[i - bytes_per_pixel] : 0;
+                const int up = previous_row != nullptr ? previous_row[i] : 0;
+                const int up_left =
+                    i >= bytes_per_pixel && previous_row != nullptr ? previous_row[i - bytes_per_pixel] : 0;
+                int prediction;
+                switch (filter)
+                {
+                    case 0:
+                        prediction = 0;
+                        break;
+                    case 1:
+                        prediction = left;
+                        break;
+                    case 2:
+                        prediction = up;
+                        break;
+                    case 3:
+                        prediction = (left + up) / 2;
+                        break;
+                    case 4:
+                    {
+                        const int estimate = left + up - up_left;
+                        const int distance_left = std::abs(estimate - left);
+                        const int distance_up = std::abs(estimate - up);
+                        const int distance_up_left = std::abs(estimate - up_left);
+                        if (distance_left <= distance_up && distance_left <= distance_up_left)
+                            prediction = left;
+                        else if (distance_up <= distance_up_left)
+                            prediction = up;
+                        else
+                            prediction = up_left;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                row[i] = (unsigned char)(row_data[i] + prediction);
+            }
+            row_data += row_size;
+            previous_row = row;
+            row += row_size;
+        }
+        data = std::move(result);
+        return true;
+    }
+
+    /**
+     * \brief Convert a pdf text string to UTF-8. Text strings are either UTF-16BE with a byte order mark or in the
+     * PDFDocEncoding, which is treated as Latin-1 here (they only differ in rarely used characters).
+     */
+    std::string TextStringToUTF8(const std::string& text)
+    {
+        std::string utf8;
+        const auto append_code_point = [&utf8](const std::uint32_t code_point)
+        {
+            if (code_point < 0x80)
+                utf8.push_back((char)code_point);
+            else if (code_point < 0x800)
+            {
+                utf8.push_back((char)(0xC0 | (code_point >> 6)));
+                utf8.push_back((char)(0x80 | (code_point & 0x3F)));
+            }
+            else if (code_point < 0x10000)
+            {
+                utf8.push_back((char)(0xE0 | (code_point >> 12)));
+                utf8.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                utf8.push_back((char)(0x80 | (code_point & 0x3F)));
+            }
+            else
+            {
+                utf8.push_back((char)(0xF0 | (code_point >> 18)));
+                utf8.push_back((char)(0x80 | ((code_point >> 12) & 0x3F)));
+                utf8.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                utf8.push_back((char)(0x80 | (code_point & 0x3F)));
+            }
+        };
+
+        if (text.size() >= 2 && (unsigned char)text[0] == 0xFE && (unsigned char)text[1] == 0xFF)
+        {
+            for (size_t i = 2; i + 1 < text.size(); i += 2)
+            {
+                std::uint32_t code_unit = ((unsigned char)text[i] << 8) | (unsigned char)text[i + 1];
+                if (code_unit >= 0xD800 && code_unit < 0xDC00 && i + 3 < text.size())
+                {
+                    const std::uint32_t low = ((unsigned char)text[i + 2] << 8) | (unsigned char)text[i + 3];
+                    if (low >= 0xDC00 && low < 0xE000)
+                    {
+                        code_unit = 0x10000 + ((code_unit - 0xD800) << 10) + (low - 0xDC00);
+                        i += 2;
+                    }
+                }
+                append_code_point(code_unit);
+            }
+        }
+        else
+            for (const char c : text) append_code_point((unsigned char)c);
+        return utf8;
+    }
+
+    /**
+     * \brief Random access to the objects of a pdf file via its cross reference sections.
+     */
+    class PdfReader
+    {
+       public:
+        /**
+         * \brief Constructor.
+         */
+        explicit PdfReader(const std::string_view& data) : data_(data) {}
+
+        /**
+         * \brief Read all cross reference sections, starting at the last one in the file.
+         */
+        bool ReadCrossReferences();
+
+        /**
+         * \brief Return the trailer dictionary of the last cross reference section.
+         */
+        const PdfObject& GetTrailer() const { return trailer_; }
+
+        /**
+         * \brief Return the object if it is not a reference, otherwise return the referenced object. References to
+         * objects that do not exist are null objects.
+         */
+        bool Resolve(const PdfObject& object, PdfObject& resolved, const unsigned int depth = 0);
+
+        /**
+         * \brief Get the decoded data of a stream. Only the FlateDecode filter is supported.
+         */
+        bool GetStreamData(const PdfObject& stream, std::string& stream_data, const unsigned int depth = 0);
+
+       private:
+        /**
+         * \brief Entry of the cross reference sections.
+         */
+        struct XRefEntry
+        {
+            //! True if the object is in an object stream.
+            bool compressed_ = false;
+
+            //! Offset in the file, or object number of the object stream.
+            std::uint64_t offset_ = 0;
+
+            //! Index in the object stream.
+            std::uint64_t index_ = 0;
+        };
+
+        /**
+         * \brief Decoded object stream.
+         */
+        struct ObjectStream
+        {
+            std::string data_;
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> objects_;
+        };
+
+        /**
+         * \brief Read a cross reference table, the position is after the "xref" keyword.
+         */
+        bool ReadXRefTable(size_t pos, PdfObject& trailer);
+
+        /**
+         * \brief Read a cross reference stream at the offset.
+         */
+        bool ReadXRefStream(const std::uint64_t offset, PdfObject& trailer);
+
+        /**
+         * \brief Read the indirect object at the offset in the file.
+         */
+        bool ReadIndirectObject(const std::uint64_t offset, PdfObject& object, const unsigned int depth);
+
+        /**
+         * \brief Get an object from an object stream.
+         */
+        bool ReadCompressedObject(const XRefEntry& entry, PdfObject& object, const unsigned int depth);
+
+        /**
+         * \brief Add an entry, entries from newer sections are read first and take precedence.
+         */
+        void AddEntry(const std::uint64_t number, const XRefEntry& entry)
+        {
+            if (number < 4294967296) entries_.emplace((std::uint32_t)number, entry);
+        }
+
+        //! Data of the pdf file.
+        std::string_view data_;
+
+        //! Trailer of the last cross reference section.
+        PdfObject trailer_;
+
+        //! Locations of the objects in use.
+        std::map<std::uint32_t, XRefEntry> entries_;
+
+        //! Decoded object streams.
+        std::map<std::uint64_t, std::unique_ptr<ObjectStream>> object_streams_;
+    };
+
+    /**
+     *
+     */
+    bool PdfReader::ReadCrossReferences()
+    {
+        // The offset of the last cross reference section is given after the last "startxref".
+        const size_t search_begin = data_.size() > 1024 ? data_.size() - 1024 : 0;
+        const size_t startxref_pos = data_.rfind("startxref");
+        if (startxref_pos == std::string_view::npos || startxref_pos < search_begin) return false;
+        size_t pos = startxref_pos + 9;
+        std::uint64_t offset;
+        SkipWhiteSpace(data_, pos);
+        if (!ReadInteger(data_, pos, offset)) return false;
+
+        // Follow the chain of previous sections, the set prevents infinite loops in corrupt files.
+        std::set<std::uint64_t> visited_offsets;
+        bool is_last_section = true;
+        while (true)
+        {
+            if (offset >= data_.size() || !visited_offsets.insert(offset).second) return false;
+
+            PdfObject trailer;
+            pos = (size_t)offset;
+            if (ReadKeyword(data_, pos, "xref"))
+            {
+                if (!ReadXRefTable(pos, trailer)) return false;
+
+                // Hybrid files have an additional cross reference stream for the objects in object streams.
+                const PdfObject* xref_stream = trailer.Get("XRefStm");
+                PdfObject xref_stream_trailer;
+                if (xref_stream != nullptr && xref_stream->IsIndex() &&
+                    !ReadXRefStream((std::uint64_t)xref_stream->number_, xref_stream_trailer))
+                    return false;
+            }
+            else if (!ReadXRefStream(offset, trailer))
+                return false;
+
+            if (is_last_section) trailer_ = trailer;
+            is_last_section = false;
+
+            const PdfObject* previous = trailer.Get("Prev");
+            if (previous == nullptr || !previous->IsIndex()) break;
+            offset = (std::uint64_t)previous->number_;
+        }
+        return trailer_.Get("Root") != nullptr;
+    }
+
+    /**
+     *
+     */
+    bool PdfReader::ReadXRefTable(size_t pos, PdfObject& trailer)
+    {
+        while (true)
+        {
+            SkipWhiteSpace(data_, pos);
+            if (ReadKeyword(data_, pos, "trailer")) break;
+
+            // Subsection with the first object number and the number of entries. Each entry has 20 characters.
+            std::uint64_t first_object;
+            std::uint64_t n_entries;
+            if (!ReadInteger(data_, pos, first_object)) return false;
+            SkipWhiteSpace(data_, pos);
+            if (!ReadInteger(data_, pos, n_entries)) return false;
+            if (n_entries > (data_.size() - pos) / 20) return false;
+
+            for (std::uint64_t i = 0; i < n_entries; i++)
+            {
+                std::uint64_t offset;
+                std::uint64_t generation;
+                SkipWhiteSpace(data_, pos);
+                if (!ReadInteger(data_, pos, offset)) return false;
+                SkipWhiteSpace(data_, pos);
+                if (!ReadInteger(data_, pos, generation)) return false;
+                SkipWhiteSpace(data_, pos);
+                if (pos >= data_.size()) return false;
+                const char type = data_[pos++];
+                if (type == 'n')
+                    AddEntry(first_object + i, XRefEntry{false, offset, 0});
+                else if (type != 'f')
+                    return false;
+            }
+        }
+        return ReadObject(data_, pos, trailer) && trailer.type_ == PdfObject::Type::dictionary;
+    }
+
+    /**
+     *
+     */
+    bool PdfReader::ReadXRefStream(const std::uint64_t offset, PdfObject& trailer)
+    {
+        std::string stream_data;
+        if (!ReadIndirectObject(offset, trailer, 0) || trailer.type_ != PdfObject::Type::stream) return false;
+        const PdfObject* type = trailer.Get("Type");
+        if (type == nullptr || type->string_ != "XRef" || !GetStreamData(trailer, stream_data)) return false;
+
+        // Widths of the three fields of each entry.
+        const PdfObject* widths = trailer.Get("W");
+        if (widths == nullptr || widths->type_ != PdfObject::Type::array || widths->values_.size() != 3) return false;
+        size_t field_widths[3];
+        size_t entry_size = 0;
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            if (!widths->values_[i].IsIndex() || widths->values_[i].number_ > 8) return false;
+            field_widths[i] = (size_t)widths->values_[i].number_;
+            entry_size += field_widths[i];
+        }
+        if (entry_size == 0) return false;
+
+        // Subsections given by pairs of first object number and number of entries, the default is all objects.
+        std::vector<std::uint64_t> subsections;
+        const PdfObject* index = trailer.Get("Index");
+        const PdfObject* size = trailer.Get("Size");
+        if (index != nullptr && index->type_ == PdfObject::Type::array)
+        {
+            for (const auto& value : index->values_)
+            {
+                if (!value.IsIndex()) return false;
+                subsections.push_back((std::uint64_t)value.number_);
+            }
+        }
+        else if (size != nullptr && size->IsIndex())
+            subsections = {0, (std::uint64_t)size->number_};
+        if (subsections.size() % 2 != 0) return false;
+
+        size_t pos = 0;
+        for (size_t i_subsection = 0; i_subsection < subsections.size(); i_subsection += 2)
+        {
+            const std::uint64_t first_object = subsections[i_subsection];
+            const std::uint64_t n_entries = subsections[i_subsection + 1];
+            if (n_entries > (stream_data.size() - pos) / entry_size) return false;
+            for (std::uint64_t i = 0; i < n_entries; i++)
+            {
+                std::uint64_t fields[3];
+                for (unsigned int i_field = 0; i_field < 3; i_field++)
+                {
+                    fields[i_field] = 0;
+                    for (size_t i_byte = 0; i_byte < field_widths[i_field]; i_byte++)
+                        fields[i_field] = (fields[i_field] << 8) | (unsigned char)stream_data[pos++];
+                }
+
+                // The type defaults to 1 (uncompressed object) if its field is omitted.
+                const std::uint64_t entry_type = field_widths[0] == 0 ? 1 : fields[0];
+                if (entry_type == 1)
+                    AddEntry(first_object + i, XRefEntry{false, fields[1], 0});
+                else if (entry_type == 2)
+                    AddEntry(first_object + i, XRefEntry{true, fields[1], fields[2]});
+            }
+        }
+        return true;
+    }
+
+    /**
+     *
+     */
+    bool PdfReader::ReadIndirectObject(const std::uint64_t offset, PdfObject& object, const unsigned int depth)
+    {
+        if (offset >= data_.size()) return false;
+        size_t pos = (size_t)offset;
+        std::uint64_t number;
+        std::uint64_t generation;
+        if (!ReadInteger(data_, pos, number)) return false;
+        SkipWhiteSpace(data_, pos);
+        if (!ReadInteger(data_, pos, generation)) return false;
+        SkipWhiteSpace(data_, pos);
+        if (!ReadKeyword(data_, pos, "obj") || !ReadObject(data_, pos, object, depth)) return false;
+
+        // Stream data starts after the end of line following the keyword.
+        if (object.type_ == PdfObject::Type::dictionary)
+        {
+            SkipWhiteSpace(data_, pos);
+            if (ReadKeyword(data_, pos, "stream"))
+            {
+                if (data_.compare(pos, 2, "\r\n") == 0)
+                    pos += 2;
+                else if (pos < data_.size() && (data_[pos] == '\n' || data_[pos] == '\r'))
+                    pos++;
+                object.type_ = PdfObject::Type::stream;
+                object.stream_begin_ = pos;
+            }
+        }
+        return true;
+    }
+
+    /**
+     *
+     */
+    bool PdfReader::ReadCompressedObject(const XRefEntry& entry, PdfObject& object, const unsigned int depth)
+    {
+        auto& object_stream = object_streams_[entry.offset_];
+        if (!object_stream)
+        {
+            // Object streams are not allowed to be in object streams, so this can not recurse further.
+            const auto stream_entry = entries_.find((std::uint32_t)entry.offset_);
+            PdfObject stream;
+            if (entry.offset_ >= 4294967296 || stream_entry == entries_.end() || stream_entry->second.compressed_ ||
+                !ReadIndirectObject(stream_entry->second.offset_, stream, depth + 1) ||
+                stream.type_ != PdfObject::Type::stream)
+                return false;
+
+            // The stream starts with pairs of object number and offset relative to the first object.
+            auto new_object_stream = std::make_unique<ObjectStream>();
+            const PdfObject* n_objects = stream.Get("N");
+            const PdfObject* first = stream.Get("First");
+            if (n_objects == nullptr || !n_objects->IsIndex() || first == nullptr || !first->IsIndex() ||
+                !GetStreamData(stream, new_object_stream->data_, depth + 1))
+                return false;
+            size_t pos = 0;
+            for (std::uint64_t i = 0; i < (std::uint64_t)n_objects->number_; i++)
+            {
+                std::uint64_t number;
+                std::uint64_t offset;
+                SkipWhiteSpace(new_object_stream->data_, pos);
+                if (!ReadInteger(new_object_stream->data_, pos, number)) return false;
+                SkipWhiteSpace(new_object_stream->data_, pos);
+                if (!ReadInteger(new_object_stream->data_, pos, offset)) return false;
+                new_object_stream->objects_.emplace_back(number, (std::uint64_t)first->number_ + offset);
+            }
+            object_stream = std::move(new_object_stream);
+        }
+
+        if (entry.index_ >= object_stream->objects_.size()) return false;
+        size_t pos = (size_t)object_stream->objects_[(size_t)entry.index_].second;
+        if (pos >= object_stream->data_.size()) return false;
+        return ReadObject(object_stream->data_, pos, object, depth);
+    }
+
+    /**
+     *
+     */
+    bool PdfReader::Resolve(const PdfObject& object, PdfObject& resolved, const unsigned int depth)
+    {
+        if (object.type_ != PdfObject::Type::reference)
+        {
+            resolved = object;
+            return true;
+        }
+        if (depth > max_depth_) return false;
+
+        const auto entry = entries_.find(object.reference_);
+        if (entry == entries_.end())
+        {
+            resolved = PdfObject();
+            return true;
+        }
+        if (entry->second.compressed_) return ReadCompressedObject(entry->second, resolved, depth + 1);
+        return ReadIndirectObject(entry->second.offset_, resolved, depth + 1);
+    }
+
+    /**
+     *
+     */
+    bool PdfReader::GetStreamData(const PdfObject& stream, std::string& stream_data, const unsigned int depth)
+    {
+        // The length can be an indirect object. If it is not valid, the stream ends at the "endstream" keyword.
+        PdfObject length;
+        const PdfObject* length_entry = stream.Get("Length");
+        if (length_entry == nullptr || !Resolve(*length_entry, length, depth + 1)) return false;
+        size_t stream_size;
+        if (length.IsIndex() && length.number_ <= data_.size() - stream.stream_begin_)
+            stream_size = (size_t)length.number_;
+        else
+        {
+            const size_t stream_end = data_.find("endstream", stream.stream_begin_);
+            if (stream_end == std::string_view::npos) return false;
+            stream_size = stream_end - stream.stream_begin_;
+        }
+        const std::string_view raw_data = data_.substr(stream.stream_begin_, stream_size);
+
+        // Filters can be given as a name or an array with a single name.
+        PdfObject filter;
+        const PdfObject* filter_entry = stream.Get("Filter");
+        if (filter_entry != nullptr && !Resolve(*filter_entry, filter, depth + 1)) return false;
+        if (filter.type_ == PdfObject::Type::array && filter.values_.size() == 1)
+            filter = PdfObject(filter.values_[0]);
+        stream_data.clear();
+        if (filter.type_ == PdfObject::Type::null)
+        {
+            stream_data = raw_data;
+            return true;
+        }
+        if (filter.type_ != PdfObject::Type::name || filter.string_ != "FlateDecode" ||
+            !L2A::UTIL::DecompressZlib(raw_data.data(), raw_data.size(), stream_data))
+            return false;
+
+        // Predictors, only the PNG predictors are used for cross reference streams.
+        PdfObject parameters;
+        const PdfObject* parameters_entry = stream.Get("DecodeParms");
+        if (parameters_entry != nullptr && !Resolve(*parameters_entry, parameters, depth + 1)) return false;
+        if (parameters.type_ == PdfObject::Type::array && parameters.values_.size() == 1)
+            parameters = PdfObject(parameters.values_[0]);
+        if (!parameters.IsDictionary()) return true;
+        const auto get_parameter = [&parameters](const std::string_view& key, const size_t default_value)
+        {
+            const PdfObject* value = parameters.Get(key);
+            return value != nullptr && value->IsIndex() ? (size_t)value->number_ : default_value;
+        };
+        const size_t predictor = get_parameter("Predictor", 1);
+        if (predictor == 1) return true;
+        if (predictor < 10) return false;
+        const size_t colors = get_parameter("Colors", 1);
+        const size_t bits_per_component = get_parameter("BitsPerComponent", 8);
+        const size_t columns = get_parameter("Columns", 1);
+        if (colors > 32 || bits_per_component > 16 || columns > 1000000) return false;
+        return UndoPngPredictor(stream_data, colors, bits_per_component, columns);
+    }
+
+    /**
+     * \brief Read a box from an array of four numbers.
+     */
+    bool ReadBox(PdfReader& reader, const PdfObject& object, L2A::UTIL::PdfBox& box)
+    {
+        PdfObject array;
+        if (!reader.Resolve(object, array) || array.type_ != PdfObject::Type::array || array.values_.size() != 4)
+            return false;
+        double coordinates[4];
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            PdfObject number;
+            if (!reader.Resolve(array.values_[i], number) || number.type_ != PdfObject::Type::number) return false;
+            coordinates[i] = number.number_;
+        }
+        box.left_ = std::min(coordinates[0], coordinates[2]);
+        box.bottom_ = std::min(coordinates[1], coordinates[3]);
+        box.right_ = std::max(coordinates[0], coordinates[2]);
+        box.top_ = std::max(coordinates[1], coordinates[3]);
+        return true;
+    }
+
+    /**
+     * \brief Add the pages of a node in the page tree. The boxes are inherited from the parent nodes.
+     */
+    bool ReadPageTree(PdfReader& reader, const PdfObject& node, L2A::UTIL::PdfBox media_box,
+        L2A::UTIL::PdfBox crop_box, bool has_crop_box, std::set<std::uint32_t>& visited_nodes,
+        std::vector<L2A::UTIL::PdfPageInfo>& pages, const unsigned int depth = 0)
+    {
+        if (depth > max_depth_ || !node.IsDictionary()) return false;
+
+        const PdfObject* media_box_entry = node.Get("MediaBox");
+        if (media_box_entry != nullptr && !ReadBox(reader, *media_box_entry, media_box)) return false;
+        const PdfObject* crop_box_entry = node.Get("CropBox");
+        if (crop_box_entry != nullptr)
+        {
+            if (!ReadBox(reader, *crop_box_entry, crop_box)) return false;
+            has_crop_box = true;
+        }
+
+        const PdfObject* type = node.Get("Type");
+        const PdfObject* kids_entry = node.Get("Kids");
+        if ((type != nullptr && type->string_ == "Page") || kids_entry == nullptr)
+        {
+            pages.push_back(L2A::UTIL::PdfPageInfo{media_box, has_crop_box ? crop_box : media_box});
+            return true;
+        }
+
+        PdfObject kids;
+        if (!reader.Resolve(*kids_entry, kids) || kids.type_ != PdfObject::Type::array) return false;
+        for (const auto& kid_reference : kids.values_)
+        {
+            // Each node can only be visited once, otherwise the page tree of a corrupt file could loop.
+            PdfObject kid;
+            if (kid_reference.type_ != PdfObject::Type::reference ||
+                !visited_nodes.insert(kid_reference.reference_).second || !reader.Resolve(kid_reference, kid) ||
+                !ReadPageTree(reader, kid, media_box, crop_box, has_crop_box, visited_nodes, pages, depth + 1))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Get the root node of the page tree.
+     */
+    bool ReadPageTreeRoot(PdfReader& reader, PdfObject& root_node)
+    {
+        PdfObject catalog;
+        if (!reader.ReadCrossReferences() || !reader.Resolve(*reader.GetTrailer().Get("Root"), catalog) ||
+            catalog.type_ != PdfObject::Type::dictionary)
+            return false;
+        const PdfObject* pages = catalog.Get("Pages");
+        return pages != nullptr && reader.Resolve(*pages, root_node) && root_node.type_ == PdfObject::Type::dictionary;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadPdfInfo(const std::string_view& pdf_data, PdfInfo& info)
+{
+    info = PdfInfo();
+    PdfReader reader(pdf_data);
+    PdfObject root_node;
+    if (!ReadPageTreeRoot(reader, root_node)) return false;
+    std::set<std::uint32_t> visited_nodes;
+    if (!ReadPageTree(reader, root_node, PdfBox(), PdfBox(), false, visited_nodes, info.pages_)) return false;
+
+    // The information dictionary is optional. Strings in encrypted files are not decrypted, so the producer is only
+    // read from files that are not encrypted.
+    if (reader.GetTrailer().Get("Encrypt") != nullptr) return true;
+    PdfObject info_dictionary;
+    PdfObject producer;
+    const PdfObject* info_entry = reader.GetTrailer().Get("Info");
+    if (info_entry != nullptr && reader.Resolve(*info_entry, info_dictionary) &&
+        info_dictionary.type_ == PdfObject::Type::dictionary)
+    {
+        const PdfObject* producer_entry = info_dictionary.Get("Producer");
+        if (producer_entry != nullptr && reader.Resolve(*producer_entry, producer) &&
+            producer.type_ == PdfObject::Type::string)
+            info.producer_ = TextStringToUTF8(producer.string_);
+    }
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadPdfFileInfo(const std::filesystem::path& pdf_path, PdfInfo& info)
+{
+    const MappedFile pdf_file(pdf_path);
+    return pdf_file.IsOpen() && ReadPdfInfo(pdf_file.View(), info);
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadPdfPageCount(const std::string_view& pdf_data, size_t& n_pages)
+{
+    PdfReader reader(pdf_data);
+    PdfObject root_node;
+    if (!ReadPageTreeRoot(reader, root_node)) return false;
+
+    // The root node stores the number of pages in the whole tree.
+    PdfObject count;
+    const PdfObject* count_entry = root_node.Get("Count");
+    if (count_entry == nullptr || !reader.Resolve(*count_entry, count) || !count.IsIndex()) return false;
+    n_pages = (size_t)count.number_;
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadPdfFilePageCount(const std::filesystem::path& pdf_path, size_t& n_pages)
+{
+    const MappedFile pdf_file(pdf_path);
+    return pdf_file.IsOpen() && ReadPdfPageCount(pdf_file.View(), n_pages);
+}
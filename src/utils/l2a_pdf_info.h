@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Read the page boxes and other metadata of pdf files without Illustrator or Ghostscript.
+ */
+
+#ifndef UTIL_PDF_INFO_H_
+#define UTIL_PDF_INFO_H_
+
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Rectangle in the default user space of a pdf page (1/72 inch). The corners are normalized, i.e.,
+         * left <= right and bottom <= top.
+         */
+        struct PdfBox
+        {
+            double left_ = 0.0;
+            double bottom_ = 0.0;
+            double right_ = 0.0;
+            double top_ = 0.0;
+        };
+
+        /**
+         * \brief Boxes of a pdf page.
+         */
+        struct PdfPageInfo
+        {
+            //! Boundaries of the physical medium.
+            PdfBox media_box_;
+
+            //! Visible region of the page, this is the media box if no crop box is set.
+            PdfBox crop_box_;
+        };
+
+        /**
+         * \brief Metadata of a pdf file.
+         */
+        struct PdfInfo
+        {
+            //! Pages in the order of the document.
+            std::vector<PdfPageInfo> pages_;
+
+            //! Producer in the document information dictionary (UTF-8), empty if it is not set.
+            std::string producer_;
+        };
+
+        /**
+         * \brief Read the metadata of a pdf file. Only the cross reference sections, the document catalog, the page
+         * tree and the information dictionary are parsed, the contents of the pages are not touched. Cross reference
+         * streams and object streams (FlateDecode) are supported. The function only uses std types, so it can be
+         * used outside of the plugin thread.
+         * @return False if the file can not be parsed, e.g., because it is truncated or encrypted.
+         */
+        bool ReadPdfInfo(const std::string_view& pdf_data, PdfInfo& info);
+
+        /**
+         * \brief Read the metadata of a pdf file that is mapped into memory.
+         */
+        bool ReadPdfFileInfo(const std::filesystem::path& pdf_path, PdfInfo& info);
+
+        /**
+         * \brief Read the number of pages of a pdf file. This only parses the root of the page tree.
+         * @return False if the file can not be parsed.
+         */
+        bool ReadPdfPageCount(const std::string_view& pdf_data, size_t& n_pages);
+
+        /**
+         * \brief Read the number of pages of a pdf file that is mapped into memory.
+         */
+        bool ReadPdfFilePageCount(const std::filesystem::path& pdf_path, size_t& n_pages);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,307 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Verify the pdf files of LaTeX2AI items outside of the plugin thread.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_pdf_verifier.h"
+
+#include "l2a_hash.h"
+#include "l2a_parallel.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <utility>
+
+
+namespace
+{
+    /**
+     * \brief Check if a character is a white space in the pdf syntax.
+     */
+    bool IsPdfWhiteSpace(const char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\0';
+    }
+
+    /**
+     * \brief Advance the position past white spaces and comments.
+     */
+    void SkipWhiteSpace(const std::string_view& data, size_t& pos)
+    {
+        while (pos < data.size())
+        {
+            if (data[pos] == '%')
+                while (pos < data.size() && data[pos] != '\n' && data[pos] != '\r') pos++;
+            else if (IsPdfWhiteSpace(data[pos]))
+                pos++;
+            else
+                break;
+        }
+    }
+
+    /**
+     * \brief Read a non negative integer at the position and advance the position past it.
+     */
+    bool ReadInteger(const std::string_view& data, size_t& pos, std::uint64_t& value)
+    {
+        const size_t start = pos;
+        value = 0;
+        while (pos < data.size() && data[pos] >= '0' && data[pos] <= '9')
+        {
+            // Offsets in the files we check never get close to this limit.
+            if (value > 1000000000000000) return false;
+            value = 10 * value + (std::uint64_t)(data[pos] - '0');
+            pos++;
+        }
+        return pos > start;
+    }
+
+    /**
+     * \brief Check if the keyword is at the position and advance the position past it.
+     */
+    bool ReadKeyword(const std::string_view& data, size_t& pos, const std::string_view& keyword)
+    {
+        if (data.compare(pos, keyword.size(), keyword) != 0) return false;
+        pos += keyword.size();
+        return true;
+    }
+
+    /**
+     * \brief Read the header of an indirect object ("number generation obj") and advance the position past it.
+     */
+    bool ReadObjectHeader(const std::string_view& data, size_t& pos, std::uint64_t& number)
+    {
+        std::uint64_t generation;
+        if (!ReadInteger(data, pos, number)) return false;
+        SkipWhiteSpace(data, pos);
+        if (!ReadInteger(data, pos, generation)) return false;
+        SkipWhiteSpace(data, pos);
+        return ReadKeyword(data, pos, "obj");
+    }
+
+    /**
+     * \brief Check a cross reference table, the position is after the "xref" keyword. Each object in use has to start
+     * at its offset and the trailer has to reference the document catalog.
+     */
+    bool IsXRefTableValid(const std::string_view& data, size_t pos, const size_t startxref)
+    {
+        while (true)
+        {
+            SkipWhiteSpace(data, pos);
+            if (ReadKeyword(data, pos, "trailer")) break;
+
+            // Subsection with the first object number and the number of entries. Each entry has 20 characters.
+            std::uint64_t first_object;
+            std::uint64_t n_entries;
+            if (!ReadInteger(data, pos, first_object)) return false;
+            SkipWhiteSpace(data, pos);
+            if (!ReadInteger(data, pos, n_entries)) return false;
+            if (n_entries > (startxref - pos) / 20) return false;
+
+            for (std::uint64_t i = 0; i < n_entries; i++)
+            {
+                std::uint64_t offset;
+                std::uint64_t generation;
+                SkipWhiteSpace(data, pos);
+                if (!ReadInteger(data, pos, offset)) return false;
+                SkipWhiteSpace(data, pos);
+                if (!ReadInteger(data, pos, generation)) return false;
+                SkipWhiteSpace(data, pos);
+                if (pos >= startxref) return false;
+
+                const char type = data[pos++];
+                if (type == 'n')
+                {
+                    size_t object_pos = (size_t)offset;
+                    std::uint64_t number;
+                    if (offset >= startxref || !ReadObjectHeader(data, object_pos, number) ||
+                        number != first_object + i)
+                        return false;
+                }
+                else if (type != 'f')
+                    return false;
+            }
+        }
+
+        return data.substr(pos, startxref - pos).find("/Root") != std::string_view::npos;
+    }
+
+    /**
+     * \brief Check a cross reference stream. The stream is compressed, therefore only its dictionary is checked.
+     */
+    bool IsXRefStreamValid(const std::string_view& data, size_t pos, const size_t startxref)
+    {
+        std::uint64_t number;
+        if (!ReadObjectHeader(data, pos, number)) return false;
+        const size_t stream = data.find("stream", pos);
+        if (stream == std::string_view::npos || stream >= startxref) return false;
+        const std::string_view dictionary = data.substr(pos, stream - pos);
+        return dictionary.find("/XRef") != std::string_view::npos && dictionary.find("/Root") != std::string_view::npos;
+    }
+
+    /**
+     * \brief Check the hash and the structure of a pdf file.
+     */
+    L2A::UTIL::PdfFileState CheckPdfData(const std::string& pdf_data, const std::string& hash)
+    {
+        if (L2A::UTIL::XXH3HashString(pdf_data.data(), pdf_data.size()) != hash ||
+            !L2A::UTIL::IsPdfStructureValid(pdf_data))
+            return L2A::UTIL::PdfFileState::corrupt;
+        return L2A::UTIL::PdfFileState::valid;
+    }
+
+    /**
+     * \brief Check the pdf file stored in an item.
+     */
+    L2A::UTIL::PdfFileState CheckPayload(const L2A::UTIL::PdfVerificationTask& task)
+    {
+        if (task.payload_.empty()) return L2A::UTIL::PdfFileState::missing;
+        std::string pdf_data;
+        if (!L2A::UTIL::DecodePayload(task.encoding_, task.payload_.data(), task.payload_.size(), pdf_data))
+            return L2A::UTIL::PdfFileState::corrupt;
+        return CheckPdfData(pdf_data, task.hash_);
+    }
+
+    /**
+     * \brief Check a linked pdf file.
+     */
+    L2A::UTIL::PdfFileState CheckLinkFile(const L2A::UTIL::PdfVerificationTask& task)
+    {
+        std::error_code error_code;
+        const std::uintmax_t size = std::filesystem::file_size(task.link_path_, error_code);
+        std::ifstream input_stream(task.link_path_, std::ifstream::binary);
+        if (error_code || !input_stream) return L2A::UTIL::PdfFileState::missing;
+
+        std::string pdf_data((size_t)size, '\0');
+        if (!input_stream.read(pdf_data.data(), (std::streamsize)size)) return L2A::UTIL::PdfFileState::missing;
+        return CheckPdfData(pdf_data, task.hash_);
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+bool L2A::UTIL::IsPdfStructureValid(const std::string_view& pdf_data)
+{
+    // The header has to be within the first 1024 bytes.
+    const size_t header = pdf_data.substr(0, 1024).find("%PDF-");
+    if (header == std::string_view::npos) return false;
+
+    // The last end of file marker has to be at the end of the file, otherwise the file is truncated. The offset of the
+    // last cross reference section is stored right before it.
+    const size_t eof = pdf_data.rfind("%%EOF");
+    if (eof == std::string_view::npos || pdf_data.size() - eof > 1024) return false;
+    const size_t startxref = pdf_data.rfind("startxref", eof);
+    if (startxref == std::string_view::npos || startxref < header) return false;
+    size_t pos = startxref + 9;
+    std::uint64_t xref_offset;
+    SkipWhiteSpace(pdf_data, pos);
+    if (!ReadInteger(pdf_data, pos, xref_offset) || xref_offset >= startxref) return false;
+
+    pos = (size_t)xref_offset;
+    if (ReadKeyword(pdf_data, pos, "xref")) return IsXRefTableValid(pdf_data, pos, startxref);
+    return IsXRefStreamValid(pdf_data, pos, startxref);
+}
+
+/**
+ *
+ */
+L2A::UTIL::PdfVerifier::PdfVerifier(
+    std::vector<PdfVerificationTask> tasks, const double time_budget, unsigned int n_threads)
+    : tasks_(std::move(tasks)), results_(tasks_.size()), seconds_(0.0), finished_(false), cancel_(false)
+{
+    // The verification should not slow down the interaction with Illustrator, so only half of the hardware threads
+    // are used by default.
+    if (n_threads == 0) n_threads = std::thread::hardware_concurrency() / 2;
+    if (n_threads == 0) n_threads = 1;
+    thread_ = std::thread(&PdfVerifier::Run, this, time_budget, n_threads);
+}
+
+/**
+ *
+ */
+L2A::UTIL::PdfVerifier::~PdfVerifier()
+{
+    Cancel();
+    Wait();
+}
+
+/**
+ *
+ */
+void L2A::UTIL::PdfVerifier::Run(const double time_budget, const unsigned int n_threads)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto stop_checks = [&]()
+    {
+        return cancel_ ||
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > time_budget;
+    };
+
+    // Items with the same pdf file link to the same file, each linked file is only checked once.
+    std::map<std::pair<std::filesystem::path, std::string>, size_t> link_file_indices;
+    std::vector<size_t> task_link_file(tasks_.size());
+    std::vector<const PdfVerificationTask*> link_file_tasks;
+    for (size_t i = 0; i < tasks_.size(); i++)
+    {
+        const auto [link_file, is_new] = link_file_indices.emplace(
+            std::make_pair(tasks_[i].link_path_, tasks_[i].hash_), link_file_tasks.size());
+        if (is_new) link_file_tasks.push_back(&tasks_[i]);
+        task_link_file[i] = link_file->second;
+    }
+
+    // The stored pdf files are checked first, they are required to repair the linked files. Checks that throw
+    // (e.g. if there is not enough memory to decode a large file) remain unchecked.
+    std::vector<PdfFileState> link_file_states(link_file_tasks.size(), PdfFileState::unchecked);
+    try
+    {
+        L2A::UTIL::ParallelFor(
+            tasks_.size() + link_file_tasks.size(),
+            [&](const size_t i)
+            {
+                if (stop_checks()) return;
+                if (i < tasks_.size())
+                    results_[i].payload_state_ = CheckPayload(tasks_[i]);
+                else
+                    link_file_states[i - tasks_.size()] = CheckLinkFile(*link_file_tasks[i - tasks_.size()]);
+            },
+            n_threads);
+    }
+    catch (...)
+    {
+    }
+
+    for (size_t i = 0; i < tasks_.size(); i++) results_[i].link_file_state_ = link_file_states[task_link_file[i]];
+    seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    finished_ = true;
+}
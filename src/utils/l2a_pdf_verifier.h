@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Verify the pdf files of LaTeX2AI items outside of the plugin thread.
+ */
+
+#ifndef UTIL_PDF_VERIFIER_H_
+#define UTIL_PDF_VERIFIER_H_
+
+
+#include "l2a_payload.h"
+#include "l2a_shared_string.h"
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Check the structure of a pdf file without parsing its contents. The header, the end of file marker
+         * and the last cross reference section (table or stream) are checked, for a cross reference table the offset
+         * of each object is checked as well. This detects truncated files and files with a broken cross reference.
+         */
+        bool IsPdfStructureValid(const std::string_view& pdf_data);
+
+        /**
+         * \brief State of a pdf file after the verification.
+         */
+        enum class PdfFileState
+        {
+            //! The file was not checked, e.g., because the time budget was exceeded.
+            unchecked,
+            //! The file matches the hash and has a valid structure.
+            valid,
+            //! The file does not match the hash or has an invalid structure.
+            corrupt,
+            //! The file does not exist or can not be read.
+            missing
+        };
+
+        /**
+         * \brief Data of an item whose pdf file should be verified. Only std types are used, so the data can be
+         * processed outside of the plugin thread.
+         */
+        struct PdfVerificationTask
+        {
+            //! Encoded pdf file stored in the item.
+            L2A::UTIL::SharedString payload_;
+
+            //! Encoding of the stored pdf file.
+            L2A::UTIL::PayloadEncoding encoding_ = L2A::UTIL::PayloadEncoding::base64;
+
+            //! Hash of the decoded pdf file stored in the item.
+            std::string hash_;
+
+            //! Path to the linked pdf file.
+            std::filesystem::path link_path_;
+        };
+
+        /**
+         * \brief Result of the verification of one item.
+         */
+        struct PdfVerificationResult
+        {
+            //! State of the pdf file stored in the item.
+            PdfFileState payload_state_ = PdfFileState::unchecked;
+
+            //! State of the linked pdf file.
+            PdfFileState link_file_state_ = PdfFileState::unchecked;
+        };
+
+        /**
+         * \brief Verify the stored and linked pdf files of items on a background thread.
+         *
+         * The stored pdf file of each item is decoded and compared to the stored hash, each linked file is read once
+         * and compared to the hash of the items that link to it. In both cases the structure of the pdf file is
+         * checked as well. The checks run on a limited number of worker threads. Checks that are not started within
+         * the time budget are skipped, i.e., their state stays unchecked.
+         */
+        class PdfVerifier
+        {
+           public:
+            /**
+             * \brief Constructor, this starts the verification and returns immediately.
+             * @param tasks Items to verify.
+             * @param time_budget Time in seconds after which no further checks are started.
+             * @param n_threads Number of worker threads, if this is 0 half of the hardware threads are used.
+             */
+            PdfVerifier(std::vector<PdfVerificationTask> tasks, const double time_budget, unsigned int n_threads = 0);
+
+            /**
+             * \brief Destructor, a running verification is cancelled and the worker threads are joined.
+             */
+            ~PdfVerifier();
+
+            PdfVerifier(const PdfVerifier&) = delete;
+            PdfVerifier& operator=(const PdfVerifier&) = delete;
+
+            /**
+             * \brief Check if the verification is finished. This does not block.
+             */
+            bool IsFinished() const { return finished_; }
+
+            /**
+             * \brief Stop starting new checks, the running checks are finished.
+             */
+            void Cancel() { cancel_ = true; }
+
+            /**
+             * \brief Get the results of the verification, in the same order as the tasks. This blocks until the
+             * verification is finished.
+             */
+            const std::vector<PdfVerificationResult>& GetResults()
+            {
+                Wait();
+                return results_;
+            }
+
+            /**
+             * \brief Get the wall time of the verification in seconds. This blocks until the verification is
+             * finished.
+             */
+            double GetSeconds()
+            {
+                Wait();
+                return seconds_;
+            }
+
+           private:
+            /**
+             * \brief Wait until the background thread is finished.
+             */
+            void Wait()
+            {
+                if (thread_.joinable()) thread_.join();
+            }
+
+            /**
+             * \brief Perform the verification, this is executed on the background thread.
+             */
+            void Run(const double time_budget, const unsigned int n_threads);
+
+           private:
+            //! Items to verify.
+            std::vector<PdfVerificationTask> tasks_;
+
+            //! Results for each item.
+            std::vector<PdfVerificationResult> results_;
+
+            //! Wall time of the verification.
+            double seconds_;
+
+            //! Flags for the state of the background thread.
+            std::atomic<bool> finished_;
+            std::atomic<bool> cancel_;
+
+            //! Background thread that distributes the checks to the worker threads.
+            std::thread thread_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
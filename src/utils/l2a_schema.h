@@ -0,0 +1,402 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Compile-time description of a fixed XML schema, used to read and write objects without a generic parameter
+ * list.
+ */
+
+#ifndef UTIL_SCHEMA_H_
+#define UTIL_SCHEMA_H_
+
+
+#include "l2a_error.h"
+#include "l2a_shared_string.h"
+#include "l2a_xml_reader.h"
+#include "l2a_xml_writer.h"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Map between enum values and their names. The map is created at compile time, no strings are
+         * allocated for a lookup.
+         *
+         * The map can also be used as codec in a schema field.
+         */
+        template <typename E, size_t n>
+        class EnumStringMap
+        {
+           public:
+            //! Type of the values converted by this map.
+            using value_type = E;
+
+            /**
+             * \brief Constructor.
+             */
+            constexpr EnumStringMap(const std::array<std::pair<E, std::string_view>, n>& entries) : entries_(entries)
+            {
+            }
+
+            /**
+             * \brief Get the enum value for a name. Returns false if the name does not exist.
+             */
+            constexpr bool TryToEnum(const std::string_view name, E& value) const
+            {
+                for (const auto& entry : entries_)
+                {
+                    if (entry.second == name)
+                    {
+                        value = entry.first;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /**
+             * \brief Get the enum value for a name.
+             */
+            E ToEnum(const std::string_view name) const
+            {
+                E value = entries_[0].first;
+                if (!TryToEnum(name, value)) l2a_error("Name not found in the enum map!");
+                return value;
+            }
+
+            /**
+             * \brief Get the name of an enum value.
+             */
+            std::string_view ToString(const E value) const
+            {
+                for (const auto& entry : entries_)
+                    if (entry.first == value) return entry.second;
+                l2a_error("The enum value has no name!");
+            }
+
+            /**
+             * \brief Check that all names and values are unique.
+             */
+            constexpr bool IsUnique() const
+            {
+                for (size_t i = 0; i < n; i++)
+                    for (size_t j = i + 1; j < n; j++)
+                        if (entries_[i].first == entries_[j].first || entries_[i].second == entries_[j].second)
+                            return false;
+                return true;
+            }
+
+            /**
+             * \brief Codec interface, see SchemaField.
+             */
+            bool Parse(const std::string_view value, const bool, const std::shared_ptr<const std::string>&,
+                E& member) const
+            {
+                return TryToEnum(value, member);
+            }
+            std::string_view Emit(const E& member, std::string&) const { return ToString(member); }
+
+           private:
+            //! Pairs of enum values and names.
+            std::array<std::pair<E, std::string_view>, n> entries_;
+        };
+
+        /**
+         * \brief Codec for unsigned integers.
+         */
+        struct UnsignedCodec
+        {
+            using value_type = unsigned int;
+
+            bool Parse(const std::string_view value, const bool, const std::shared_ptr<const std::string>&,
+                unsigned int& member) const
+            {
+                const auto result = std::from_chars(value.data(), value.data() + value.size(), member);
+                return result.ec == std::errc() && result.ptr == value.data() + value.size();
+            }
+            std::string_view Emit(const unsigned int& member, std::string& buffer) const
+            {
+                buffer.resize(16);
+                const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), member);
+                buffer.resize(result.ptr - buffer.data());
+                return buffer;
+            }
+        };
+
+        /**
+         * \brief Codec for UTF-8 strings.
+         */
+        struct StringCodec
+        {
+            using value_type = std::string;
+
+            bool Parse(const std::string_view value, const bool, const std::shared_ptr<const std::string>&,
+                std::string& member) const
+            {
+                member = value;
+                return true;
+            }
+            std::string_view Emit(const std::string& member, std::string&) const { return member; }
+        };
+
+        /**
+         * \brief Codec for large payloads. If possible, the payload refers to the source string and is not copied.
+         */
+        struct SharedStringCodec
+        {
+            using value_type = SharedString;
+
+            bool Parse(const std::string_view value, const bool is_borrowed,
+                const std::shared_ptr<const std::string>& source, SharedString& member) const
+            {
+                if (is_borrowed)
+                    member = SharedString(source, value.data() - source->data(), value.size());
+                else
+                {
+                    member = SharedString(std::string(value));
+                    SharedString::CountCopy();
+                }
+                return true;
+            }
+            std::string_view Emit(const SharedString& member, std::string&) const { return member.View(); }
+        };
+
+        /**
+         * \brief A single value of a schema, i.e., an attribute or the text of an element.
+         *
+         * The codec converts between the XML string and the member of the object. It has the functions
+         *  - bool Parse(value, is_borrowed, source, member), where is_borrowed is true if the value refers to the
+         *    source string. Returns false if the value is not valid.
+         *  - std::string_view Emit(member, buffer), the buffer can be used if the string has to be created.
+         *
+         * @tparam Class Type of the object.
+         * @tparam Codec Type of the codec.
+         */
+        template <typename Class, typename Codec>
+        struct SchemaField
+        {
+            //! Name of the child element, empty for the root element.
+            std::string_view element_;
+
+            //! Name of the attribute, empty for the text of the element.
+            std::string_view attribute_;
+
+            //! Member of the object.
+            typename Codec::value_type Class::*member_;
+
+            //! Codec for the value.
+            Codec codec_;
+
+            //! Flag if the element is optional. If the element exists, all of its fields have to be given.
+            bool optional_;
+        };
+
+        /**
+         * \brief Create a schema field, the types are deduced from the member pointer and the codec.
+         */
+        template <typename Class, typename T, typename Codec>
+        constexpr SchemaField<Class, Codec> MakeSchemaField(const std::string_view element,
+            const std::string_view attribute, T Class::*member, const Codec& codec, const bool optional = false)
+        {
+            static_assert(std::is_same<T, typename Codec::value_type>::value, "The codec does not fit the member");
+            return SchemaField<Class, Codec>{element, attribute, member, codec, optional};
+        }
+
+        /**
+         * \brief Check if the fields are in the order they are written in, i.e., the fields of the root element come
+         * first and the elements and attributes are sorted as in a parameter list. The text of an element comes after
+         * its attributes.
+         */
+        template <typename... Fields>
+        constexpr bool IsSchemaSorted(const std::tuple<Fields...>& schema)
+        {
+            constexpr size_t n_fields = sizeof...(Fields);
+            std::array<std::string_view, n_fields> elements = {};
+            std::array<std::string_view, n_fields> attributes = {};
+            size_t i_field = 0;
+            std::apply(
+                [&](const auto&... field)
+                { ((elements[i_field] = field.element_, attributes[i_field] = field.attribute_, i_field++), ...); },
+                schema);
+            for (size_t i = 1; i < n_fields; i++)
+            {
+                if (elements[i - 1] > elements[i]) return false;
+                if (elements[i - 1] == elements[i] &&
+                    (attributes[i - 1].empty() || (!attributes[i].empty() && attributes[i - 1] >= attributes[i])))
+                    return false;
+            }
+            return true;
+        }
+
+        namespace INTERNAL
+        {
+            /**
+             * \brief Parse the value of the field with the given element and attribute name. Returns the index of the
+             * field, or -1 if the field does not exist or the value is not valid.
+             */
+            template <typename Class, typename Schema, size_t... i>
+            int ParseSchemaField(const Schema& schema, const std::string_view element, const std::string_view attribute,
+                const XMLReader& reader, const std::shared_ptr<const std::string>& source, Class& object,
+                std::index_sequence<i...>)
+            {
+                int index = -1;
+                const auto parse_field = [&](const auto& field, const int i_field)
+                {
+                    if (field.element_ != element || field.attribute_ != attribute) return false;
+                    const bool valid = field.codec_.Parse(
+                        reader.GetValue(), reader.IsValueBorrowed(), source, object.*(field.member_));
+                    index = valid ? i_field : -1;
+                    return true;
+                };
+                (parse_field(std::get<i>(schema), (int)i) || ...);
+                return index;
+            }
+
+            /**
+             * \brief Write a field of the schema.
+             */
+            template <typename Class, typename Field>
+            void EmitSchemaField(const Field& field, const Class& object, const bool write_optional, XMLWriter& writer,
+                std::string_view& open_element, std::string& buffer)
+            {
+                if (field.optional_ && !write_optional) return;
+                if (field.element_ != open_element)
+                {
+                    if (!open_element.empty()) writer.CloseElement();
+                    writer.OpenElement(field.element_);
+                    open_element = field.element_;
+                }
+                const std::string_view value = field.codec_.Emit(object.*(field.member_), buffer);
+                if (field.attribute_.empty())
+                    writer.PushText(value);
+                else
+                    writer.PushAttribute(field.attribute_, value);
+            }
+        }  // namespace INTERNAL
+
+        /**
+         * \brief Read an object with a schema. The reader has to be at the start of the root element.
+         *
+         * Returns false if the XML does not exactly fit the schema, i.e., if it contains unknown elements or
+         * attributes, invalid values or if fields are missing. In this case the object can be partially set and the
+         * generic parameter list has to be used.
+         *
+         * @param source String the reader refers to, payloads can refer to it instead of being copied.
+         */
+        template <typename Class, typename... Fields>
+        bool ParseSchema(const std::tuple<Fields...>& schema, XMLReader& reader,
+            const std::shared_ptr<const std::string>& source, Class& object)
+        {
+            constexpr size_t n_fields = sizeof...(Fields);
+            static_assert(n_fields <= 64, "The schema has too many fields");
+            const auto field_indices = std::index_sequence_for<Fields...>();
+            std::array<std::string_view, n_fields> field_elements = {};
+            size_t i_field = 0;
+            std::apply([&](const auto&... field) { ((field_elements[i_field++] = field.element_), ...); }, schema);
+
+            // Bit masks of the fields that were read and of the fields whose element exists.
+            std::uint64_t read_fields = 0;
+            std::uint64_t existing_fields = 0;
+            for (size_t i = 0; i < n_fields; i++)
+                if (field_elements[i].empty()) existing_fields |= std::uint64_t(1) << i;
+
+            const size_t root_depth = reader.GetDepth();
+            std::string_view element;
+            while (true)
+            {
+                const XMLReader::Event event = reader.Next();
+                if (event == XMLReader::Event::end_document) return false;
+                if (event == XMLReader::Event::end_element)
+                {
+                    if (reader.GetDepth() < root_depth) break;
+                    element = std::string_view();
+                }
+                else if (event == XMLReader::Event::start_element)
+                {
+                    // Only child elements of the root element that are part of the schema can exist once.
+                    if (reader.GetDepth() != root_depth + 1) return false;
+                    element = reader.GetName();
+                    std::uint64_t element_fields = 0;
+                    for (size_t i = 0; i < n_fields; i++)
+                        if (field_elements[i] == element) element_fields |= std::uint64_t(1) << i;
+                    if (element_fields == 0 || (existing_fields & element_fields) != 0) return false;
+                    existing_fields |= element_fields;
+                }
+                else
+                {
+                    const std::string_view attribute =
+                        event == XMLReader::Event::attribute ? reader.GetName() : std::string_view();
+                    const int index =
+                        INTERNAL::ParseSchemaField(schema, element, attribute, reader, source, object, field_indices);
+                    if (index < 0 || (read_fields & (std::uint64_t(1) << index)) != 0) return false;
+                    read_fields |= std::uint64_t(1) << index;
+                }
+            }
+
+            // All fields of the existing elements have to be given, elements that are not optional have to exist.
+            std::uint64_t required_fields = existing_fields;
+            i_field = 0;
+            std::apply(
+                [&](const auto&... field)
+                { ((required_fields |= field.optional_ ? 0 : std::uint64_t(1) << i_field, i_field++), ...); },
+                schema);
+            return read_fields == required_fields;
+        }
+
+        /**
+         * \brief Write an object with a schema, the output is the same as for a parameter list with the same
+         * values.
+         *
+         * @param write_optional If the optional elements should be written.
+         */
+        template <typename Class, typename... Fields>
+        void EmitSchema(const std::tuple<Fields...>& schema, const std::string_view root_name, const Class& object,
+            const bool write_optional, XMLWriter& writer)
+        {
+            std::string_view open_element;
+            std::string buffer;
+            writer.OpenElement(root_name);
+            std::apply([&](const auto&... field)
+                { (INTERNAL::EmitSchemaField(field, object, write_optional, writer, open_element, buffer), ...); },
+                schema);
+            if (!open_element.empty()) writer.CloseElement();
+            writer.CloseElement();
+        }
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
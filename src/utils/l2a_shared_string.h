@@ -0,0 +1,139 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Immutable string that is shared between copies.
+ */
+
+#ifndef UTIL_SHARED_STRING_H_
+#define UTIL_SHARED_STRING_H_
+
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Immutable string that shares its data between all copies of the object.
+         *
+         * The string can also refer to a part of a larger string, e.g., the encoded pdf file in the note of an item.
+         * Large payloads are passed around with this class, so they are not copied between the different stages. The
+         * remaining copies of payloads are explicitly counted with CountCopy, so they can be checked in the tests and
+         * benchmarks.
+         */
+        class SharedString
+        {
+           public:
+            /**
+             * \brief Default constructor, creates an empty string.
+             */
+            SharedString() : begin_(0), length_(0) {}
+
+            /**
+             * \brief Take ownership of a string.
+             */
+            explicit SharedString(std::string&& string)
+                : source_(std::make_shared<const std::string>(std::move(string))), begin_(0), length_(source_->size())
+            {
+            }
+
+            /**
+             * \brief Refer to a part of a shared string.
+             */
+            SharedString(const std::shared_ptr<const std::string>& source, const size_t begin, const size_t length)
+                : source_(source), begin_(begin), length_(length)
+            {
+            }
+
+            /**
+             * \brief Pointer to the first character, the data is not null terminated.
+             */
+            const char* data() const { return source_ == nullptr ? "" : source_->data() + begin_; }
+
+            /**
+             * \brief Number of characters in the string.
+             */
+            size_t size() const { return length_; }
+
+            /**
+             * \brief Check if the string is empty.
+             */
+            bool empty() const { return length_ == 0; }
+
+            /**
+             * \brief Get a view of the string.
+             */
+            std::string_view View() const { return std::string_view(data(), length_); }
+
+            /**
+             * \brief Check if this object refers to a part of a larger string.
+             */
+            bool IsPartOfSource() const { return source_ != nullptr && source_->size() != length_; }
+
+            /**
+             * \brief Memory of the source string attributed to this object, i.e., the source memory is divided among
+             * all objects that share it.
+             */
+            double GetMemoryUsage() const
+            {
+                return source_ == nullptr ? 0.0 : (double)source_->capacity() / (double)source_.use_count();
+            }
+
+            /**
+             * \brief Count a copy of a payload.
+             */
+            static void CountCopy() { n_copies_++; }
+
+            /**
+             * \brief Get the number of counted copies since the last reset.
+             */
+            static size_t GetNumberOfCopies() { return n_copies_; }
+
+            /**
+             * \brief Reset the number of counted copies.
+             */
+            static void ResetNumberOfCopies() { n_copies_ = 0; }
+
+           private:
+            //! String that contains the data.
+            std::shared_ptr<const std::string> source_;
+
+            //! Position and length of the data in the source string.
+            size_t begin_;
+            size_t length_;
+
+            //! Number of counted copies.
+            inline static std::atomic<size_t> n_copies_{0};
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
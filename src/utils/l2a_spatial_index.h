@@ -0,0 +1,213 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Uniform grid to find rectangles that intersect a given region.
+ */
+
+#ifndef UTIL_SPATIAL_INDEX_H_
+#define UTIL_SPATIAL_INDEX_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Check if two rectangles intersect. The orientation of the vertical axis does not matter.
+         */
+        inline bool RectsIntersect(const AIRealRect& rect_a, const AIRealRect& rect_b)
+        {
+            return std::min(rect_a.left, rect_a.right) <= std::max(rect_b.left, rect_b.right) &&
+                   std::min(rect_b.left, rect_b.right) <= std::max(rect_a.left, rect_a.right) &&
+                   std::min(rect_a.top, rect_a.bottom) <= std::max(rect_b.top, rect_b.bottom) &&
+                   std::min(rect_b.top, rect_b.bottom) <= std::max(rect_a.top, rect_a.bottom);
+        }
+
+        /**
+         * \brief Extend a rectangle (in artwork coordinates) such that it also contains a second rectangle.
+         */
+        inline void RectUnion(AIRealRect& rect, const AIRealRect& other_rect)
+        {
+            rect.left = std::min(rect.left, other_rect.left);
+            rect.right = std::max(rect.right, other_rect.right);
+            rect.bottom = std::min(rect.bottom, other_rect.bottom);
+            rect.top = std::max(rect.top, other_rect.top);
+        }
+
+        /**
+         * \brief Spatial index that stores the bounds of objects in a uniform grid.
+         *
+         * Each object is registered in all grid cells its bounds overlap with. A query only has to check the objects
+         * in the cells that overlap with the query rectangle.
+         *
+         * @tparam T Type of the keys that identify the objects.
+         */
+        template <typename T>
+        class SpatialIndex
+        {
+           public:
+            /**
+             * \brief Constructor.
+             * @param cell_size Edge length of the grid cells.
+             */
+            explicit SpatialIndex(const AIReal cell_size = 128.0) : cell_size_(cell_size) {}
+
+            /**
+             * \brief Remove all objects from the index.
+             */
+            void Clear()
+            {
+                cells_.clear();
+                bounds_.clear();
+            }
+
+            /**
+             * \brief Return the number of objects in the index.
+             */
+            size_t Size() const { return bounds_.size(); }
+
+            /**
+             * \brief Check if an object is in the index.
+             */
+            bool Contains(const T& key) const { return bounds_.find(key) != bounds_.end(); }
+
+            /**
+             * \brief Add an object to the index. If the object already exists, its bounds are replaced.
+             */
+            void Insert(const T& key, const AIRealRect& bounds)
+            {
+                Remove(key);
+                bounds_[key] = bounds;
+                const CellRange range = GetCellRange(bounds);
+                for (long i = range.h_min_; i <= range.h_max_; i++)
+                    for (long j = range.v_min_; j <= range.v_max_; j++) cells_[{i, j}].push_back(key);
+            }
+
+            /**
+             * \brief Remove an object from the index.
+             * @return True if the object was in the index.
+             */
+            bool Remove(const T& key)
+            {
+                auto bounds = bounds_.find(key);
+                if (bounds == bounds_.end()) return false;
+
+                const CellRange range = GetCellRange(bounds->second);
+                for (long i = range.h_min_; i <= range.h_max_; i++)
+                {
+                    for (long j = range.v_min_; j <= range.v_max_; j++)
+                    {
+                        auto cell = cells_.find({i, j});
+                        std::vector<T>& cell_keys = cell->second;
+                        cell_keys.erase(std::find(cell_keys.begin(), cell_keys.end(), key));
+                        if (cell_keys.empty()) cells_.erase(cell);
+                    }
+                }
+                bounds_.erase(bounds);
+                return true;
+            }
+
+            /**
+             * \brief Get all objects whose bounds intersect with the given rectangle.
+             */
+            std::vector<T> Query(const AIRealRect& rect) const
+            {
+                std::vector<T> keys;
+                const CellRange range = GetCellRange(rect);
+                const double n_cells =
+                    double(range.h_max_ - range.h_min_ + 1) * double(range.v_max_ - range.v_min_ + 1);
+                if (n_cells > double(bounds_.size()))
+                {
+                    // The rectangle covers more cells than there are objects, checking all objects is faster.
+                    for (const auto& [key, bounds] : bounds_)
+                        if (RectsIntersect(bounds, rect)) keys.push_back(key);
+                    return keys;
+                }
+
+                for (long i = range.h_min_; i <= range.h_max_; i++)
+                {
+                    for (long j = range.v_min_; j <= range.v_max_; j++)
+                    {
+                        auto cell = cells_.find({i, j});
+                        if (cell == cells_.end()) continue;
+                        for (const auto& key : cell->second)
+                            if (RectsIntersect(bounds_.at(key), rect)) keys.push_back(key);
+                    }
+                }
+
+                // Objects can be in multiple cells.
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+                return keys;
+            }
+
+           private:
+            /**
+             * \brief Range of grid cells.
+             */
+            struct CellRange
+            {
+                long h_min_;
+                long h_max_;
+                long v_min_;
+                long v_max_;
+            };
+
+            /**
+             * \brief Get the range of grid cells that overlap with a rectangle.
+             */
+            CellRange GetCellRange(const AIRealRect& rect) const
+            {
+                return {CellIndex(std::min(rect.left, rect.right)), CellIndex(std::max(rect.left, rect.right)),
+                    CellIndex(std::min(rect.top, rect.bottom)), CellIndex(std::max(rect.top, rect.bottom))};
+            }
+
+            /**
+             * \brief Get the index of the grid cell that contains a coordinate.
+             */
+            long CellIndex(const AIReal coordinate) const { return long(std::floor(coordinate / cell_size_)); }
+
+           private:
+            //! Edge length of the grid cells.
+            AIReal cell_size_;
+
+            //! Objects in each non empty grid cell.
+            std::map<std::pair<long, long>, std::vector<T>> cells_;
+
+            //! Bounds of all objects in the index.
+            std::map<T, AIRealRect> bounds_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
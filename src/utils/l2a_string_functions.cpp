@@ -176,9 +176,17 @@ std::vector<ai::UnicodeString> L2A::UTIL::SplitString(
  */
 ai::UnicodeString L2A::UTIL::StringHash(const ai::UnicodeString& string)
 {
-    auto string_std = StringAiToStd(string);
-    std::uint64_t crc = CRC::Calculate(string_std.c_str(), string_std.size(), CRC::CRC_64());
+    const auto string_std = StringAiToStd(string);
+    return StringStdToAi(StringHash(string_std.c_str(), string_std.size()));
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::StringHash(const char* data, const size_t size)
+{
+    std::uint64_t crc = CRC::Calculate(data, size, CRC::CRC_64());
     std::stringstream buffer;
     buffer << std::hex << crc;
-    return StringStdToAi(buffer.str());
+    return buffer.str();
 }
@@ -102,6 +102,11 @@ namespace L2A
          * \brief Calculate a hash from a string.
          */
         ai::UnicodeString StringHash(const ai::UnicodeString& string);
+
+        /**
+         * \brief Calculate a hash from UTF-8 data, the result is the same as for the corresponding ai::UnicodeString.
+         */
+        std::string StringHash(const char* data, const size_t size);
     }  // namespace UTIL
 }  // namespace L2A
 
@@ -0,0 +1,302 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Lightweight scoped trace spans that can be exported in the Chrome trace-event format.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_trace.h"
+
+#include "l2a_file_system.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+
+namespace
+{
+    /**
+     * \brief A single recorded span.
+     */
+    struct TraceEvent
+    {
+        const char* name_;
+        long long start_us_;
+        long long duration_us_;
+    };
+
+    /**
+     * \brief Ring buffer with the spans of a single thread that are not yet written to the trace file.
+     *
+     * Only the owning thread adds events and only the thread that writes the trace file removes them (with the file
+     * mutex locked). The number of added and removed events is published with release semantics, so the buffer is
+     * accessed from both threads without locks.
+     */
+    class ThreadBuffer
+    {
+       public:
+        //! Maximum number of events per thread that are not written to the file, additional events are dropped.
+        static constexpr size_t capacity_ = 1 << 16;
+
+        explicit ThreadBuffer(const unsigned int thread_id)
+            : thread_id_(thread_id),
+              depth_(0),
+              events_(new TraceEvent[capacity_]),
+              n_pushed_(0),
+              n_written_(0),
+              dropped_(0)
+        {
+        }
+
+        bool Push(const TraceEvent& event)
+        {
+            const size_t n_pushed = n_pushed_.load(std::memory_order_relaxed);
+            if (n_pushed - n_written_.load(std::memory_order_acquire) < capacity_)
+            {
+                events_[n_pushed % capacity_] = event;
+                n_pushed_.store(n_pushed + 1, std::memory_order_release);
+                return true;
+            }
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        //! Id of the thread in the trace file.
+        const unsigned int thread_id_;
+
+        //! Current nesting depth of spans, only accessed by the owning thread.
+        unsigned int depth_;
+
+        //! Recorded events.
+        std::unique_ptr<TraceEvent[]> events_;
+
+        //! Number of events added by the owning thread.
+        std::atomic<size_t> n_pushed_;
+
+        //! Number of events written to the trace file.
+        std::atomic<size_t> n_written_;
+
+        //! Number of events that were dropped since the file was last written.
+        std::atomic<size_t> dropped_;
+    };
+
+    //! Number of recorded events after which the file is written at the end of the next operation on the plugin thread.
+    constexpr size_t flush_threshold_ = 4096;
+
+    //! Number of recorded events that are not written to the trace file.
+    std::atomic<size_t> n_unwritten_events_(0);
+
+    //! Thread that writes the trace file, this is the plugin thread that enabled tracing.
+    std::atomic<std::thread::id> write_thread_;
+
+    /**
+     * \brief Registry of all thread buffers. The mutex is only locked when a thread records its first span and when
+     * the trace file is written.
+     */
+    std::mutex& RegistryMutex()
+    {
+        static std::mutex registry_mutex;
+        return registry_mutex;
+    }
+    std::vector<std::shared_ptr<ThreadBuffer>>& Registry()
+    {
+        static std::vector<std::shared_ptr<ThreadBuffer>> registry;
+        return registry;
+    }
+
+    /**
+     * \brief State of the trace file, only accessed with the mutex locked. The path is set on the plugin thread when
+     * tracing is enabled, so writing the file does not require the Illustrator SDK.
+     */
+    struct TraceFile
+    {
+        std::mutex mutex_;
+        std::filesystem::path path_;
+        size_t n_events_ = 0;
+        bool is_started_ = false;
+    };
+    TraceFile& GetTraceFile()
+    {
+        static TraceFile trace_file;
+        return trace_file;
+    }
+
+    /**
+     * \brief Get the buffer of the current thread, it is created and registered on first use.
+     */
+    ThreadBuffer& GetThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> thread_buffer = []()
+        {
+            static unsigned int n_threads = 0;
+            std::lock_guard<std::mutex> lock(RegistryMutex());
+            auto buffer = std::make_shared<ThreadBuffer>(++n_threads);
+            Registry().push_back(buffer);
+            return buffer;
+        }();
+        return *thread_buffer;
+    }
+
+    /**
+     * \brief Time since the first call to this function in microseconds.
+     */
+    long long NowMicroseconds()
+    {
+        static const auto trace_epoch = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - trace_epoch)
+            .count();
+    }
+}  // namespace
+
+
+/**
+ * Tracing is disabled by default, the value from the options is set when they are loaded.
+ */
+std::atomic<bool> L2A::UTIL::TRACE::INTERNAL::trace_enabled_(false);
+
+
+/**
+ *
+ */
+long long L2A::UTIL::TRACE::INTERNAL::BeginSpan()
+{
+    GetThreadBuffer().depth_++;
+    return NowMicroseconds();
+}
+
+/**
+ *
+ */
+void L2A::UTIL::TRACE::INTERNAL::EndSpan(const char* name, const long long start_us)
+{
+    const long long end_us = NowMicroseconds();
+    auto& thread_buffer = GetThreadBuffer();
+    if (thread_buffer.Push({name, start_us, end_us - start_us}))
+        n_unwritten_events_.fetch_add(1, std::memory_order_relaxed);
+
+    // Other threads only record their spans. The plugin thread writes the recorded spans of all threads once enough
+    // of them are collected and an operation is finished, so the file is not written after each small operation.
+    if (thread_buffer.depth_ > 0) thread_buffer.depth_--;
+    if (thread_buffer.depth_ == 0 && n_unwritten_events_.load(std::memory_order_relaxed) >= flush_threshold_ &&
+        write_thread_.load(std::memory_order_relaxed) == std::this_thread::get_id())
+    {
+        try
+        {
+            FlushTraceFile();
+        }
+        catch (...)
+        {
+            // Tracing must never interfere with the actual operation.
+        }
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::TRACE::SetTraceEnabled(const bool enabled)
+{
+    if (enabled)
+    {
+        auto& trace_file = GetTraceFile();
+        std::lock_guard<std::mutex> lock(trace_file.mutex_);
+        if (trace_file.path_.empty()) trace_file.path_ = L2A::UTIL::FilePathAiToStd(GetTraceFilePath());
+        write_thread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    }
+    INTERNAL::trace_enabled_.store(enabled, std::memory_order_relaxed);
+
+    // The remaining spans are written when tracing is disabled.
+    if (!enabled) FlushTraceFile();
+}
+
+/**
+ *
+ */
+ai::FilePath L2A::UTIL::TRACE::GetTraceFilePath()
+{
+    ai::FilePath trace_file = L2A::UTIL::GetApplicationDataDirectory();
+    trace_file.AddComponent(ai::UnicodeString("LaTeX2AI_trace.json"));
+    return trace_file;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::TRACE::FlushTraceFile()
+{
+    // Get a snapshot of the registered buffers. Buffers of threads that finished are removed from the registry, they
+    // are written a last time below.
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        buffers = Registry();
+        auto& registry = Registry();
+        registry.erase(std::remove_if(registry.begin(), registry.end(),
+                           [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer.use_count() == 2; }),
+            registry.end());
+    }
+
+    // Only one thread at a time writes the file and removes events from the buffers.
+    auto& trace_file = GetTraceFile();
+    std::lock_guard<std::mutex> lock(trace_file.mutex_);
+    if (trace_file.path_.empty()) return;
+
+    // The file is started once per session, afterwards the new events are appended. The closing bracket of the JSON
+    // array format is optional, so the file can be opened at any time.
+    std::ofstream trace_stream(trace_file.path_, trace_file.is_started_ ? std::ios::app : std::ios::trunc);
+    if (!trace_file.is_started_) trace_stream << "[";
+    trace_file.is_started_ = true;
+    const auto begin_event = [&]() -> std::ofstream&
+    {
+        trace_stream << (trace_file.n_events_++ == 0 ? "\n" : ",\n");
+        return trace_stream;
+    };
+    for (const auto& buffer : buffers)
+    {
+        const size_t n_pushed = buffer->n_pushed_.load(std::memory_order_acquire);
+        const size_t n_written = buffer->n_written_.load(std::memory_order_relaxed);
+        for (size_t i = n_written; i < n_pushed; i++)
+        {
+            const auto& event = buffer->events_[i % ThreadBuffer::capacity_];
+            begin_event() << "{\"name\":\"" << event.name_
+                          << "\",\"cat\":\"LaTeX2AI\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id_
+                          << ",\"ts\":" << event.start_us_ << ",\"dur\":" << event.duration_us_ << "}";
+        }
+        buffer->n_written_.store(n_pushed, std::memory_order_release);
+        n_unwritten_events_.fetch_sub(n_pushed - n_written, std::memory_order_relaxed);
+
+        const size_t dropped = buffer->dropped_.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+            begin_event() << "{\"name\":\"dropped_events\",\"ph\":\"C\",\"pid\":1,\"tid\":" << buffer->thread_id_
+                          << ",\"ts\":" << NowMicroseconds() << ",\"args\":{\"count\":" << dropped << "}}";
+    }
+}
@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Lightweight scoped trace spans that can be exported in the Chrome trace-event format.
+ */
+
+#ifndef UTIL_TRACE_H_
+#define UTIL_TRACE_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <atomic>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        namespace TRACE
+        {
+            namespace INTERNAL
+            {
+                //! Flag if tracing is enabled. This is the only thing that is checked if tracing is disabled.
+                extern std::atomic<bool> trace_enabled_;
+
+                /**
+                 * \brief Start a span on the current thread and return the start time in microseconds.
+                 */
+                long long BeginSpan();
+
+                /**
+                 * \brief Finish a span on the current thread and store it in the per-thread buffer. If this was the
+                 * outermost span on the plugin thread and enough spans are recorded, they are written to the trace
+                 * file.
+                 */
+                void EndSpan(const char* name, const long long start_us);
+            }  // namespace INTERNAL
+
+            /**
+             * \brief Enable or disable the recording of trace spans. This has to be called on the plugin thread, the
+             * trace file is written on this thread. When tracing is disabled, the remaining spans are written.
+             */
+            void SetTraceEnabled(const bool enabled);
+
+            /**
+             * \brief Check if trace spans are recorded.
+             */
+            inline bool IsTraceEnabled() { return INTERNAL::trace_enabled_.load(std::memory_order_relaxed); }
+
+            /**
+             * \brief Path of the file that the trace is written to.
+             */
+            ai::FilePath GetTraceFilePath();
+
+            /**
+             * \brief Append the spans recorded since the last call to the trace file and remove them from the
+             * buffers. The file is in the Chrome trace-event JSON array format (can be opened in chrome://tracing or
+             * https://ui.perfetto.dev) and is started anew in each session.
+             */
+            void FlushTraceFile();
+
+            /**
+             * \brief Span that records the time between its construction and destruction.
+             *
+             * If tracing is disabled, the constructor only performs a single check of the enabled flag. The span name
+             * has to be a string literal, since only the pointer is stored.
+             */
+            class ScopedSpan
+            {
+               public:
+                /**
+                 * \brief Constructor, start the span if tracing is enabled.
+                 */
+                explicit ScopedSpan(const char* name) : name_(nullptr), start_us_(0)
+                {
+                    if (INTERNAL::trace_enabled_.load(std::memory_order_relaxed))
+                    {
+                        name_ = name;
+                        start_us_ = INTERNAL::BeginSpan();
+                    }
+                }
+
+                /**
+                 * \brief Destructor, finish the span if it was started.
+                 */
+                ~ScopedSpan()
+                {
+                    if (name_ != nullptr) INTERNAL::EndSpan(name_, start_us_);
+                }
+
+                ScopedSpan(const ScopedSpan&) = delete;
+                ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+               private:
+                //! Name of the span, this is a nullptr if the span is not active.
+                const char* name_;
+
+                //! Start time of the span in microseconds.
+                long long start_us_;
+            };
+        }  // namespace TRACE
+    }  // namespace UTIL
+}  // namespace L2A
+
+
+/**
+ * \brief Helper macros to create a unique variable name for each trace span.
+ */
+#define L2A_TRACE_CONCAT_INNER(a, b) a##b
+#define L2A_TRACE_CONCAT(a, b) L2A_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * \brief This macro records a trace span for the remainder of the current scope.
+ */
+#define l2a_trace_scope(name) \
+    const L2A::UTIL::TRACE::ScopedSpan L2A_TRACE_CONCAT(l2a_trace_span_, __LINE__)(name)
+
+#endif
@@ -0,0 +1,365 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Pull parser for XML strings.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_xml_reader.h"
+
+#include "l2a_error.h"
+#include "l2a_string_functions.h"
+
+#include <cstring>
+
+
+namespace
+{
+    /**
+     * \brief Check if a character is white space in the XML sense, this is the same check as in tinyxml2.
+     */
+    bool IsWhiteSpace(const char character)
+    {
+        return character == ' ' || character == '\n' || character == '\r' || character == '\t' || character == '\v' ||
+               character == '\f';
+    }
+
+    /**
+     * \brief Check if a character ends an element or attribute name.
+     */
+    bool IsNameEnd(const char character)
+    {
+        return IsWhiteSpace(character) || character == '/' || character == '>' || character == '=';
+    }
+
+    /**
+     * \brief Append a unicode code point encoded as UTF-8.
+     */
+    void AppendUTF8(std::string& output, const unsigned long code_point)
+    {
+        if (code_point < 0x80)
+            output.push_back((char)code_point);
+        else if (code_point < 0x800)
+        {
+            output.push_back((char)(0xC0 | (code_point >> 6)));
+            output.push_back((char)(0x80 | (code_point & 0x3F)));
+        }
+        else if (code_point < 0x10000)
+        {
+            output.push_back((char)(0xE0 | (code_point >> 12)));
+            output.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+            output.push_back((char)(0x80 | (code_point & 0x3F)));
+        }
+        else
+        {
+            output.push_back((char)(0xF0 | (code_point >> 18)));
+            output.push_back((char)(0x80 | ((code_point >> 12) & 0x3F)));
+            output.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+            output.push_back((char)(0x80 | (code_point & 0x3F)));
+        }
+    }
+
+    /**
+     * \brief Decode a character reference ("&#...;") at the beginning of the text. Returns the length of the
+     * reference, or 0 if it is not valid.
+     */
+    size_t DecodeCharacterReference(const std::string_view text, std::string& output)
+    {
+        const bool is_hex = text.size() > 2 && text[2] == 'x';
+        const size_t begin = is_hex ? 3 : 2;
+        const size_t end = text.find(';', begin);
+        if (end == std::string_view::npos || end == begin || end - begin > 8) return 0;
+
+        unsigned long code_point = 0;
+        for (size_t i = begin; i < end; i++)
+        {
+            const char digit = text[i];
+            unsigned long value;
+            if (digit >= '0' && digit <= '9')
+                value = digit - '0';
+            else if (is_hex && digit >= 'a' && digit <= 'f')
+                value = digit - 'a' + 10;
+            else if (is_hex && digit >= 'A' && digit <= 'F')
+                value = digit - 'A' + 10;
+            else
+                return 0;
+            code_point = code_point * (is_hex ? 16 : 10) + value;
+        }
+        if (code_point == 0 || code_point > 0x10FFFF) return 0;
+
+        AppendUTF8(output, code_point);
+        return end + 1;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+L2A::UTIL::XMLReader::XMLReader(const std::string_view xml_string)
+    : xml_string_(xml_string),
+      position_(0),
+      in_start_tag_(false),
+      root_closed_(false),
+      process_entities_(true),
+      is_decoded_(false)
+{
+    // Skip the byte order mark.
+    if (xml_string_.substr(0, 3) == "\xEF\xBB\xBF") position_ = 3;
+}
+
+/**
+ *
+ */
+L2A::UTIL::XMLReader::Event L2A::UTIL::XMLReader::Next()
+{
+    name_ = std::string_view();
+    raw_value_ = std::string_view();
+    process_entities_ = true;
+    is_decoded_ = false;
+
+    if (in_start_tag_) return NextInStartTag();
+
+    const size_t size = xml_string_.size();
+    while (position_ < size)
+    {
+        if (xml_string_[position_] != '<')
+        {
+            // Text, white space between elements is not reported.
+            const char* next_tag = (const char*)std::memchr(xml_string_.data() + position_, '<', size - position_);
+            const size_t text_end = next_tag == nullptr ? size : next_tag - xml_string_.data();
+            const std::string_view text = xml_string_.substr(position_, text_end - position_);
+            position_ = text_end;
+            bool is_white_space = true;
+            for (const char character : text)
+            {
+                if (!IsWhiteSpace(character))
+                {
+                    is_white_space = false;
+                    break;
+                }
+            }
+            if (is_white_space) continue;
+            if (element_stack_.empty()) ThrowError("Text outside of the root element.");
+            raw_value_ = text;
+            return Event::text;
+        }
+
+        const std::string_view tag = xml_string_.substr(position_);
+        if (tag.substr(0, 4) == "<!--")
+        {
+            const size_t end = xml_string_.find("-->", position_ + 4);
+            if (end == std::string_view::npos) ThrowError("Comment is not closed.");
+            position_ = end + 3;
+        }
+        else if (tag.substr(0, 9) == "<![CDATA[")
+        {
+            const size_t end = xml_string_.find("]]>", position_ + 9);
+            if (end == std::string_view::npos) ThrowError("CDATA section is not closed.");
+            if (element_stack_.empty()) ThrowError("Text outside of the root element.");
+            raw_value_ = xml_string_.substr(position_ + 9, end - position_ - 9);
+            process_entities_ = false;
+            position_ = end + 3;
+            return Event::text;
+        }
+        else if (tag.substr(0, 2) == "<?")
+        {
+            const size_t end = xml_string_.find("?>", position_ + 2);
+            if (end == std::string_view::npos) ThrowError("Processing instruction is not closed.");
+            position_ = end + 2;
+        }
+        else if (tag.substr(0, 2) == "<!")
+        {
+            const size_t end = xml_string_.find('>', position_ + 2);
+            if (end == std::string_view::npos) ThrowError("Declaration is not closed.");
+            position_ = end + 1;
+        }
+        else if (tag.substr(0, 2) == "</")
+        {
+            const size_t end = xml_string_.find('>', position_ + 2);
+            if (end == std::string_view::npos) ThrowError("End tag is not closed.");
+            std::string_view name = xml_string_.substr(position_ + 2, end - position_ - 2);
+            while (!name.empty() && IsWhiteSpace(name.back())) name.remove_suffix(1);
+            if (element_stack_.empty() || element_stack_.back() != name)
+                ThrowError("End tag does not match the start tag.");
+            position_ = end + 1;
+            element_stack_.pop_back();
+            if (element_stack_.empty()) root_closed_ = true;
+            name_ = name;
+            return Event::end_element;
+        }
+        else
+        {
+            if (root_closed_) ThrowError("Multiple root elements.");
+            size_t name_end = position_ + 1;
+            while (name_end < size && !IsNameEnd(xml_string_[name_end])) name_end++;
+            if (name_end == position_ + 1) ThrowError("Element without name.");
+            name_ = xml_string_.substr(position_ + 1, name_end - position_ - 1);
+            element_stack_.push_back(name_);
+            position_ = name_end;
+            in_start_tag_ = true;
+            return Event::start_element;
+        }
+    }
+
+    if (!element_stack_.empty()) ThrowError("Element is not closed.");
+    if (!root_closed_) ThrowError("No root element.");
+    return Event::end_document;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLReader::SkipElement()
+{
+    const size_t depth = element_stack_.size();
+    if (depth == 0) l2a_error("There is no element to skip.");
+    while (element_stack_.size() >= depth) Next();
+    name_ = std::string_view();
+}
+
+/**
+ *
+ */
+std::string_view L2A::UTIL::XMLReader::GetValue() const
+{
+    if (IsValueBorrowed()) return raw_value_;
+    if (is_decoded_) return decoded_value_;
+
+    // Replace the entities and normalize the line endings.
+    decoded_value_.clear();
+    decoded_value_.reserve(raw_value_.size());
+    for (size_t i = 0; i < raw_value_.size();)
+    {
+        const char character = raw_value_[i];
+        if (character == '\r' || character == '\n')
+        {
+            const char other = character == '\r' ? '\n' : '\r';
+            i += (i + 1 < raw_value_.size() && raw_value_[i + 1] == other) ? 2 : 1;
+            decoded_value_.push_back('\n');
+        }
+        else if (character == '&' && process_entities_)
+        {
+            const std::string_view entity = raw_value_.substr(i);
+            size_t length = 0;
+            if (entity.substr(0, 2) == "&#")
+                length = DecodeCharacterReference(entity, decoded_value_);
+            else
+            {
+                static const std::pair<std::string_view, char> entities[] = {
+                    {"&quot;", '"'}, {"&amp;", '&'}, {"&apos;", '\''}, {"&lt;", '<'}, {"&gt;", '>'}};
+                for (const auto& [pattern, value] : entities)
+                {
+                    if (entity.substr(0, pattern.size()) == pattern)
+                    {
+                        decoded_value_.push_back(value);
+                        length = pattern.size();
+                        break;
+                    }
+                }
+            }
+            if (length == 0)
+            {
+                // Unknown entities are kept.
+                decoded_value_.push_back(character);
+                length = 1;
+            }
+            i += length;
+        }
+        else
+        {
+            decoded_value_.push_back(character);
+            i++;
+        }
+    }
+    is_decoded_ = true;
+    return decoded_value_;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::XMLReader::IsValueBorrowed() const
+{
+    for (const char character : raw_value_)
+        if (character == '\r' || (character == '&' && process_entities_)) return false;
+    return true;
+}
+
+/**
+ *
+ */
+L2A::UTIL::XMLReader::Event L2A::UTIL::XMLReader::NextInStartTag()
+{
+    const size_t size = xml_string_.size();
+    while (position_ < size && IsWhiteSpace(xml_string_[position_])) position_++;
+    if (position_ >= size) ThrowError("Start tag is not closed.");
+
+    if (xml_string_[position_] == '>')
+    {
+        position_++;
+        in_start_tag_ = false;
+        return Next();
+    }
+    if (xml_string_.substr(position_, 2) == "/>")
+    {
+        // Empty element.
+        position_ += 2;
+        in_start_tag_ = false;
+        name_ = element_stack_.back();
+        element_stack_.pop_back();
+        if (element_stack_.empty()) root_closed_ = true;
+        return Event::end_element;
+    }
+
+    // Attribute.
+    const size_t name_begin = position_;
+    while (position_ < size && !IsNameEnd(xml_string_[position_])) position_++;
+    if (position_ == name_begin) ThrowError("Attribute without name.");
+    name_ = xml_string_.substr(name_begin, position_ - name_begin);
+    while (position_ < size && IsWhiteSpace(xml_string_[position_])) position_++;
+    if (position_ >= size || xml_string_[position_] != '=') ThrowError("Attribute without value.");
+    position_++;
+    while (position_ < size && IsWhiteSpace(xml_string_[position_])) position_++;
+    if (position_ >= size || (xml_string_[position_] != '"' && xml_string_[position_] != '\''))
+        ThrowError("Attribute value is not quoted.");
+    const size_t value_end = xml_string_.find(xml_string_[position_], position_ + 1);
+    if (value_end == std::string_view::npos) ThrowError("Attribute value is not closed.");
+    raw_value_ = xml_string_.substr(position_ + 1, value_end - position_ - 1);
+    position_ = value_end + 1;
+    return Event::attribute;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLReader::ThrowError(const char* message) const
+{
+    l2a_error("XML could not be parsed at position " + L2A::UTIL::IntegerToString((unsigned int)position_) + ": " +
+              ai::UnicodeString(message));
+}
@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Pull parser for XML strings.
+ */
+
+#ifndef UTIL_XML_READER_H_
+#define UTIL_XML_READER_H_
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Read a UTF-8 XML string event by event.
+         *
+         * The names and values are views into the XML string, no tree is created. Values that contain entities or
+         * carriage returns are decoded the same way as tinyxml2 does it, only for those a copy is created when the
+         * value is requested. Large elements, e.g., the encoded pdf file in a LaTeX2AI item, can therefore be handed
+         * off as a span of the XML string, or skipped without looking at their contents. The XML string has to
+         * outlive the reader.
+         *
+         * Processing instructions, comments and the document type declaration are skipped, CDATA sections are
+         * reported as text. As in tinyxml2, text that only consists of white space is not reported.
+         */
+        class XMLReader
+        {
+           public:
+            /**
+             * \brief Events reported by the reader.
+             */
+            enum class Event
+            {
+                start_element,
+                attribute,
+                text,
+                end_element,
+                end_document
+            };
+
+            /**
+             * \brief Constructor.
+             */
+            explicit XMLReader(const std::string_view xml_string);
+
+            /**
+             * \brief Advance to the next event. The attributes of an element directly follow its start_element event.
+             */
+            Event Next();
+
+            /**
+             * \brief Skip the remaining contents of the current element, i.e., the one of the last start_element or
+             * attribute event. The next event is the one after the end of the element. The contents are not decoded.
+             */
+            void SkipElement();
+
+            /**
+             * \brief Name of the current element or attribute.
+             */
+            std::string_view GetName() const { return name_; }
+
+            /**
+             * \brief Value of the current attribute or text. The view is valid until the next event.
+             */
+            std::string_view GetValue() const;
+
+            /**
+             * \brief Check if the value is a view into the XML string, i.e., it does not have to be decoded.
+             */
+            bool IsValueBorrowed() const;
+
+            /**
+             * \brief Number of currently open elements.
+             */
+            size_t GetDepth() const { return element_stack_.size(); }
+
+           private:
+            /**
+             * \brief Parse the attribute or the end of the start tag at the current position.
+             */
+            Event NextInStartTag();
+
+            /**
+             * \brief Throw an error with the current position.
+             */
+            [[noreturn]] void ThrowError(const char* message) const;
+
+            //! XML string.
+            std::string_view xml_string_;
+
+            //! Current position in the XML string.
+            size_t position_;
+
+            //! Names of the currently open elements.
+            std::vector<std::string_view> element_stack_;
+
+            //! Flag if the reader is inside a start tag, i.e., attributes can follow.
+            bool in_start_tag_;
+
+            //! Flag if the root element was closed.
+            bool root_closed_;
+
+            //! Name and raw value of the current event.
+            std::string_view name_;
+            std::string_view raw_value_;
+
+            //! Flag if the raw value can contain entities, this is not the case for CDATA.
+            bool process_entities_;
+
+            //! Buffer for the decoded value and flag if the current value was already decoded.
+            mutable std::string decoded_value_;
+            mutable bool is_decoded_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
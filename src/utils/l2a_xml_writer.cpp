@@ -0,0 +1,212 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Streaming XML writer.
+ *
+ * The format follows tinyxml2::XMLPrinter: Each element is on a new line indented with four spaces per level, elements
+ * without children are closed with "/>" and elements with text are written on a single line. Most strings do not
+ * contain any character that has to be escaped, therefore the escaping scans 16 bytes at once with SSE2 on x86
+ * processors and copies unescaped blocks in one go.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_xml_writer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define L2A_XML_WRITER_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+    /**
+     * \brief Return the entity for a character, or nullptr if the character does not have to be escaped.
+     */
+    const char* XMLEntity(const char character, const bool is_attribute)
+    {
+        switch (character)
+        {
+            case '&':
+                return "&amp;";
+            case '<':
+                return "&lt;";
+            case '>':
+                return "&gt;";
+            case '"':
+                return is_attribute ? "&quot;" : nullptr;
+            case '\'':
+                return is_attribute ? "&apos;" : nullptr;
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * \brief Return the position of the first character that has to be escaped, starting at the given position. If
+     * no such character exists, the size of the text is returned.
+     */
+    size_t FindXMLEntity(const std::string_view text, size_t position, const bool is_attribute)
+    {
+        const char* data = text.data();
+        const size_t size = text.size();
+
+#ifdef L2A_XML_WRITER_SSE2
+        const __m128i amp = _mm_set1_epi8('&');
+        const __m128i lt = _mm_set1_epi8('<');
+        const __m128i gt = _mm_set1_epi8('>');
+        const __m128i quot = _mm_set1_epi8(is_attribute ? '"' : '&');
+        const __m128i apos = _mm_set1_epi8(is_attribute ? '\'' : '&');
+        for (; position + 16 <= size; position += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+            __m128i match = _mm_or_si128(_mm_cmpeq_epi8(block, amp), _mm_cmpeq_epi8(block, lt));
+            match = _mm_or_si128(match, _mm_cmpeq_epi8(block, gt));
+            match = _mm_or_si128(match, _mm_cmpeq_epi8(block, quot));
+            match = _mm_or_si128(match, _mm_cmpeq_epi8(block, apos));
+            if (_mm_movemask_epi8(match) != 0) break;
+        }
+#endif
+
+        for (; position < size; position++)
+            if (XMLEntity(data[position], is_attribute) != nullptr) return position;
+        return size;
+    }
+}  // namespace
+
+
+/**
+ *
+ */
+L2A::UTIL::XMLWriter::XMLWriter(std::string& output)
+    : output_(output), depth_(0), text_depth_(-1), element_just_opened_(false), first_element_(true)
+{
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLWriter::OpenElement(const std::string_view name)
+{
+    SealElementIfJustOpened();
+    element_stack_.emplace_back(name);
+
+    if (text_depth_ < 0 && !first_element_)
+    {
+        output_.push_back('\n');
+        AppendIndentation(depth_);
+    }
+    output_.push_back('<');
+    output_.append(name);
+
+    element_just_opened_ = true;
+    first_element_ = false;
+    depth_++;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLWriter::PushAttribute(const std::string_view name, const std::string_view value)
+{
+    output_.push_back(' ');
+    output_.append(name);
+    output_.append("=\"");
+    AppendXMLEscaped(output_, value, true);
+    output_.push_back('"');
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLWriter::PushText(const std::string_view text)
+{
+    text_depth_ = depth_ - 1;
+    SealElementIfJustOpened();
+    AppendXMLEscaped(output_, text, false);
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLWriter::CloseElement()
+{
+    depth_--;
+    if (element_just_opened_)
+        output_.append("/>");
+    else
+    {
+        if (text_depth_ < 0)
+        {
+            output_.push_back('\n');
+            AppendIndentation(depth_);
+        }
+        output_.append("</");
+        output_.append(element_stack_.back());
+        output_.push_back('>');
+    }
+    element_stack_.pop_back();
+
+    if (text_depth_ == depth_) text_depth_ = -1;
+    if (depth_ == 0) output_.push_back('\n');
+    element_just_opened_ = false;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLWriter::SealElementIfJustOpened()
+{
+    if (!element_just_opened_) return;
+    element_just_opened_ = false;
+    output_.push_back('>');
+}
+
+/**
+ *
+ */
+void L2A::UTIL::XMLWriter::AppendIndentation(const int depth)
+{
+    if (depth > 0) output_.append(4 * depth, ' ');
+}
+
+/**
+ *
+ */
+void L2A::UTIL::AppendXMLEscaped(std::string& output, const std::string_view text, const bool is_attribute)
+{
+    size_t begin = 0;
+    while (true)
+    {
+        const size_t end = FindXMLEntity(text, begin, is_attribute);
+        output.append(text.data() + begin, end - begin);
+        if (end == text.size()) return;
+        output.append(XMLEntity(text[end], is_attribute));
+        begin = end + 1;
+    }
+}
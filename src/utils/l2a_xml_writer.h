@@ -0,0 +1,118 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+
+/**
+ * \brief Streaming XML writer.
+ */
+
+#ifndef UTIL_XML_WRITER_H_
+#define UTIL_XML_WRITER_H_
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Write XML elements directly into a UTF-8 string.
+         *
+         * The output is byte-compatible with tinyxml2::XMLPrinter (not compact mode) when it prints a document with
+         * the same elements, i.e., strings created with this writer and with the previous tinyxml2 based
+         * serialization are equal. Only std types are used, so the writer can also be used outside of the plugin
+         * thread.
+         */
+        class XMLWriter
+        {
+           public:
+            /**
+             * \brief Constructor. The XML is appended to the output string, the caller can reserve the expected size
+             * in advance.
+             */
+            explicit XMLWriter(std::string& output);
+
+            /**
+             * \brief Open a new element. Attributes have to be added before any child element or text.
+             */
+            void OpenElement(const std::string_view name);
+
+            /**
+             * \brief Add an attribute to the current element.
+             */
+            void PushAttribute(const std::string_view name, const std::string_view value);
+
+            /**
+             * \brief Add text to the current element.
+             */
+            void PushText(const std::string_view text);
+
+            /**
+             * \brief Close the current element.
+             */
+            void CloseElement();
+
+           private:
+            /**
+             * \brief Close the start tag of the current element if no child or text has been added yet.
+             */
+            void SealElementIfJustOpened();
+
+            /**
+             * \brief Append indentation for the given depth.
+             */
+            void AppendIndentation(const int depth);
+
+            //! Output string.
+            std::string& output_;
+
+            //! Names of the currently open elements.
+            std::vector<std::string> element_stack_;
+
+            //! Current depth in the element tree.
+            int depth_;
+
+            //! Depth of the element that contains text, or -1. Elements with text are printed on a single line.
+            int text_depth_;
+
+            //! Flag if the start tag of the current element is still open.
+            bool element_just_opened_;
+
+            //! Flag if no element has been written yet.
+            bool first_element_;
+        };
+
+        /**
+         * \brief Append the text to the output and escape the XML entities. In attribute values the characters
+         * &<>"' are escaped, in text only &<>.
+         */
+        void AppendXMLEscaped(std::string& output, const std::string_view text, const bool is_attribute);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -175,6 +175,18 @@ function form_content_to_xml() {
         "warning_ai_not_saved",
         bool_to_string($("#warning_save_illustrator").prop("checked"))
     )
+    xml_document.documentElement.setAttribute(
+        "trace_enabled",
+        bool_to_string($("#trace_enabled").prop("checked"))
+    )
+    xml_document.documentElement.setAttribute(
+        "compile_cache_size_mb",
+        Math.max(0, parseInt($("#compile_cache_size_mb").prop("value")) || 0)
+    )
+    xml_document.documentElement.setAttribute(
+        "optimize_pdf_files",
+        bool_to_string($("#optimize_pdf_files").prop("checked"))
+    )
 
     return xml_document
 }
@@ -226,6 +238,68 @@ function update_form(event) {
             "warning_ai_not_saved",
             "warning_save_illustrator"
         )
+
+        // Diagnostics
+        if_found_update_checkbox(
+            latex2ai_data,
+            "trace_enabled",
+            "trace_enabled"
+        )
+
+        // Compile cache
+        if_found_update_value(
+            latex2ai_data,
+            "compile_cache_size_mb",
+            "compile_cache_size_mb"
+        )
+        if_found_update_checkbox(
+            latex2ai_data,
+            "optimize_pdf_files",
+            "optimize_pdf_files"
+        )
+    }
+
+    // Set the compile cache statistics
+    var compile_cache_xml = form_data.find("compile_cache")
+    if (compile_cache_xml.length > 0) {
+        var hits = parseInt(compile_cache_xml.attr("hits"))
+        var misses = parseInt(compile_cache_xml.attr("misses"))
+        var hit_rate =
+            hits + misses > 0 ? Math.round((100 * hits) / (hits + misses)) : 0
+        $("#compile_cache_statistics").prop(
+            "innerHTML",
+            hits +
+                " hits, " +
+                misses +
+                " misses (" +
+                hit_rate +
+                "% hit rate), " +
+                compile_cache_xml.attr("n_entries") +
+                " cached items (" +
+                compile_cache_xml.attr("size_mb") +
+                " MB)"
+        )
+    }
+
+    // Set the pdf optimization statistics
+    var pdf_optimization_xml = form_data.find("pdf_optimization")
+    if (pdf_optimization_xml.length > 0) {
+        var n_files = parseInt(pdf_optimization_xml.attr("n_files"))
+        if (n_files > 0) {
+            var kb_saved_per_item =
+                parseInt(pdf_optimization_xml.attr("bytes_saved")) / n_files / 1024
+            var ms_per_item =
+                parseInt(pdf_optimization_xml.attr("milliseconds")) / n_files
+            $("#pdf_optimization_statistics").prop(
+                "innerHTML",
+                n_files +
+                    " optimized items in this session, " +
+                    kb_saved_per_item.toFixed(1) +
+                    " KB saved and " +
+                    ms_per_item.toFixed(0) +
+                    " ms per item"
+            )
+        }
     }
 
     // Set the header stuff
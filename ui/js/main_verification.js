@@ -0,0 +1,99 @@
+$(function () {
+    var csInterface = new CSInterface()
+
+    // Set the current skin colors
+    updateThemeWithAppSkinInfo(csInterface.hostEnvironment.appSkinInfo)
+
+    // Update the color of the panel when the theme color of the product changed
+    csInterface.addEventListener(
+        CSInterface.THEME_COLOR_CHANGED_EVENT,
+        onAppThemeColorChanged
+    )
+
+    // Add all the event listeners we need
+    csInterface.addEventListener(
+        "com.adobe.csxs.events.latex2ai.verification.update",
+        update_form
+    )
+    csInterface.addEventListener(
+        "com.adobe.csxs.events.latex2ai.verification.close",
+        csInterface.closeExtension
+    )
+
+    // Set the functions for the possible actions on the form
+    $("#button_redo").click(function (event) {
+        event.preventDefault()
+        var event = new CSEvent(
+            "com.adobe.csxs.events.latex2ai.verification.redo",
+            "APPLICATION",
+            "ILST",
+            "LaTeX2AIUI"
+        )
+        event.data = ""
+        csInterface.dispatchEvent(event)
+    })
+
+    $("#button_cancel").click(function (event) {
+        event.preventDefault()
+        var event = new CSEvent(
+            "com.adobe.csxs.events.latex2ai.verification.cancel",
+            "APPLICATION",
+            "ILST",
+            "LaTeX2AIUI"
+        )
+        event.data = ""
+        csInterface.dispatchEvent(event)
+    })
+
+    // let the native plug-in part of this sample know that we are ready to receive events now..
+    var panelReadyEvent = new CSEvent(
+        "com.adobe.csxs.events.latex2ai.verification.ready",
+        "APPLICATION",
+        "ILST",
+        "LaTeX2AIUI"
+    )
+    csInterface.dispatchEvent(panelReadyEvent)
+})
+
+function update_form(event) {
+    var xmlData = $.parseXML(event.data)
+    var $xml = $(xmlData)
+
+    check_git_hash($xml)
+
+    var verification_xml = $xml.find("form_data")
+    var n_repaired = parseInt(verification_xml.attr("n_repaired"))
+    var n_corrupt = parseInt(verification_xml.attr("n_corrupt"))
+    var n_unchecked = parseInt(verification_xml.attr("n_unchecked"))
+    var seconds = parseInt(verification_xml.attr("milliseconds")) / 1000.0
+
+    $("#summary_text").prop(
+        "innerHTML",
+        verification_xml.attr("n_items") +
+            " item(s) were verified in " +
+            seconds.toFixed(1) +
+            " s."
+    )
+    if (n_repaired > 0) {
+        $("#repaired_text").prop(
+            "innerHTML",
+            n_repaired +
+                " linked PDF file(s) were broken and have been restored from the data stored in the items."
+        )
+    }
+    if (n_corrupt > 0) {
+        $("#corrupt_text").prop(
+            "innerHTML",
+            n_corrupt +
+                " item(s) contain a broken PDF file. These items have to be redone."
+        )
+    }
+    if (n_unchecked > 0) {
+        $("#unchecked_text").prop(
+            "innerHTML",
+            n_unchecked +
+                " item(s) could not be checked within the time limit for the verification."
+        )
+    }
+    $("#button_redo").prop("disabled", n_corrupt == 0)
+}